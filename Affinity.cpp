@@ -0,0 +1,358 @@
+#pragma region Includes:
+
+	#include "Affinity.h"   // NumaTopology, AffinityPolicy
+	#include <algorithm>    // std::sort, std::unique, std::find, std::max
+	#include <cstdlib>      // strtol
+	#include <fstream>      // std::ifstream
+	#include <string>       // std::string, std::to_string
+	#include <string.h>     // strcmp
+	#include <thread>       // std::thread::hardware_concurrency
+	#include <omp.h>        // omp_get_thread_num
+	#ifdef __linux__
+		#include <sched.h>  // sched_getaffinity, sched_setaffinity, CPU_SET
+	#endif
+
+#pragma endregion
+
+
+#pragma region Defines:
+
+	#define NUMA_SYSFS_ONLINE   "/sys/devices/system/node/online" // list of the online nodes
+	#define NUMA_SYSFS_NODE     "/sys/devices/system/node/node"   // followed by the node number and "/cpulist"
+
+#pragma endregion
+
+
+#pragma region Helpers:
+
+	#ifdef __linux__
+		static cpu_set_t unpinned_mask;           // CPUs of the process before pinThreads first pinned it
+		static bool      b_unpinnedSaved = false; // whether unpinned_mask was taken
+	#endif
+
+
+	/// <summary>
+	///          Parses a kernel CPU or node list such as "0-3,8,10-11".
+	/// </summary>
+	static std::vector<int> parseCpuList(const std::string& s_list)
+	{
+		std::vector<int> i_v_cpus;
+		const char* c_next = s_list.c_str();
+
+		while (*c_next != 0 && *c_next != '\n')
+		{
+			char* c_end = nullptr;
+			const long i_first = strtol(c_next, &c_end, 10);
+			long i_last = i_first;
+
+			if (c_end == c_next)
+			{
+				break;
+			} // end if
+
+			if (*c_end == '-')
+			{
+				c_next = c_end + 1;
+				i_last = strtol(c_next, &c_end, 10);
+			} // end if
+
+			for (long i = i_first; i <= i_last; i++)
+			{
+				i_v_cpus.push_back(static_cast<int>(i));
+			} // end for i
+
+			c_next = (*c_end == ',' ? c_end + 1 : c_end);
+		} // end while
+
+		return i_v_cpus;
+	} // end method parseCpuList
+
+
+	/// <summary>
+	///          CPUs the calling thread may run on, ascending.
+	/// </summary>
+	static std::vector<int> allowedCpus(void)
+	{
+		std::vector<int> i_v_cpus;
+
+		#ifdef __linux__
+			cpu_set_t set;
+
+			CPU_ZERO(&set);
+
+			if (sched_getaffinity(0, sizeof(set), &set) == 0)
+			{
+				for (int i = 0; i < CPU_SETSIZE; i++)
+				{
+					if (CPU_ISSET(i, &set))
+					{
+						i_v_cpus.push_back(i);
+					} // end if
+				} // end for i
+			} // end if
+		#endif
+
+		if (i_v_cpus.empty())
+		{
+			for (unsigned int i = 0; i < std::max(1u, std::thread::hardware_concurrency()); i++)
+			{
+				i_v_cpus.push_back(static_cast<int>(i));
+			} // end for i
+		} // end if
+
+		return i_v_cpus;
+	} // end method allowedCpus
+
+
+#pragma endregion
+
+
+#pragma region Implementations:
+
+	/// <summary>
+	///          Reads the nodes and keeps the CPUs of each that the calling thread may run on.
+	/// </summary>
+	NumaTopology::NumaTopology(void)
+	{
+		const std::vector<int> i_v_allowed = allowedCpus();
+		std::vector<int> i_v_placed;
+
+		std::ifstream online_file(NUMA_SYSFS_ONLINE);
+		std::string s_online;
+
+		std::getline(online_file, s_online);
+
+		for (const int n : parseCpuList(s_online))
+		{
+			std::ifstream list_file(NUMA_SYSFS_NODE + std::to_string(n) + "/cpulist");
+			std::string s_list;
+
+			if (!list_file.is_open() || !std::getline(list_file, s_list))
+			{
+				continue;
+			} // end if
+
+			std::vector<int> i_v_node;
+
+			for (const int i_cpu : parseCpuList(s_list))
+			{
+				if (std::find(i_v_allowed.begin(), i_v_allowed.end(), i_cpu) != i_v_allowed.end())
+				{
+					i_v_node.push_back(i_cpu);
+					i_v_placed.push_back(i_cpu);
+				} // end if
+			} // end for
+
+			// memory-only nodes and nodes outside the mask have no CPU to run on
+			if (!i_v_node.empty())
+			{
+				i_v_nodes.push_back(i_v_node);
+			} // end if
+		} // end for
+
+		// no sysfs, or CPUs it does not list, make one node
+		if (i_v_nodes.empty() || i_v_placed.size() != i_v_allowed.size())
+		{
+			i_v_nodes.assign(1, i_v_allowed);
+		} // end if
+	} // end constructor
+
+
+	/// <summary>
+	///          CPU of each of <paramref name="ui_threads"/> threads under <paramref name="e_policy"/>. Threads beyond the
+	///          number of CPUs start over at the first; none gives an empty list.
+	/// </summary>
+	std::vector<int> NumaTopology::placement(const AffinityPolicy e_policy, const std::size_t ui_threads) const
+	{
+		std::vector<int> i_v_order, i_v_plan;
+
+		if (e_policy == AffinityPolicy::compact)
+		{
+			for (const std::vector<int>& node : i_v_nodes)
+			{
+				i_v_order.insert(i_v_order.end(), node.begin(), node.end());
+			} // end for
+		} // end if
+		else if (e_policy == AffinityPolicy::spread)
+		{
+			std::size_t ui_widest = 0;
+
+			for (const std::vector<int>& node : i_v_nodes)
+			{
+				ui_widest = std::max(ui_widest, node.size());
+			} // end for
+
+			// the r-th CPU of every node before the (r + 1)-th of any
+			for (std::size_t r = 0; r < ui_widest; r++)
+			{
+				for (const std::vector<int>& node : i_v_nodes)
+				{
+					if (r < node.size())
+					{
+						i_v_order.push_back(node[r]);
+					} // end if
+				} // end for
+			} // end for r
+		} // end elif
+
+		for (std::size_t t = 0; !i_v_order.empty() && t < ui_threads; t++)
+		{
+			i_v_plan.push_back(i_v_order[t % i_v_order.size()]);
+		} // end for t
+
+		return i_v_plan;
+	} // end method placement
+
+
+	/// <summary>
+	///          Node of <paramref name="i_cpu"/>, 0 if it is not one of the allowed CPUs.
+	/// </summary>
+	std::size_t NumaTopology::nodeOf(const int i_cpu) const noexcept
+	{
+		for (std::size_t n = 0; n < i_v_nodes.size(); n++)
+		{
+			if (std::find(i_v_nodes[n].begin(), i_v_nodes[n].end(), i_cpu) != i_v_nodes[n].end())
+			{
+				return n;
+			} // end if
+		} // end for n
+
+		return 0;
+	} // end method nodeOf
+
+
+	/// <summary>
+	///          Binds the calling thread to <paramref name="i_cpu"/>.
+	/// </summary>
+	/// <returns>
+	///          false if the system refused or does not support it
+	/// </returns>
+	bool pinThread(const int i_cpu) noexcept
+	{
+		#ifdef __linux__
+			cpu_set_t set;
+
+			CPU_ZERO(&set);
+			CPU_SET(i_cpu, &set);
+
+			return sched_setaffinity(0, sizeof(set), &set) == 0;
+		#else
+			(void)i_cpu;
+			return false;
+		#endif
+	} // end method pinThread
+
+
+	/// <summary>
+	///          Gives the calling thread back the CPUs the process had before <see cref="pinThreads"/>, so helper threads
+	///          started from a pinned thread do not share its CPU. Does nothing if no team was pinned.
+	/// </summary>
+	void unpinThread(void) noexcept
+	{
+		#ifdef __linux__
+			if (b_unpinnedSaved)
+			{
+				sched_setaffinity(0, sizeof(unpinned_mask), &unpinned_mask);
+			} // end if
+		#endif
+	} // end method unpinThread
+
+
+	/// <summary>
+	///          Binds every thread of a team of <paramref name="i_threads"/>, the calling thread being thread 0, to its CPU
+	///          under <paramref name="e_policy"/>. Call after omp_set_num_threads and before the populations are allocated,
+	///          so their pages land on the nodes of the threads that first touch them. If any thread cannot be pinned, the
+	///          whole team gets its CPUs back.
+	/// </summary>
+	/// <returns>
+	///          NUMA nodes the team spans, 0 if it was not pinned
+	/// </returns>
+	std::size_t pinThreads(const AffinityPolicy e_policy, const int i_threads)
+	{
+		const NumaTopology topology;
+		const std::vector<int> i_v_plan = topology.placement(e_policy, static_cast<std::size_t>(i_threads));
+		std::vector<std::size_t> ui_v_nodes;
+		int i_pinned = 0;
+
+		if (i_v_plan.empty())
+		{
+			return 0;
+		} // end if
+
+		#ifdef __linux__
+			if (!b_unpinnedSaved)
+			{
+				b_unpinnedSaved = (sched_getaffinity(0, sizeof(unpinned_mask), &unpinned_mask) == 0);
+			} // end if
+		#endif
+
+		#pragma omp parallel num_threads(i_threads) reduction(+:i_pinned)
+		{
+			i_pinned += pinThread(i_v_plan[static_cast<std::size_t>(omp_get_thread_num())]);
+		} // end parallel
+
+		// a partly pinned team would run unevenly, none of it stays pinned
+		if (i_pinned != i_threads)
+		{
+			#pragma omp parallel num_threads(i_threads)
+			{
+				unpinThread();
+			} // end parallel
+
+			return 0;
+		} // end if
+
+		for (const int i_cpu : i_v_plan)
+		{
+			ui_v_nodes.push_back(topology.nodeOf(i_cpu));
+		} // end for
+
+		std::sort(ui_v_nodes.begin(), ui_v_nodes.end());
+
+		return static_cast<std::size_t>(std::unique(ui_v_nodes.begin(), ui_v_nodes.end()) - ui_v_nodes.begin());
+	} // end method pinThreads
+
+
+	/// <summary>
+	///          Name of an affinity policy as given on the command line.
+	/// </summary>
+	const char* affinityPolicyName(const AffinityPolicy e_policy) noexcept
+	{
+		switch (e_policy)
+		{
+			case AffinityPolicy::compact: return "compact";
+			case AffinityPolicy::spread:  return "spread";
+			default:                      return "none";
+		} // end switch
+	} // end method affinityPolicyName
+
+
+	/// <summary>
+	///          Parses an affinity policy name.
+	/// </summary>
+	/// <param name="name">
+	///          One of none, compact or spread.
+	/// </param>
+	/// <param name="e_policy">
+	///          Output parameter for the parsed policy.
+	/// </param>
+	/// <returns>
+	///          true if <paramref name="name"/> is a known policy
+	/// </returns>
+	bool parseAffinityPolicy(const char* name, AffinityPolicy& e_policy) noexcept
+	{
+		const AffinityPolicy e_a_all[] = { AffinityPolicy::none, AffinityPolicy::compact, AffinityPolicy::spread };
+
+		for (const AffinityPolicy e_candidate : e_a_all)
+		{
+			if (strcmp(name, affinityPolicyName(e_candidate)) == 0)
+			{
+				e_policy = e_candidate;
+				return true;
+			} // end if
+		} // end for
+
+		return false;
+	} // end method parseAffinityPolicy
+
+#pragma endregion
@@ -0,0 +1,53 @@
+#ifndef _AFFINITY_H_
+#define _AFFINITY_H_
+
+#pragma region Includes:
+
+	#include <cstddef>      // std::size_t
+	#include <vector>       // std::vector
+
+#pragma endregion
+
+
+// Where the threads of the OpenMP team run.
+enum class AffinityPolicy
+{
+	none,    // wherever the operating system puts them
+	compact, // one CPU each, filling a NUMA node before the next
+	spread   // one CPU each, dealt round the NUMA nodes in turn
+}; // end enum AffinityPolicy
+
+
+// The CPUs this process may run on, grouped by NUMA node.
+//
+// Read from /sys/devices/system/node and the process's affinity mask when the threads are set up; without either,
+// all CPUs form one node. Pinning the team once is enough: the runtime keeps its threads for later parallel regions,
+// and the populations, whose pages are first touched by the thread that owns the slots in the operators' static
+// schedules, then stay on the node of the threads working on them.
+class NumaTopology
+{
+public:
+	NumaTopology(void);
+
+	std::vector<int> placement(const AffinityPolicy e_policy, const std::size_t ui_threads) const;
+	std::size_t nodeOf(const int i_cpu) const noexcept;
+
+	inline std::size_t             nodes(void) const noexcept                      { return i_v_nodes.size(); }
+	inline const std::vector<int>& cpus(const std::size_t ui_node) const noexcept  { return i_v_nodes[ui_node]; }
+
+private:
+	std::vector<std::vector<int>> i_v_nodes;  // allowed CPUs of every node that has any, ascending
+}; // end class NumaTopology
+
+
+#pragma region Prototypes:
+
+	bool pinThread(const int i_cpu) noexcept;
+	void unpinThread(void) noexcept;
+	std::size_t pinThreads(const AffinityPolicy e_policy, const int i_threads);
+	const char* affinityPolicyName(const AffinityPolicy e_policy) noexcept;
+	bool parseAffinityPolicy(const char* name, AffinityPolicy& e_policy) noexcept;
+
+#pragma endregion
+
+#endif
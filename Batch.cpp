@@ -0,0 +1,340 @@
+#pragma region Includes:
+
+	#include "Batch.h"          // runBatch, OptionParser
+	#include "DistanceMatrix.h" // DistanceMatrix
+	#include "Evolution.h"      // evolve, EvolutionBuffers
+	#include "Instance.h"       // loadInstance, loadPopulation, formatTour
+	#include "utility.hpp"      // highRes_Clock, ENABLE_STD_OUT
+	#include <omp.h>            // omp_set_num_threads
+	#include <algorithm>        // std::sort, std::max
+	#include <cstdlib>          // EXIT_SUCCESS, EXIT_FAILURE
+	#include <iostream>         // cout, cin
+	#include <memory>           // std::unique_ptr
+	#include <random>           // std::random_device
+	#include <sstream>          // std::istringstream, std::ostringstream
+	#include <stdexcept>        // std::invalid_argument, std::runtime_error
+	#include <string>           // std::string
+	#include <vector>           // std::vector
+	#include <dirent.h>         // opendir, readdir
+	#include <sys/stat.h>       // stat
+
+#pragma endregion
+
+
+#pragma region Helpers:
+
+	// One instance of a batch.
+	struct BatchJob
+	{
+		std::size_t ui_index; // position in the source, from 0
+		std::string s_name;   // cities file as the source names it
+		RunOptions  options;  // the batch's options with the job's own on top
+		std::string s_error;  // why the job cannot run, empty if it can
+	}; // end struct BatchJob
+
+
+	// Hands out the jobs of a batch in source order: the cities files of a directory sorted by name, or one job per
+	// line of standard input, read only when a worker asks for it so a stream of any length is never held in memory.
+	// Not thread-safe, workers take turns.
+	class JobQueue
+	{
+	public:
+		JobQueue(const RunOptions& defaults, const OptionParser parse, const std::uint64_t ui_seed);
+
+		bool next(BatchJob& job);
+
+	private:
+		void configure(BatchJob& job, std::istringstream& tokens) const;
+
+		const RunOptions&        defaults;     // options of the whole batch
+		OptionParser             parse;        // parses a job line's own options
+		std::uint64_t            ui_seed;      // master seed the job seeds derive from
+		std::vector<std::string> s_v_files;    // cities files of a directory source
+		std::size_t              ui_next;      // index of the next job
+	}; // end class JobQueue
+
+
+	/// <summary>
+	///          Lists the regular files of the directory <paramref name="s_source"/> unless it reads stdin.
+	/// </summary>
+	/// <exception cref="std::runtime_error">Thrown if the directory cannot be read.</exception>
+	JobQueue::JobQueue(const RunOptions& defaults, const OptionParser parse, const std::uint64_t ui_seed)
+		: defaults(defaults), parse(parse), ui_seed(ui_seed), ui_next(0)
+	{
+		const std::string& s_source = defaults.s_batchSource;
+
+		if (s_source == BATCH_STDIN)
+		{
+			return;
+		} // end if
+
+		DIR* p_dir = opendir(s_source.c_str());
+
+		if (p_dir == nullptr)
+		{
+			throw std::runtime_error("cannot open directory " + s_source);
+		} // end if
+
+		for (const dirent* p_entry = readdir(p_dir); p_entry != nullptr; p_entry = readdir(p_dir))
+		{
+			const std::string s_path = s_source + "/" + p_entry->d_name;
+			struct stat file_stat;
+
+			// hidden files and anything but regular files, such as . and .., are not jobs
+			if (p_entry->d_name[0] != '.' && stat(s_path.c_str(), &file_stat) == 0 && S_ISREG(file_stat.st_mode))
+			{
+				s_v_files.push_back(s_path);
+			} // end if
+		} // end for
+
+		closedir(p_dir);
+		std::sort(s_v_files.begin(), s_v_files.end());
+	} // end constructor
+
+
+	/// <summary>
+	///          Takes the next job off the source. Blank lines and lines starting with # are skipped.
+	/// </summary>
+	/// <param name="job">
+	///          Output parameter for the job; job.s_error tells why a malformed job line cannot run.
+	/// </param>
+	/// <returns>
+	///          false once the source is exhausted
+	/// </returns>
+	bool JobQueue::next(BatchJob& job)
+	{
+		std::string s_line;
+
+		if (defaults.s_batchSource != BATCH_STDIN)
+		{
+			if (ui_next >= s_v_files.size())
+			{
+				return false;
+			} // end if
+
+			s_line = s_v_files[ui_next];
+		} // end if
+		else
+		{
+			do
+			{
+				if (!std::getline(std::cin, s_line))
+				{
+					return false;
+				} // end if
+			} while (s_line.find_first_not_of(" \t\r") == std::string::npos || s_line[s_line.find_first_not_of(" \t\r")] == '#');
+		} // end else
+
+		std::istringstream tokens(s_line);
+
+		job.ui_index = ui_next++;
+		job.s_error.clear();
+		tokens >> job.s_name;
+		configure(job, tokens);
+
+		return true;
+	} // end method next
+
+
+	/// <summary>
+	///          Derives the options of <paramref name="job"/>: the batch's, the job's cities file and generated tours,
+	///          then whatever options follow the file name on its line. Jobs without a --seed of their own get the
+	///          master seed mixed with their index, so a batch repeats from its seed regardless of which worker runs what.
+	/// </summary>
+	void JobQueue::configure(BatchJob& job, std::istringstream& tokens) const
+	{
+		std::string s_token;
+
+		job.options = defaults;
+		job.options.s_citiesFile = job.s_name;
+		job.options.s_populationFile = RANDOM_POPULATION;
+		job.options.b_hasSeed = false;
+
+		while (tokens >> s_token)
+		{
+			if (s_token.compare(0, 2, "--") != 0 || !parse(s_token.c_str() + 2, job.options))
+			{
+				job.s_error = "bad option " + s_token;
+				return;
+			} // end if
+		} // end while
+
+		if (!job.options.b_hasSeed)
+		{
+			job.options.ui_seed = ui_seed ^ (static_cast<std::uint64_t>(job.ui_index) * 0x9E3779B97F4A7C15ull);
+			job.options.b_hasSeed = true;
+		} // end if
+
+		if (!sharesProcess(job.options) || job.options.s_batchSource != defaults.s_batchSource || job.options.s_serveEndpoint != defaults.s_serveEndpoint)
+		{
+			job.s_error = "islands, ranks, checkpoints, profiles, memoized distances and nested batches or daemons are not available to batch jobs";
+		} // end if
+	} // end method configure
+
+
+	/// <summary>
+	///          Solves <paramref name="job"/> on the calling thread alone, in the buffers its worker kept from the jobs before.
+	/// </summary>
+	/// <param name="trip">
+	///          The worker's population, reallocated only when the job's dimensions differ from the last job's.
+	/// </param>
+	/// <param name="buffers">
+	///          The worker's offspring pool and parent slots.
+	/// </param>
+	/// <returns>
+	///          The report line of the job.
+	/// </returns>
+	/// <exception cref="std::exception">Whatever loading or evolving the instance throws.</exception>
+	static std::string solve(const BatchJob& job, std::unique_ptr<Population>& trip, EvolutionBuffers& buffers)
+	{
+		const Instance instance = loadInstance(job.options);
+		const std::size_t ui_cities = instance.cities();
+
+		if (!trip || trip->size() != instance.ui_population || trip->cities() != ui_cities)
+		{
+			trip.reset(new Population(instance.ui_population, ui_cities));
+		} // end if
+
+		loadPopulation(job.options, instance, *trip, job.options.ui_seed);
+
+		// the fitness of a reused population belongs to the last job's tours
+		for (std::size_t i = 0; i < trip->size(); i++)
+		{
+			trip->invalidate(i);
+		} // end for i
+
+		const DistanceMatrix distances(instance.coordinates.data(), ui_cities);
+		const EvolutionResult result = evolve(job.options, instance, *trip, distances, job.options.ui_seed, GenerationObserver(), &buffers);
+		std::ostringstream report;
+
+		report << ui_cities << " cities, " << instance.ui_population << " tours, seed " << job.options.ui_seed << ": shortest distance = " << result.f_shortest
+			   << " at generation " << result.i_bestGeneration << ", stopped: " << stopReasonName(result.e_stopReason) << " after " << result.i_generations
+			   << " generations, " << result.i_elapsed << " us\t itinerary = " << formatTour(result.shortest.data(), ui_cities);
+
+		return report.str();
+	} // end method solve
+
+#pragma endregion
+
+
+#pragma region Implementations:
+
+	/// <summary>
+	///          Solves every instance of options.s_batchSource in one process. options.nThreads workers each take the next
+	///          job off the queue whenever they are free and solve it alone, with the loop-parallel run on a team of one,
+	///          so small instances that would not scale across threads run side by side instead. A worker keeps its
+	///          population, offspring pool and parent slots from job to job and only reallocates them when the dimensions
+	///          change; the OpenMP team and every thread's engine live as long as the batch. A job that fails is reported
+	///          and the batch goes on.
+	/// </summary>
+	/// <param name="options">
+	///          Options every job starts from, and the source of the jobs.
+	/// </param>
+	/// <param name="out_file">
+	///          File handle to output file.
+	/// </param>
+	/// <param name="parse">
+	///          Parses the options on a job line.
+	/// </param>
+	/// <returns>
+	///          0 if every job was solved
+	/// </returns>
+	/// <exception cref="std::invalid_argument">Thrown if the batch's options select a mode batch jobs cannot run in.</exception>
+	/// <exception cref="std::runtime_error">Thrown if the directory source cannot be read.</exception>
+	int runBatch(const RunOptions& options, std::ofstream& out_file, const OptionParser parse)
+	{
+		if (!sharesProcess(options))
+		{
+			throw std::invalid_argument("Batches run every job on one thread with the distance matrix, without islands, ranks, checkpoints or profiles!");
+		} // end if
+
+		RunOptions defaults = options;
+		std::random_device rd{};
+		const std::uint64_t ui_seed = (options.b_hasSeed ? options.ui_seed : (static_cast<std::uint64_t>(rd()) << 32) ^ rd());
+		const int nThreads = std::max(1, options.nThreads);
+
+		// jobs share the process, the profiler is not theirs to drive
+		defaults.b_profile = false;
+
+		JobQueue queue(defaults, parse, ui_seed);
+		long long i_jobs = 0, i_failed = 0;
+
+		#if ENABLE_STD_OUT
+			std::cout << "# threads = " << nThreads << std::endl;
+			std::cout << "batch: " << options.s_batchSource << ", seed " << ui_seed << std::endl;
+		#endif
+		out_file << "# threads = " << nThreads << std::endl;
+		out_file << "batch: " << options.s_batchSource << ", seed " << ui_seed << std::endl;
+
+		// start a timer
+		const timePoint start = highRes_Clock::now();
+
+		#pragma omp parallel num_threads(nThreads)
+		{
+			std::unique_ptr<Population> trip;  // this worker's population, kept across jobs
+			EvolutionBuffers buffers;          // this worker's offspring pool and parents, kept across jobs
+			BatchJob job;
+			bool b_more = true;
+
+			// the operators' own parallel regions run on this worker alone
+			omp_set_num_threads(1);
+
+			while (b_more)
+			{
+				#pragma omp critical(batch_queue)
+				{
+					b_more = queue.next(job);
+				} // end critical
+
+				if (!b_more)
+				{
+					break;
+				} // end if
+
+				std::string s_report;
+				bool b_solved = job.s_error.empty();
+
+				if (b_solved)
+				{
+					try
+					{
+						s_report = solve(job, trip, buffers);
+					} // end try
+					catch (const std::exception& e)
+					{
+						b_solved = false;
+						job.s_error = e.what();
+					} // end catch
+				} // end if
+
+				if (!b_solved)
+				{
+					s_report = "failed: " + job.s_error;
+				} // end if
+
+				#pragma omp critical(batch_output)
+				{
+					i_jobs++;
+					i_failed += !b_solved;
+
+					#if ENABLE_STD_OUT
+						std::cout << "job " << job.ui_index << " " << job.s_name << ": " << s_report << std::endl;
+					#endif
+					out_file << "job " << job.ui_index << " " << job.s_name << ": " << s_report << std::endl;
+				} // end critical
+			} // end while
+		} // end parallel
+
+		const long long i_elapsed = static_cast<long long>(std::chrono::duration_cast<std::chrono::microseconds>(highRes_Clock::now() - start).count());
+		const double d_rate = (i_elapsed > 0 ? i_jobs * 1e6 / i_elapsed : 0.0);
+
+		#if ENABLE_STD_OUT
+			std::cout << "batch: " << i_jobs << " jobs, " << i_failed << " failed, elapsed time = " << i_elapsed << " us (" << d_rate << " jobs/s)" << std::endl;
+		#endif
+		out_file << "batch: " << i_jobs << " jobs, " << i_failed << " failed, elapsed time = " << i_elapsed << " us (" << d_rate << " jobs/s)" << std::endl;
+		out_file << std::endl << std::endl;
+
+		return (i_failed > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+	} // end method runBatch
+
+#pragma endregion
@@ -0,0 +1,29 @@
+#ifndef _BATCH_H_
+#define _BATCH_H_
+
+#pragma region Includes:
+
+	#include <fstream>       // std::ofstream
+	#include "RunOptions.h"  // RunOptions
+
+#pragma endregion
+
+
+#pragma region Defines:
+
+	#define BATCH_STDIN    "-"   // --batch value that reads job lines from standard input
+
+#pragma endregion
+
+
+// Parses one "name=value" command line option into a RunOptions, as the Tsp front end does.
+typedef bool (*OptionParser)(const char* arg, RunOptions& options);
+
+
+#pragma region Prototypes:
+
+	int runBatch(const RunOptions& options, std::ofstream& out_file, const OptionParser parse);
+
+#pragma endregion
+
+#endif
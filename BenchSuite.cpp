@@ -0,0 +1,461 @@
+// Reproducible benchmark suite of the whole GA pipeline.
+// usage: bench_suite [--threads=1,2,4] [--sizes=10000,50000] [--cities=36,100] [--generations=N] [--repeats=N]
+//                    [--seed=N] [--save=results.csv] [--baseline=results.csv]
+//
+// Every configuration runs on a generated instance (cities and tours drawn from --seed), so two runs of the
+// suite measure exactly the same work. Each configuration is run once to warm up and then --repeats times;
+// the report gives the mean generation loop time with a 95% confidence interval, throughput, the best tour
+// found and the scaling efficiency:
+//   strong  fixed population, efficiency = T0 * t(T0) / (T * t(T)) against the smallest thread count T0
+//   weak    population grown with the threads (size * T / T0), efficiency = t(T0) / t(T)
+// --save writes the results as CSV, --baseline diffs against a file written by an earlier --save.
+
+#pragma region Includes:
+
+	#include <iostream>         // cout
+	#include <iomanip>          // setw
+	#include <fstream>          // ifstream, ofstream
+	#include <sstream>          // std::istringstream
+	#include <string>           // std::string
+	#include <vector>           // std::vector
+	#include <map>              // std::map
+	#include <algorithm>        // std::min_element
+	#include <cmath>            // sqrt, fabs
+	#include <cstdlib>          // strtoull
+	#include <string.h>         // strncmp, strchr
+	#include <omp.h>            // omp_set_num_threads, omp_get_num_procs
+	#include "Evolution.h"      // evolve
+	#include "Generator.h"      // generateCoordinates
+	#include "Instance.h"       // Instance, loadPopulation
+
+#pragma endregion
+
+
+#pragma region Defines:
+
+	#define SUITE_SEED           534   // default seed of the generated instances and engines
+	#define SUITE_GENERATIONS    30    // default generations per run
+	#define SUITE_REPEATS        5     // default timed runs per configuration
+	#define SUITE_MUTATION_RATE  50    // starting mutation rate of every run
+
+#pragma endregion
+
+
+// One measured configuration of the suite.
+struct Measurement
+{
+	std::string s_kind;          // "strong" or "weak"
+	std::size_t ui_threads;      // threads running the GA
+	std::size_t ui_population;   // tours in the population
+	std::size_t ui_cities;       // cities of the instance
+	int         i_generations;   // generations per run
+	int         i_repeats;       // timed runs
+	double      d_mean;          // mean generation loop time in us
+	double      d_interval;      // half-width of the 95% confidence interval of d_mean in us
+	double      d_toursPerSecond;
+	double      d_generationsPerSecond;
+	double      d_efficiency;    // scaling efficiency, 1 for the smallest thread count
+	float       f_best;          // shortest tour found, identical across repeats
+}; // end struct Measurement
+
+
+/// <summary>
+///          Two-sided 95% critical value of Student's t distribution with <paramref name="i_df"/> degrees of freedom.
+/// </summary>
+static double tCritical(const int i_df)
+{
+	static const double d_a_table[30] = { 12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+										   2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+										   2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042 };
+
+	return (i_df < 1 ? 0.0 : (i_df <= 30 ? d_a_table[i_df - 1] : 1.96));
+} // end method tCritical
+
+
+/// <summary>
+///          Parses a comma separated list of positive integers.
+/// </summary>
+/// <returns>
+///          true if every entry is a positive integer
+/// </returns>
+static bool parseList(const std::string& value, std::vector<std::size_t>& list)
+{
+	std::istringstream in(value);
+	std::string entry;
+
+	list.clear();
+
+	while (std::getline(in, entry, ','))
+	{
+		char* c_end = nullptr;
+		const unsigned long long ui_value = strtoull(entry.c_str(), &c_end, 10);
+
+		if (entry.empty() || *c_end != 0 || ui_value == 0)
+		{
+			return false;
+		} // end if
+
+		list.push_back(static_cast<std::size_t>(ui_value));
+	} // end while
+
+	return !list.empty();
+} // end method parseList
+
+
+/// <summary>
+///          Runs one configuration: a warm-up run and <paramref name="i_repeats"/> timed runs, each on a freshly generated
+///          copy of the same population with the same seed.
+/// </summary>
+static Measurement measure(const char* kind, const std::size_t ui_threads, const std::size_t ui_population, const std::size_t ui_cities,
+						   const int i_generations, const int i_repeats, const std::uint64_t ui_seed)
+{
+	RunOptions options;
+	Instance instance;
+
+	options.i_mutationRate = SUITE_MUTATION_RATE;
+	options.s_populationFile = RANDOM_POPULATION;
+
+	instance.coordinates.resize(ui_cities);
+	generateCoordinates(instance.coordinates.data(), ui_cities, ui_seed);
+	instance.ui_population = ui_population;
+	instance.ui_offsprings = (ui_population / 2) & ~static_cast<std::size_t>(1);
+	instance.i_generations = i_generations;
+
+	const DistanceMatrix distances(instance.coordinates.data(), ui_cities);
+	std::vector<double> d_v_times;
+	float f_best = 0.0f;
+
+	omp_set_num_threads(static_cast<int>(ui_threads));
+
+	for (int r = 0; r <= i_repeats; r++)
+	{
+		Population trip(ui_population, ui_cities);
+
+		loadPopulation(options, instance, trip, ui_seed);
+
+		const EvolutionResult result = evolve(options, instance, trip, distances, ui_seed, GenerationObserver());
+
+		// run 0 warms caches and the OpenMP team up
+		if (r > 0)
+		{
+			d_v_times.push_back(static_cast<double>(result.i_elapsed));
+		} // end if
+
+		f_best = result.f_shortest;
+	} // end for r
+
+	double d_mean = 0.0, d_variance = 0.0;
+
+	for (const double d_time : d_v_times)
+	{
+		d_mean += d_time;
+	} // end for d_time
+
+	d_mean /= d_v_times.size();
+
+	for (const double d_time : d_v_times)
+	{
+		d_variance += (d_time - d_mean) * (d_time - d_mean);
+	} // end for d_time
+
+	d_variance = (d_v_times.size() > 1 ? d_variance / (d_v_times.size() - 1) : 0.0);
+
+	Measurement m;
+	m.s_kind = kind;
+	m.ui_threads = ui_threads;
+	m.ui_population = ui_population;
+	m.ui_cities = ui_cities;
+	m.i_generations = i_generations;
+	m.i_repeats = i_repeats;
+	m.d_mean = d_mean;
+	m.d_interval = tCritical(static_cast<int>(d_v_times.size()) - 1) * std::sqrt(d_variance / d_v_times.size());
+	m.d_toursPerSecond = static_cast<double>(ui_population) * i_generations / (d_mean / 1e6);
+	m.d_generationsPerSecond = i_generations / (d_mean / 1e6);
+	m.d_efficiency = 1.0;
+	m.f_best = f_best;
+
+	return m;
+} // end method measure
+
+
+/// <summary>
+///          Key identifying the same configuration across runs of the suite.
+/// </summary>
+static std::string keyOf(const Measurement& m)
+{
+	std::ostringstream key;
+
+	key << m.s_kind << "," << m.ui_threads << "," << m.ui_population << "," << m.ui_cities << "," << m.i_generations;
+	return key.str();
+} // end method keyOf
+
+
+/// <summary>
+///          Writes <paramref name="results"/> as CSV, the format read back by <see cref="readResults"/>.
+/// </summary>
+static void writeResults(std::ostream& out, const std::vector<Measurement>& results, const std::uint64_t ui_seed)
+{
+	out << "# bench_suite seed=" << ui_seed << "\n";
+	out << "kind,threads,population,cities,generations,repeats,mean_us,ci95_us,tours_per_s,generations_per_s,efficiency,best\n";
+	out << std::fixed << std::setprecision(3);
+
+	for (const Measurement& m : results)
+	{
+		out << m.s_kind << "," << m.ui_threads << "," << m.ui_population << "," << m.ui_cities << "," << m.i_generations << ","
+			<< m.i_repeats << "," << m.d_mean << "," << m.d_interval << "," << m.d_toursPerSecond << "," << m.d_generationsPerSecond << ","
+			<< m.d_efficiency << "," << m.f_best << "\n";
+	} // end for m
+} // end method writeResults
+
+
+/// <summary>
+///          Reads results written by <see cref="writeResults"/>, keyed by <see cref="keyOf"/>.
+/// </summary>
+/// <returns>
+///          false if the file cannot be opened
+/// </returns>
+static bool readResults(const std::string& path, std::map<std::string, Measurement>& results)
+{
+	std::ifstream in_file(path);
+	std::string line;
+
+	if (!in_file.is_open())
+	{
+		return false;
+	} // end if
+
+	while (std::getline(in_file, line))
+	{
+		if (line.empty() || line[0] == '#' || line.compare(0, 5, "kind,") == 0)
+		{
+			continue;
+		} // end if
+
+		std::istringstream row(line);
+		std::vector<std::string> fields;
+		std::string field;
+
+		while (std::getline(row, field, ','))
+		{
+			fields.push_back(field);
+		} // end while
+
+		if (fields.size() != 12)
+		{
+			continue;
+		} // end if
+
+		Measurement m;
+		m.s_kind = fields[0];
+		m.ui_threads = std::stoull(fields[1]);
+		m.ui_population = std::stoull(fields[2]);
+		m.ui_cities = std::stoull(fields[3]);
+		m.i_generations = std::stoi(fields[4]);
+		m.i_repeats = std::stoi(fields[5]);
+		m.d_mean = std::stod(fields[6]);
+		m.d_interval = std::stod(fields[7]);
+		m.d_toursPerSecond = std::stod(fields[8]);
+		m.d_generationsPerSecond = std::stod(fields[9]);
+		m.d_efficiency = std::stod(fields[10]);
+		m.f_best = std::stof(fields[11]);
+
+		results[keyOf(m)] = m;
+	} // end while
+
+	return true;
+} // end method readResults
+
+
+int main(int argc, char* argv[])
+{
+	std::vector<std::size_t> threads, sizes = { 10000, 50000 }, cities = { 36, 100 };
+	int i_generations = SUITE_GENERATIONS;
+	int i_repeats = SUITE_REPEATS;
+	std::uint64_t ui_seed = SUITE_SEED;
+	std::string s_save, s_baseline;
+	bool b_argsValid = true;
+
+	// all powers of two up to the number of processors
+	for (std::size_t t = 1; t <= static_cast<std::size_t>(omp_get_num_procs()); t *= 2)
+	{
+		threads.push_back(t);
+	} // end for t
+
+	for (int i = 1; i < argc && b_argsValid; i++)
+	{
+		const char* c_separator = strchr(argv[i], '=');
+
+		if (strncmp(argv[i], "--", 2) != 0 || c_separator == nullptr)
+		{
+			b_argsValid = false;
+			break;
+		} // end if
+
+		const std::string name(static_cast<const char*>(argv[i] + 2), c_separator);
+		const std::string value(c_separator + 1);
+
+		if (name == "threads")
+		{
+			b_argsValid = parseList(value, threads);
+		} // end if
+		else if (name == "sizes")
+		{
+			b_argsValid = parseList(value, sizes);
+		} // end elif
+		else if (name == "cities")
+		{
+			b_argsValid = parseList(value, cities);
+		} // end elif
+		else if (name == "generations" || name == "repeats")
+		{
+			const int i_value = atoi(value.c_str());
+
+			b_argsValid = (i_value > 0);
+
+			if (name == "generations")
+			{
+				i_generations = i_value;
+			} // end if
+			else
+			{
+				i_repeats = i_value;
+			} // end else
+		} // end elif
+		else if (name == "seed")
+		{
+			char* c_end = nullptr;
+
+			ui_seed = strtoull(value.c_str(), &c_end, 10);
+			b_argsValid = !value.empty() && *c_end == 0;
+		} // end elif
+		else if (name == "save")
+		{
+			s_save = value;
+		} // end elif
+		else if (name == "baseline")
+		{
+			s_baseline = value;
+		} // end elif
+		else
+		{
+			b_argsValid = false;
+		} // end else
+	} // end for i
+
+	if (!b_argsValid)
+	{
+		std::cout << "usage: bench_suite [--threads=1,2,4] [--sizes=10000,50000] [--cities=36,100] [--generations=N] [--repeats=N]"
+				  << " [--seed=N] [--save=results.csv] [--baseline=results.csv]" << std::endl;
+		return EXIT_FAILURE;
+	} // end if
+
+	std::vector<Measurement> results;
+	const std::size_t ui_minThreads = *std::min_element(threads.begin(), threads.end());
+
+	try
+	{
+		for (const std::size_t ui_cities : cities)
+		{
+			for (const std::size_t ui_size : sizes)
+			{
+				const std::size_t ui_first = results.size();
+
+				for (const std::size_t ui_threads : threads)
+				{
+					results.push_back(measure("strong", ui_threads, ui_size, ui_cities, i_generations, i_repeats, ui_seed));
+				} // end for ui_threads
+
+				// efficiency against the smallest thread count of this configuration
+				const Measurement base = *std::min_element(results.begin() + ui_first, results.end(),
+					[](const Measurement& a, const Measurement& b) { return a.ui_threads < b.ui_threads; });
+
+				for (std::size_t i = ui_first; i < results.size(); i++)
+				{
+					results[i].d_efficiency = (base.d_mean * base.ui_threads) / (results[i].d_mean * results[i].ui_threads);
+				} // end for i
+
+				for (const std::size_t ui_threads : threads)
+				{
+					if (ui_threads == ui_minThreads)
+					{
+						continue;
+					} // end if
+
+					Measurement weak = measure("weak", ui_threads, ui_size * ui_threads / ui_minThreads, ui_cities, i_generations, i_repeats, ui_seed);
+
+					weak.d_efficiency = base.d_mean / weak.d_mean;
+					results.push_back(weak);
+				} // end for ui_threads
+			} // end for ui_size
+		} // end for ui_cities
+	} // end try
+	catch (const std::exception& e)
+	{
+		std::cout << "Benchmark failed!" << std::endl;
+		std::cout << "Reason: " << e.what() << std::endl;
+		return EXIT_FAILURE;
+	} // end catch
+
+	std::cout << "seed = " << ui_seed << ", " << i_generations << " generations, " << i_repeats << " repeats, times in us per run" << std::endl;
+	std::cout << std::setw(7) << "kind" << std::setw(8) << "threads" << std::setw(11) << "tours" << std::setw(7) << "cities"
+			  << std::setw(13) << "mean" << std::setw(11) << "+-95%" << std::setw(13) << "tours/s" << std::setw(10) << "gens/s"
+			  << std::setw(8) << "eff." << std::setw(10) << "best" << std::endl;
+	std::cout << std::fixed << std::setprecision(1);
+
+	for (const Measurement& m : results)
+	{
+		std::cout << std::setw(7) << m.s_kind << std::setw(8) << m.ui_threads << std::setw(11) << m.ui_population << std::setw(7) << m.ui_cities
+				  << std::setw(13) << m.d_mean << std::setw(11) << m.d_interval << std::setw(13) << std::setprecision(0) << m.d_toursPerSecond
+				  << std::setw(10) << std::setprecision(2) << m.d_generationsPerSecond << std::setw(8) << m.d_efficiency
+				  << std::setw(10) << std::setprecision(3) << m.f_best << std::setprecision(1) << std::endl;
+	} // end for m
+
+	if (!s_baseline.empty())
+	{
+		std::map<std::string, Measurement> baseline;
+
+		if (!readResults(s_baseline, baseline))
+		{
+			std::cout << "Reading " << s_baseline << " failed!" << std::endl;
+			return EXIT_FAILURE;
+		} // end if
+
+		std::cout << std::endl << "against " << s_baseline << ": time change, significant if the 95% intervals do not overlap" << std::endl;
+
+		for (const Measurement& m : results)
+		{
+			const auto it = baseline.find(keyOf(m));
+
+			if (it == baseline.end())
+			{
+				std::cout << std::setw(7) << m.s_kind << std::setw(8) << m.ui_threads << std::setw(11) << m.ui_population << std::setw(7) << m.ui_cities
+						  << "   not in baseline" << std::endl;
+				continue;
+			} // end if
+
+			const Measurement& b = it->second;
+			const double d_change = 100.0 * (m.d_mean - b.d_mean) / b.d_mean;
+			const bool b_significant = std::fabs(m.d_mean - b.d_mean) > m.d_interval + b.d_interval;
+
+			std::cout << std::setw(7) << m.s_kind << std::setw(8) << m.ui_threads << std::setw(11) << m.ui_population << std::setw(7) << m.ui_cities
+					  << std::setw(9) << std::showpos << d_change << "%" << std::noshowpos << (b_significant ? "  significant" : "  noise")
+					  << "   best " << std::setprecision(3) << b.f_best << " -> " << m.f_best << std::setprecision(1)
+					  << (std::fabs(m.f_best - b.f_best) > 0.0005f ? "  (changed)" : "") << std::endl;
+		} // end for m
+	} // end if
+
+	if (!s_save.empty())
+	{
+		std::ofstream out_file(s_save, std::ios::out | std::ios::trunc);
+
+		if (!out_file.is_open())
+		{
+			std::cout << "Writing " << s_save << " failed!" << std::endl;
+			return EXIT_FAILURE;
+		} // end if
+
+		writeResults(out_file, results, ui_seed);
+	} // end if
+
+	return EXIT_SUCCESS;
+} // end Main
@@ -0,0 +1,302 @@
+#pragma region Includes:
+
+	#include "Checkpoint.h"     // Snapshot, CheckpointWriter
+	#include "Affinity.h"       // unpinThread
+	#include "PopulationFile.h" // fnv1a
+	#include <cstdio>           // fopen, fwrite, rename
+	#include <fstream>          // ifstream
+	#include <iterator>         // std::istreambuf_iterator
+	#include <stdexcept>        // std::runtime_error
+	#include <string.h>         // memcpy, memcmp
+	#include <unistd.h>         // fsync
+
+#pragma endregion
+
+
+#pragma region Defines:
+
+	#define SNAPSHOT_MAGIC          "TSPS"
+	#define SNAPSHOT_OFFSET_BASIS   0xCBF29CE484222325ull
+
+#pragma endregion
+
+
+static_assert(sizeof(SnapshotHeader) == 96, "SnapshotHeader must not contain padding");
+
+
+#pragma region Helpers:
+
+	/// <summary>
+	///          Bytes of a snapshot with the dimensions in <paramref name="header"/>.
+	/// </summary>
+	static std::size_t snapshotBytes(const SnapshotHeader& header) noexcept
+	{
+		const std::size_t ui_population = header.ui_population;
+
+		return sizeof(SnapshotHeader) + header.ui_threads * 4 * sizeof(std::uint64_t) + (ui_population + 1) * header.ui_cities * sizeof(gene_t)
+			   + ui_population * (sizeof(float) + 1);
+	} // end method snapshotBytes
+
+#pragma endregion
+
+
+#pragma region Implementations:
+
+	Snapshot::Snapshot(void) noexcept
+		: c_v_bytes()
+	{
+	} // end default constructor
+
+
+	/// <summary>
+	///          Reads the snapshot at <paramref name="s_path"/> and verifies its header and checksum.
+	/// </summary>
+	/// <exception cref="std::runtime_error">Thrown if the file cannot be read or is not an intact snapshot.</exception>
+	Snapshot::Snapshot(const std::string& s_path)
+		: c_v_bytes()
+	{
+		std::ifstream in_file(s_path, std::ios::in | std::ios::binary);
+
+		if (!in_file.is_open())
+		{
+			throw std::runtime_error("cannot open " + s_path);
+		} // end if
+
+		c_v_bytes.assign(std::istreambuf_iterator<char>(in_file), std::istreambuf_iterator<char>());
+
+		if (c_v_bytes.size() < sizeof(SnapshotHeader) || memcmp(header().c_a_magic, SNAPSHOT_MAGIC, sizeof(header().c_a_magic)) != 0)
+		{
+			throw std::runtime_error(s_path + " is not a snapshot");
+		} // end if
+
+		if (header().ui_version != SNAPSHOT_VERSION || c_v_bytes.size() != snapshotBytes(header())
+			|| fnv1a(c_v_bytes.data() + sizeof(SnapshotHeader), c_v_bytes.size() - sizeof(SnapshotHeader), SNAPSHOT_OFFSET_BASIS) != header().ui_checksum)
+		{
+			throw std::runtime_error(s_path + " has an unsupported version or is damaged");
+		} // end if
+	} // end constructor
+
+
+	/// <summary>
+	///          The shortest tour of the snapshot, header().ui_cities genes.
+	/// </summary>
+	const gene_t* Snapshot::shortest(void) const noexcept
+	{
+		return reinterpret_cast<const gene_t*>(c_v_bytes.data() + sizeof(SnapshotHeader) + header().ui_threads * 4 * sizeof(std::uint64_t));
+	} // end method shortest
+
+
+	/// <summary>
+	///          Packs a snapshot of a run into this buffer, reusing its memory. The checksum is left for the writer.
+	/// </summary>
+	/// <param name="header">
+	///          Header with every field but the magic, version and checksum filled in.
+	/// </param>
+	/// <param name="engines">
+	///          header.ui_threads engine states of four words each.
+	/// </param>
+	/// <param name="shortest">
+	///          The shortest tour so far.
+	/// </param>
+	/// <param name="population">
+	///          The population at the start of generation header.i_generation.
+	/// </param>
+	void Snapshot::pack(const SnapshotHeader& header, const std::vector<std::uint64_t>& engines, const gene_t* shortest, const Population& population)
+	{
+		const std::size_t ui_cities = population.cities();
+		const std::size_t ui_size = population.size();
+
+		c_v_bytes.resize(snapshotBytes(header));
+
+		unsigned char* c_a_out = c_v_bytes.data();
+
+		memcpy(c_a_out, &header, sizeof(header));
+		memcpy(c_a_out, SNAPSHOT_MAGIC, 4);
+		reinterpret_cast<SnapshotHeader*>(c_a_out)->ui_version = SNAPSHOT_VERSION;
+		c_a_out += sizeof(header);
+
+		memcpy(c_a_out, engines.data(), header.ui_threads * 4 * sizeof(std::uint64_t));
+		c_a_out += header.ui_threads * 4 * sizeof(std::uint64_t);
+
+		memcpy(c_a_out, shortest, ui_cities * sizeof(gene_t));
+		c_a_out += ui_cities * sizeof(gene_t);
+
+		for (std::size_t i = 0; i < ui_size; i++, c_a_out += ui_cities * sizeof(gene_t))
+		{
+			memcpy(c_a_out, population.genome(i), ui_cities * sizeof(gene_t));
+		} // end for i
+
+		for (std::size_t i = 0; i < ui_size; i++, c_a_out += sizeof(float))
+		{
+			const float f_fitness = population.fitness(i);
+
+			memcpy(c_a_out, &f_fitness, sizeof(float));
+		} // end for i
+
+		for (std::size_t i = 0; i < ui_size; i++)
+		{
+			*c_a_out++ = population.scored(i);
+		} // end for i
+	} // end method pack
+
+
+	/// <summary>
+	///          Copies the genomes, fitness values and scored flags of the snapshot into <paramref name="population"/>.
+	/// </summary>
+	/// <exception cref="std::runtime_error">Thrown if the population's dimensions differ from the snapshot's.</exception>
+	void Snapshot::restore(Population& population) const
+	{
+		const std::size_t ui_cities = population.cities();
+		const std::size_t ui_size = population.size();
+
+		if (ui_cities != header().ui_cities || ui_size != header().ui_population)
+		{
+			throw std::runtime_error("snapshot of " + std::to_string(header().ui_population) + " tours through " + std::to_string(header().ui_cities)
+									 + " cities does not fit a population of " + std::to_string(ui_size) + " tours through " + std::to_string(ui_cities));
+		} // end if
+
+		const unsigned char* c_a_in = reinterpret_cast<const unsigned char*>(shortest()) + ui_cities * sizeof(gene_t);
+
+		for (std::size_t i = 0; i < ui_size; i++, c_a_in += ui_cities * sizeof(gene_t))
+		{
+			memcpy(population.genome(i), c_a_in, ui_cities * sizeof(gene_t));
+		} // end for i
+
+		for (std::size_t i = 0; i < ui_size; i++, c_a_in += sizeof(float))
+		{
+			memcpy(&population.fitness(i), c_a_in, sizeof(float));
+		} // end for i
+
+		for (std::size_t i = 0; i < ui_size; i++, c_a_in++)
+		{
+			if (*c_a_in)
+			{
+				population.score(i, population.fitness(i));
+			} // end if
+			else
+			{
+				population.invalidate(i);
+			} // end else
+		} // end for i
+	} // end method restore
+
+
+	/// <summary>
+	///          Starts the writer thread for checkpoints at <paramref name="s_path"/>.
+	/// </summary>
+	CheckpointWriter::CheckpointWriter(const std::string& s_path)
+		: s_path(s_path), b_busy(false), b_quit(false), i_written(0), i_skipped(0), worker(&CheckpointWriter::work, this)
+	{
+	} // end constructor
+
+
+	CheckpointWriter::~CheckpointWriter(void)
+	{
+		if (worker.joinable())
+		{
+			{
+				std::lock_guard<std::mutex> guard(lock);
+				b_quit = true;
+			} // end lock
+
+			wake.notify_one();
+			worker.join();
+		} // end if
+	} // end destructor
+
+
+	/// <summary>
+	///          Whether the last posted snapshot is on disk, so <see cref="next"/> may be packed and posted.
+	/// </summary>
+	bool CheckpointWriter::idle(void)
+	{
+		std::lock_guard<std::mutex> guard(lock);
+
+		return !b_busy;
+	} // end method idle
+
+
+	/// <summary>
+	///          Hands the snapshot packed into <see cref="next"/> to the writer. Call only when <see cref="idle"/>.
+	/// </summary>
+	void CheckpointWriter::post(void)
+	{
+		{
+			std::lock_guard<std::mutex> guard(lock);
+
+			std::swap(pending.bytes(), writing.bytes());
+			b_busy = true;
+			i_written++;
+		} // end lock
+
+		wake.notify_one();
+	} // end method post
+
+
+	/// <summary>
+	///          Waits for the last snapshot to reach the disk and stops the writer.
+	/// </summary>
+	/// <exception cref="std::runtime_error">Thrown if a snapshot could not be written.</exception>
+	void CheckpointWriter::finish(void)
+	{
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			b_quit = true;
+		} // end lock
+
+		wake.notify_one();
+		worker.join();
+
+		if (!s_error.empty())
+		{
+			throw std::runtime_error(s_error);
+		} // end if
+	} // end method finish
+
+
+	/// <summary>
+	///          Body of the writer thread: checksums and writes every posted snapshot until told to quit.
+	/// </summary>
+	void CheckpointWriter::work(void)
+	{
+		// off the CPU of the GA thread that started it when the team is pinned
+		unpinThread();
+
+		const std::string s_temporary = s_path + ".tmp";
+		std::unique_lock<std::mutex> guard(lock);
+
+		for (;;)
+		{
+			wake.wait(guard, [this] { return b_busy || b_quit; });
+
+			if (!b_busy)
+			{
+				return;
+			} // end if
+
+			guard.unlock();
+
+			std::vector<unsigned char>& c_v_bytes = writing.bytes();
+			SnapshotHeader* header = reinterpret_cast<SnapshotHeader*>(c_v_bytes.data());
+			FILE* p_file = fopen(s_temporary.c_str(), "wb");
+
+			header->ui_checksum = fnv1a(c_v_bytes.data() + sizeof(SnapshotHeader), c_v_bytes.size() - sizeof(SnapshotHeader), SNAPSHOT_OFFSET_BASIS);
+
+			bool b_ok = (p_file != nullptr && fwrite(c_v_bytes.data(), 1, c_v_bytes.size(), p_file) == c_v_bytes.size() && fflush(p_file) == 0
+						 && fsync(fileno(p_file)) == 0);
+
+			b_ok = (p_file != nullptr && fclose(p_file) == 0 && b_ok);
+			b_ok = b_ok && rename(s_temporary.c_str(), s_path.c_str()) == 0;
+
+			guard.lock();
+
+			if (!b_ok && s_error.empty())
+			{
+				s_error = "cannot write checkpoint " + s_path;
+			} // end if
+
+			b_busy = false;
+		} // end for
+	} // end method work
+
+#pragma endregion
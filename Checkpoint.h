@@ -0,0 +1,124 @@
+#ifndef _CHECKPOINT_H_
+#define _CHECKPOINT_H_
+
+#pragma region Includes:
+
+	#include <condition_variable> // std::condition_variable
+	#include <cstddef>            // std::size_t
+	#include <cstdint>            // fixed width integers
+	#include <mutex>              // std::mutex
+	#include <string>             // std::string
+	#include <thread>             // std::thread
+	#include <vector>             // std::vector
+	#include "Population.h"       // Population, gene_t
+
+#pragma endregion
+
+
+#pragma region Defines:
+
+	#define SNAPSHOT_VERSION    1     // version of SnapshotHeader and the sections behind it
+
+	#ifndef CHECKPOINT_INTERVAL
+		#define CHECKPOINT_INTERVAL    25    // generations between two checkpoints unless --checkpoint-every says otherwise
+	#endif
+
+#pragma endregion
+
+
+// Binary snapshot of a single-process GA run at the start of a generation, native byte order:
+//
+//   SnapshotHeader                           96 bytes
+//   engines     ui_threads * 4 x uint64      xoshiro256** state of every thread's engine
+//   shortest    ui_cities genes              shortest tour so far
+//   genomes     ui_population * ui_cities    genes of every slot of the population
+//   fitness     ui_population floats         fitness of every slot
+//   scored      ui_population bytes          whether the fitness is that of the genome
+//
+// ui_checksum is the 64-bit FNV-1a hash of everything behind the header. Ranking keys, offsprings and parents are
+// rebuilt by the generation itself and not saved.
+struct SnapshotHeader
+{
+	char          c_a_magic[4];      // "TSPS"
+	std::uint32_t ui_version;        // SNAPSHOT_VERSION
+	std::uint32_t ui_cities;         // genes per tour
+	std::uint32_t ui_population;     // tours in the population
+	std::uint32_t ui_offsprings;     // tours replaced per generation
+	std::uint32_t ui_threads;        // engines saved, the run's thread count
+	std::int32_t  i_generation;      // generation to run next
+	std::int32_t  i_bestGeneration;  // generation that found the shortest tour
+	float         f_shortest;        // its length
+	std::int32_t  i_mutationRate;    // mutation controller: current rate
+	std::int32_t  i_inversionShare;  // mutation controller: current % of inversions
+	std::int32_t  i_improved;        // stopping criteria: latest generation with a shorter tour
+	double        d_pressure;        // mutation controller: smoothed diversity shortfall
+	std::int64_t  i_evaluations;     // stopping criteria: tours evaluated so far
+	std::int64_t  i_checked;         // validation: genomes checked
+	std::int64_t  i_invalid;         // validation: genomes invalid
+	std::int64_t  i_repaired;        // validation: genomes repaired
+	std::uint64_t ui_checksum;       // FNV-1a over the sections
+}; // end struct SnapshotHeader
+
+
+// A snapshot held in memory, either packed from a running GA or read back from a file.
+class Snapshot
+{
+public:
+	Snapshot(void) noexcept;
+	explicit Snapshot(const std::string& s_path);
+
+	void pack(const SnapshotHeader& header, const std::vector<std::uint64_t>& engines, const gene_t* shortest, const Population& population);
+	void restore(Population& population) const;
+
+	inline const SnapshotHeader&       header(void) const noexcept  { return *reinterpret_cast<const SnapshotHeader*>(c_v_bytes.data()); }
+	inline const std::uint64_t*        engines(void) const noexcept { return reinterpret_cast<const std::uint64_t*>(c_v_bytes.data() + sizeof(SnapshotHeader)); }
+	const gene_t*                      shortest(void) const noexcept;
+	inline std::vector<unsigned char>& bytes(void) noexcept         { return c_v_bytes; }
+
+private:
+	std::vector<unsigned char> c_v_bytes; // header and sections, back to back
+}; // end class Snapshot
+
+
+// Writes snapshots on a background thread of its own.
+//
+// post() hands over a packed snapshot by swapping buffers and returns at once; the writer checksums it, writes it
+// to "<path>.tmp" and renames that over the path, so a crash mid-write leaves the previous checkpoint intact. While a
+// write is still running, further snapshots are dropped rather than queued: the next interval brings a newer one.
+class CheckpointWriter
+{
+public:
+	explicit CheckpointWriter(const std::string& s_path);
+	~CheckpointWriter(void);
+
+	CheckpointWriter(const CheckpointWriter&) = delete;
+	CheckpointWriter& operator=(const CheckpointWriter&) = delete;
+
+	// buffer to pack the next snapshot into, only while idle() says so
+	inline Snapshot& next(void) noexcept { return pending; }
+
+	bool idle(void);
+	void post(void);
+	void finish(void);
+
+	inline long long written(void) const noexcept { return i_written; }
+	inline long long skipped(void) const noexcept { return i_skipped; }
+	inline void      skip(void) noexcept          { i_skipped++; }
+
+private:
+	void work(void);
+
+	std::string             s_path;      // checkpoint file
+	Snapshot                pending;     // packed by the GA thread
+	Snapshot                writing;     // owned by the writer thread while b_busy
+	std::mutex              lock;        // guards b_busy, b_quit and s_error
+	std::condition_variable wake;        // signals a posted snapshot or the end
+	bool                    b_busy;      // whether writing holds a snapshot not on disk yet
+	bool                    b_quit;      // whether the writer should exit once idle
+	std::string             s_error;     // first write error, reported by finish
+	long long               i_written;   // snapshots posted
+	long long               i_skipped;   // snapshots dropped because the writer was busy
+	std::thread             worker;      // the writer thread, started last
+}; // end class CheckpointWriter
+
+#endif
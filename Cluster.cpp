@@ -0,0 +1,310 @@
+#pragma region Includes:
+
+	#include "Cluster.h"    // Cluster, WireHeader
+	#include <algorithm>    // std::max
+	#include <chrono>       // std::chrono::milliseconds
+	#include <cstdlib>      // EXIT_SUCCESS, EXIT_FAILURE
+	#include <iostream>     // std::cout
+	#include <stdexcept>    // std::runtime_error, std::invalid_argument
+	#include <thread>       // std::this_thread::sleep_for
+	#include <errno.h>      // errno
+	#include <fcntl.h>      // open
+	#include <poll.h>       // poll
+	#include <string.h>     // memcpy, memcmp, strerror
+	#include <sys/socket.h> // socket, bind, sendmsg, recvmsg
+	#include <sys/un.h>     // sockaddr_un
+	#include <sys/wait.h>   // waitpid
+	#include <unistd.h>     // fork, close, unlink, dup2
+
+#pragma endregion
+
+
+#pragma region Helpers:
+
+	/// <summary>
+	///          Fills <paramref name="address"/> with the Unix socket path <paramref name="s_path"/>.
+	/// </summary>
+	/// <exception cref="std::invalid_argument">Thrown if the path does not fit a socket address.</exception>
+	static void toAddress(const std::string& s_path, sockaddr_un& address)
+	{
+		if (s_path.size() >= sizeof(address.sun_path))
+		{
+			throw std::invalid_argument("Socket path " + s_path + " is too long!");
+		} // end if
+
+		memset(&address, 0, sizeof(address));
+		address.sun_family = AF_UNIX;
+		memcpy(address.sun_path, s_path.c_str(), s_path.size() + 1);
+	} // end method toAddress
+
+#pragma endregion
+
+
+#pragma region Implementations:
+
+	/// <summary>
+	///          Binds the socket of <paramref name="ui_rank"/>, replacing one a crashed run may have left behind.
+	/// </summary>
+	/// <param name="s_endpoint">
+	///          Path prefix shared by all ranks of the run.
+	/// </param>
+	/// <param name="ui_rank">
+	///          This rank, below <paramref name="ui_ranks"/>.
+	/// </param>
+	/// <param name="ui_ranks">
+	///          Number of ranks of the run.
+	/// </param>
+	/// <param name="ui_cities">
+	///          Genes per tour, every message of the run carries the same instance.
+	/// </param>
+	/// <param name="ui_maxTours">
+	///          Most tours a message may carry.
+	/// </param>
+	/// <exception cref="std::invalid_argument">Thrown if the rank is out of range or the path too long.</exception>
+	/// <exception cref="std::runtime_error">Thrown if the socket cannot be created or bound.</exception>
+	Cluster::Cluster(const std::string& s_endpoint, const std::size_t ui_rank, const std::size_t ui_ranks, const std::size_t ui_cities,
+					 const std::size_t ui_maxTours)
+		: i_socket(-1), s_endpoint(s_endpoint), ui_rank(ui_rank), ui_ranks(ui_ranks), ui_cities(ui_cities), ui_maxTours(std::max<std::size_t>(ui_maxTours, 1)),
+		  g_v_outbox(this->ui_maxTours * ui_cities), g_v_inbox(this->ui_maxTours * ui_cities)
+	{
+		static_assert(sizeof(WireHeader) == 28, "WireHeader must not be padded");
+
+		sockaddr_un address;
+
+		if (ui_rank >= ui_ranks)
+		{
+			throw std::invalid_argument("Rank " + std::to_string(ui_rank) + " of " + std::to_string(ui_ranks) + " ranks!");
+		} // end if
+
+		toAddress(path(ui_rank), address);
+
+		i_socket = socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+
+		if (i_socket < 0)
+		{
+			throw std::runtime_error(std::string("Cannot create socket: ") + strerror(errno));
+		} // end if
+
+		unlink(address.sun_path);
+
+		if (bind(i_socket, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0)
+		{
+			const std::string s_error = strerror(errno);
+
+			close(i_socket);
+			throw std::runtime_error("Cannot bind " + path(ui_rank) + ": " + s_error);
+		} // end if
+
+		// queue a few full messages per peer, the default buffers hold less than one for large instances
+		const int i_bytes = static_cast<int>(std::min<std::size_t>(8 * (sizeof(WireHeader) + g_v_inbox.size() * sizeof(gene_t)), 64u << 20));
+
+		setsockopt(i_socket, SOL_SOCKET, SO_SNDBUF, &i_bytes, sizeof(i_bytes));
+		setsockopt(i_socket, SOL_SOCKET, SO_RCVBUF, &i_bytes, sizeof(i_bytes));
+	} // end constructor
+
+
+	Cluster::~Cluster(void)
+	{
+		close(i_socket);
+		unlink(path(ui_rank).c_str());
+	} // end destructor
+
+
+	/// <summary>
+	///          Socket path of rank <paramref name="ui_of"/>.
+	/// </summary>
+	std::string Cluster::path(const std::size_t ui_of) const
+	{
+		return s_endpoint + "." + std::to_string(ui_of);
+	} // end method path
+
+
+	/// <summary>
+	///          Sends the first <paramref name="ui_tours"/> genomes of <see cref="outbox"/> to rank <paramref name="ui_to"/>.
+	/// </summary>
+	/// <param name="b_wait">
+	///          Whether to keep retrying for up to CLUSTER_TIMEOUT_MS while the receiver is full or not bound yet,
+	///          instead of dropping the message.
+	/// </param>
+	/// <returns>
+	///          true if the message was queued at the receiver
+	/// </returns>
+	/// <exception cref="std::runtime_error">Thrown on errors other than a full or missing receiver.</exception>
+	bool Cluster::send(const std::size_t ui_to, const MessageKind e_kind, const int i_generation, const std::size_t ui_tours, const float f_fitness,
+					   const bool b_wait)
+	{
+		WireHeader header = { { 'T', 'S', 'P', 'M' }, WIRE_VERSION, static_cast<std::uint16_t>(e_kind), static_cast<std::uint32_t>(ui_rank),
+							  i_generation, static_cast<std::uint32_t>(ui_tours), static_cast<std::uint32_t>(ui_cities), f_fitness };
+		iovec iov[2] = { { &header, sizeof(header) }, { g_v_outbox.data(), std::min(ui_tours, ui_maxTours) * ui_cities * sizeof(gene_t) } };
+		sockaddr_un address;
+		msghdr message;
+
+		toAddress(path(ui_to), address);
+		memset(&message, 0, sizeof(message));
+		message.msg_name = &address;
+		message.msg_namelen = sizeof(address);
+		message.msg_iov = iov;
+		message.msg_iovlen = 2;
+
+		const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(CLUSTER_TIMEOUT_MS);
+
+		for (;;)
+		{
+			if (sendmsg(i_socket, &message, MSG_DONTWAIT) >= 0)
+			{
+				return true;
+			} // end if
+
+			if (errno == EINTR)
+			{
+				continue;
+			} // end if
+
+			if (errno != EAGAIN && errno != EWOULDBLOCK && errno != ENOENT && errno != ECONNREFUSED && errno != ENOBUFS)
+			{
+				throw std::runtime_error("Sending to " + path(ui_to) + " failed: " + strerror(errno));
+			} // end if
+
+			if (!b_wait || std::chrono::steady_clock::now() > deadline)
+			{
+				return false;
+			} // end if
+
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		} // end for
+	} // end method send
+
+
+	/// <summary>
+	///          Takes the next well-formed message without waiting; its genomes are left in <see cref="inbox"/>.
+	///          Messages of another program, version or instance are discarded.
+	/// </summary>
+	/// <param name="header">
+	///          Output parameter for the message's header.
+	/// </param>
+	/// <returns>
+	///          false if no message is waiting
+	/// </returns>
+	bool Cluster::receive(WireHeader& header)
+	{
+		for (;;)
+		{
+			iovec iov[2] = { { &header, sizeof(header) }, { g_v_inbox.data(), g_v_inbox.size() * sizeof(gene_t) } };
+			msghdr message;
+
+			memset(&message, 0, sizeof(message));
+			message.msg_iov = iov;
+			message.msg_iovlen = 2;
+
+			const ssize_t i_bytes = recvmsg(i_socket, &message, MSG_DONTWAIT);
+
+			if (i_bytes < 0)
+			{
+				if (errno == EINTR)
+				{
+					continue;
+				} // end if
+
+				return false;
+			} // end if
+
+			if (static_cast<std::size_t>(i_bytes) >= sizeof(header) && (message.msg_flags & MSG_TRUNC) == 0 && memcmp(header.c_a_magic, "TSPM", 4) == 0
+				&& header.ui_version == WIRE_VERSION && header.ui_cities == ui_cities && header.ui_rank < ui_ranks && header.ui_tours <= ui_maxTours
+				&& static_cast<std::size_t>(i_bytes) == sizeof(header) + header.ui_tours * ui_cities * sizeof(gene_t))
+			{
+				return true;
+			} // end if
+		} // end for
+	} // end method receive
+
+
+	/// <summary>
+	///          Waits until a message arrives or <paramref name="i_timeoutMs"/> ms have passed.
+	/// </summary>
+	/// <returns>
+	///          true if a message is waiting
+	/// </returns>
+	bool Cluster::wait(const int i_timeoutMs)
+	{
+		pollfd descriptor = { i_socket, POLLIN, 0 };
+
+		return poll(&descriptor, 1, i_timeoutMs) > 0;
+	} // end method wait
+
+
+	/// <summary>
+	///          Forks ranks 1 to <paramref name="ui_ranks"/> - 1 of a run on this host. The children continue from here
+	///          with their rank set and standard output discarded, only rank 0 reports.
+	/// </summary>
+	/// <param name="ui_rank">
+	///          Set to the rank of the returning process.
+	/// </param>
+	/// <returns>
+	///          The children's process ids in the parent, empty in a child
+	/// </returns>
+	/// <exception cref="std::runtime_error">Thrown if a process cannot be forked.</exception>
+	std::vector<pid_t> spawnRanks(std::size_t& ui_rank, const std::size_t ui_ranks)
+	{
+		std::vector<pid_t> children;
+
+		// nothing buffered may be written twice
+		std::cout.flush();
+
+		ui_rank = 0;
+
+		for (std::size_t r = 1; r < ui_ranks; r++)
+		{
+			const pid_t pid = fork();
+
+			if (pid < 0)
+			{
+				throw std::runtime_error(std::string("Cannot fork rank ") + std::to_string(r) + ": " + strerror(errno));
+			} // end if
+
+			if (pid == 0)
+			{
+				const int i_null = open("/dev/null", O_WRONLY);
+
+				if (i_null >= 0)
+				{
+					dup2(i_null, STDOUT_FILENO);
+					close(i_null);
+				} // end if
+
+				ui_rank = r;
+				return std::vector<pid_t>();
+			} // end if
+
+			children.push_back(pid);
+		} // end for r
+
+		return children;
+	} // end method spawnRanks
+
+
+	/// <summary>
+	///          Waits for the ranks <see cref="spawnRanks"/> forked.
+	/// </summary>
+	/// <returns>
+	///          EXIT_SUCCESS if all of them did, EXIT_FAILURE otherwise
+	/// </returns>
+	int waitRanks(const std::vector<pid_t>& children)
+	{
+		int i_result = EXIT_SUCCESS;
+
+		for (const pid_t pid : children)
+		{
+			int i_status = 0;
+
+			while (waitpid(pid, &i_status, 0) < 0 && errno == EINTR);
+
+			if (!WIFEXITED(i_status) || WEXITSTATUS(i_status) != EXIT_SUCCESS)
+			{
+				i_result = EXIT_FAILURE;
+			} // end if
+		} // end for
+
+		return i_result;
+	} // end method waitRanks
+
+#pragma endregion
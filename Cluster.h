@@ -0,0 +1,101 @@
+#ifndef _CLUSTER_H_
+#define _CLUSTER_H_
+
+#pragma region Includes:
+
+	#include <cstddef>      // std::size_t
+	#include <cstdint>      // fixed width integers
+	#include <string>       // std::string
+	#include <vector>       // std::vector
+	#include <sys/types.h>  // pid_t
+	#include "Population.h" // gene_t
+
+#pragma endregion
+
+
+#pragma region Defines:
+
+	#define WIRE_VERSION    1     // version of WireHeader and the messages behind it
+
+	#ifndef CLUSTER_TIMEOUT_MS
+		#define CLUSTER_TIMEOUT_MS    30000 // ms rank 0 waits for silent ranks, and ranks retry their final report
+	#endif
+
+#pragma endregion
+
+
+// What a message between ranks carries.
+enum class MessageKind : std::uint16_t
+{
+	migrants = 1, // the sender's best tours, to be merged into the receiver's population
+	best     = 2, // a new shortest tour of the sender, for rank 0
+	done     = 3  // the sender's final shortest tour, the last message it sends rank 0
+}; // end enum MessageKind
+
+
+// Header of every message, followed by ui_tours * ui_cities genes. Ranks share one host, so all fields and genes
+// are in its byte order; the header is 28 bytes without padding.
+struct WireHeader
+{
+	char          c_a_magic[4];  // "TSPM"
+	std::uint16_t ui_version;    // WIRE_VERSION
+	std::uint16_t ui_kind;       // MessageKind
+	std::uint32_t ui_rank;       // sender
+	std::int32_t  i_generation;  // sender's generation when it sent
+	std::uint32_t ui_tours;      // tours following the header
+	std::uint32_t ui_cities;     // genes per tour
+	float         f_fitness;     // length of the first tour
+}; // end struct WireHeader
+
+
+// One rank's end of a multi-process GA run.
+//
+// Every rank binds a Unix datagram socket at "<endpoint>.<rank>" and sends to the others' paths. Datagrams keep
+// message boundaries and sends never wait for the receiver, so migration overlaps with the GA: a rank posts its
+// migrants and goes on, and reads whatever has arrived at the start of its next generation. When the receiver's
+// queue is full or its socket is not bound yet, a migration is simply lost.
+class Cluster
+{
+public:
+	Cluster(const std::string& s_endpoint, const std::size_t ui_rank, const std::size_t ui_ranks, const std::size_t ui_cities,
+			const std::size_t ui_maxTours);
+	~Cluster(void);
+
+	Cluster(const Cluster&) = delete;
+	Cluster& operator=(const Cluster&) = delete;
+
+	// room for ui_maxTours genomes to send, packed back to back
+	inline gene_t*       outbox(void) noexcept       { return g_v_outbox.data(); }
+	// genomes of the last received message
+	inline const gene_t* inbox(void) const noexcept  { return g_v_inbox.data(); }
+
+	inline std::size_t rank(void) const noexcept  { return ui_rank; }
+	inline std::size_t ranks(void) const noexcept { return ui_ranks; }
+
+	bool send(const std::size_t ui_to, const MessageKind e_kind, const int i_generation, const std::size_t ui_tours, const float f_fitness,
+			  const bool b_wait);
+	bool receive(WireHeader& header);
+	bool wait(const int i_timeoutMs);
+
+private:
+	std::string path(const std::size_t ui_of) const;
+
+	int                 i_socket;     // bound datagram socket
+	std::string         s_endpoint;   // path prefix of all ranks' sockets
+	std::size_t         ui_rank;      // this rank
+	std::size_t         ui_ranks;     // number of ranks
+	std::size_t         ui_cities;    // genes per tour
+	std::size_t         ui_maxTours;  // tours per message at most
+	std::vector<gene_t> g_v_outbox;   // genomes to send
+	std::vector<gene_t> g_v_inbox;    // genomes received
+}; // end class Cluster
+
+
+#pragma region Prototypes:
+
+	std::vector<pid_t> spawnRanks(std::size_t& ui_rank, const std::size_t ui_ranks);
+	int waitRanks(const std::vector<pid_t>& children);
+
+#pragma endregion
+
+#endif
@@ -0,0 +1,177 @@
+#ifndef _CROSSOVER_HPP_
+#define _CROSSOVER_HPP_
+
+#pragma region Includes:
+
+	#include <cstddef>       // std::size_t
+	#include <cstdint>       // std::uint8_t, std::uint64_t
+	#include <vector>        // std::vector
+	#include "Population.h"  // gene_t
+	#include "Random.hpp"    // Xoshiro256, randomBelow
+	#include "Profiler.h"    // PROFILE_COUNT, PROFILE_TALLY
+
+#pragma endregion
+
+
+#pragma region Defines:
+
+	#define CROSSOVER_WORD_CITIES 64 // cities that fit the one-word visited set of WordCrossoverState
+
+#pragma endregion
+
+
+#pragma region Crossover State:
+
+	// Scratch space of crossoverChild for instances of up to CROSSOVER_WORD_CITIES cities, the common case:
+	// the visited set is one 64-bit word, so testing and marking a city is a shift, and the free list
+	// fits in bytes.
+	struct WordCrossoverState
+	{
+		typedef std::uint8_t city_t; // entry of the free list and the position index
+
+		city_t        c_a_free[CROSSOVER_WORD_CITIES];     // cities not on the route yet
+		city_t        c_a_position[CROSSOVER_WORD_CITIES]; // index of each city in c_a_free
+		std::uint64_t ui_visited;                          // bit c is set once city c is on the route
+		std::uint64_t ui_lookups = 0;                      // distances read, for the profiler
+		std::uint64_t ui_draws = 0;                        // random cities drawn, for the profiler
+
+		inline void    reset(const std::size_t) noexcept                 { ui_visited = 0; }
+		inline bool    visited(const std::size_t ui_city) const noexcept { return (ui_visited >> ui_city) & 1; }
+		inline void    visit(const std::size_t ui_city) noexcept         { ui_visited |= (1ull << ui_city); }
+		inline city_t* freeList(void) noexcept                           { return c_a_free; }
+		inline city_t* positions(void) noexcept                          { return c_a_position; }
+	}; // end struct WordCrossoverState
+
+
+	// Scratch space of crossoverChild for any number of cities, the visited set is a bitset of words.
+	// Every thread keeps its state across generations, so it is sized once for the instance and reused for all children.
+	struct BitsetCrossoverState
+	{
+		typedef gene_t city_t; // entry of the free list and the position index
+
+		std::vector<gene_t>        g_v_free;     // cities not on the route yet
+		std::vector<gene_t>        g_v_position; // index of each city in g_v_free
+		std::vector<std::uint64_t> ui_v_visited; // bit c is set once city c is on the route
+		std::uint64_t              ui_lookups = 0; // distances read, for the profiler
+		std::uint64_t              ui_draws = 0;   // random cities drawn, for the profiler
+
+		inline void reset(const std::size_t ui_cities)
+		{
+			if (g_v_free.size() < ui_cities)
+			{
+				PROFILE_COUNT(Counter::allocations, 3);
+				g_v_free.resize(ui_cities);
+				g_v_position.resize(ui_cities);
+			} // end if
+
+			ui_v_visited.assign((ui_cities + 63) / 64, 0);
+		} // end method reset
+
+		inline bool    visited(const std::size_t ui_city) const noexcept { return (ui_v_visited[ui_city >> 6] >> (ui_city & 63)) & 1; }
+		inline void    visit(const std::size_t ui_city) noexcept         { ui_v_visited[ui_city >> 6] |= (1ull << (ui_city & 63)); }
+		inline city_t* freeList(void) noexcept                           { return g_v_free.data(); }
+		inline city_t* positions(void) noexcept                          { return g_v_position.data(); }
+	}; // end struct BitsetCrossoverState
+
+#pragma endregion
+
+
+#pragma region Templates:
+
+	/// <summary>
+	///          Allocation-free greedy-edge crossover of a single child. Starting from the first city of <paramref name="p1"/>,
+	///          position j takes the closer of the two parents' j-th cities, the other one if the closer one is already on the
+	///          route, or a random unvisited city if both are.
+	/// </summary>
+	/// <typeparam name="State">
+	///                     Scratch space holding the visited set and the free list.
+	/// </typeparam>
+	/// <typeparam name="Distance">
+	///                     Any source providing operator()(from, to) over city indices.
+	/// </typeparam>
+	/// <param name="p1">
+	///                    First parent.
+	/// </param>
+	/// <param name="p2">
+	///                    Second parent.
+	/// </param>
+	/// <param name="child">
+	///                    Output, the child genome.
+	/// </param>
+	/// <param name="ui_cities">
+	///                    Number of cities, at most <see cref="CROSSOVER_WORD_CITIES"/> for <see cref="WordCrossoverState"/>.
+	/// </param>
+	/// <param name="distances">
+	///                    The distance source to use.
+	/// </param>
+	/// <param name="engine">
+	///                    The calling thread's random engine.
+	/// </param>
+	/// <param name="state">
+	///                    The calling thread's scratch space.
+	/// </param>
+	/// <remarks>
+	///          Visited cities are bits of the state's visited set. The unvisited cities are kept in a free list with a position
+	///          index, so a random unvisited city is one draw and removing any city is a swap with the last entry. Nothing is
+	///          allocated once the state has been sized for the instance.
+	/// </remarks>
+	template<typename State, typename Distance>
+	inline void crossoverChild(const gene_t* p1, const gene_t* p2, gene_t* child, const std::size_t ui_cities, const Distance& distances, Xoshiro256& engine, State& state)
+	{
+		typedef typename State::city_t city_t;
+
+		state.reset(ui_cities);
+
+		city_t* c_a_free = state.freeList();
+		city_t* c_a_position = state.positions();
+		std::size_t ui_free = ui_cities;
+
+		for (std::size_t k = 0; k < ui_cities; k++)
+		{
+			c_a_free[k] = static_cast<city_t>(k);
+			c_a_position[k] = static_cast<city_t>(k);
+		} // end for k
+
+		gene_t g_current = p1[0];
+
+		for (std::size_t j = 0; ; )
+		{
+			// put g_current on the route and drop it from the free list
+			const city_t c_last = c_a_free[--ui_free];
+			const city_t c_slot = c_a_position[g_current];
+
+			c_a_free[c_slot] = c_last;
+			c_a_position[c_last] = c_slot;
+			state.visit(g_current);
+			child[j] = g_current;
+
+			if (++j == ui_cities)
+			{
+				break;
+			} // end if
+
+			const gene_t g_p1 = p1[j];
+			const gene_t g_p2 = p2[j];
+			const bool b_p1Visited = state.visited(g_p1);
+			const bool b_p2Visited = state.visited(g_p2);
+
+			if (b_p1Visited && b_p2Visited)
+			{
+				g_current = c_a_free[randomBelow(engine, ui_free)];
+				PROFILE_TALLY(state.ui_draws, 1);
+			} // end if
+			else if (b_p1Visited || b_p2Visited)
+			{
+				g_current = (b_p1Visited ? g_p2 : g_p1);
+			} // end elif
+			else
+			{
+				g_current = (distances(g_current, g_p1) < distances(g_current, g_p2) ? g_p1 : g_p2);
+				PROFILE_TALLY(state.ui_lookups, 2);
+			} // end else
+		} // end for j
+	} // end template crossoverChild
+
+#pragma endregion
+
+#endif
@@ -0,0 +1,135 @@
+// Microbenchmark of the crossover operator, counting heap allocations per generation.
+// usage: bench_crossover [#threads] [#generations]
+//
+// Loads chromosome.txt and cities.txt, then runs crossover on the Trip[] and the Population layout
+// with every global operator new counted. The allocation-free kernel should report 0 for both.
+
+#pragma region Includes:
+
+	#include <iostream>         // cout
+	#include <fstream>          // ifstream
+	#include <cstdlib>          // atoi, malloc, free
+	#include <vector>           // std::vector
+	#include <atomic>           // std::atomic
+	#include <new>              // operator new
+	#include <omp.h>            // omp_set_num_threads
+	#include "utility.hpp"      // Point, highRes_Clock
+	#include "Trip.h"           // Trip
+	#include "Population.h"     // Population
+	#include "DistanceMatrix.h" // DistanceMatrix
+
+#pragma endregion
+
+
+#pragma region External Function Prototypes:
+
+	extern void crossover(Trip parents[TOP_X], Trip offsprings[TOP_X], const DistanceMatrix& distances);
+	extern void crossover(const Population& population, std::uint32_t parents[], Population& offsprings, const DistanceMatrix& distances);
+
+#pragma endregion
+
+
+#pragma region Allocation Counting:
+
+	static std::atomic<unsigned long long> ui_allocations(0); // calls to global operator new
+
+	void* operator new(std::size_t ui_bytes)
+	{
+		ui_allocations.fetch_add(1, std::memory_order_relaxed);
+
+		void* p_block = malloc(ui_bytes > 0 ? ui_bytes : 1);
+
+		if (p_block == nullptr)
+		{
+			throw std::bad_alloc();
+		} // end if
+
+		return p_block;
+	} // end operator new
+
+	void* operator new[](std::size_t ui_bytes)            { return operator new(ui_bytes); }
+	void operator delete(void* p_block) noexcept           { free(p_block); }
+	void operator delete[](void* p_block) noexcept         { free(p_block); }
+	void operator delete(void* p_block, std::size_t) noexcept   { free(p_block); }
+	void operator delete[](void* p_block, std::size_t) noexcept { free(p_block); }
+
+#pragma endregion
+
+
+int main(int argc, char* argv[])
+{
+	const int nThreads = (argc > 1 ? atoi(argv[1]) : 1);
+	const int i_generations = (argc > 2 ? atoi(argv[2]) : 20);
+
+	Trip *trip = new Trip[CHROMOSOMES], *offsprings = new Trip[TOP_X];
+	Population population(CHROMOSOMES, CITIES), children(TOP_X, CITIES);
+	std::vector<std::uint32_t> parents(TOP_X);
+	Point coordinates[CITIES];
+
+	std::ifstream chromosome_file("chromosome.txt");
+	std::ifstream cities_file("cities.txt");
+
+	for (int i = 0; i < CHROMOSOMES; i++)
+	{
+		chromosome_file >> trip[i].itinerary;
+		population.fromNames(i, trip[i].itinerary);
+	} // end for i
+
+	for (int i = 0; i < CITIES; i++)
+	{
+		char city;
+		cities_file >> city;
+		int index = (city >= 'A') ? city - 'A' : city - '0' + 26;
+		cities_file >> coordinates[index].x >> coordinates[index].y;
+	} // end for i
+
+	if (!chromosome_file || !cities_file)
+	{
+		std::cout << "Reading chromosome.txt or cities.txt failed! Exiting ..." << std::endl;
+		delete[] trip;
+		delete[] offsprings;
+		return EXIT_FAILURE;
+	} // end if
+
+	const DistanceMatrix distances(coordinates, CITIES);
+
+	for (int i = 0; i < TOP_X; i++)
+	{
+		parents[i] = static_cast<std::uint32_t>(i);
+	} // end for i
+
+	omp_set_num_threads(nThreads);
+
+	// warm up the thread pool and the per-thread engines outside the measurement
+	crossover(trip, offsprings, distances);
+	crossover(population, parents.data(), children, distances);
+
+	for (int layout = 0; layout < 2; layout++)
+	{
+		const unsigned long long ui_before = ui_allocations.load();
+		timePoint start = highRes_Clock::now();
+
+		for (int generation = 0; generation < i_generations; generation++)
+		{
+			if (layout == 0)
+			{
+				crossover(trip, offsprings, distances);
+			} // end if
+			else
+			{
+				crossover(population, parents.data(), children, distances);
+			} // end else
+		} // end for generation
+
+		timePoint end = highRes_Clock::now();
+		const unsigned long long ui_count = ui_allocations.load() - ui_before;
+
+		std::cout << (layout == 0 ? "Trip[]" : "SoA") << ":\t" << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / i_generations
+				  << " us per generation\t" << static_cast<double>(ui_count) / i_generations << " allocations per generation" << std::endl;
+	} // end for layout
+
+	delete[] trip;
+	delete[] offsprings;
+
+	return EXIT_SUCCESS;
+} // end Main
@@ -0,0 +1,695 @@
+#pragma region Includes:
+
+	#include "Daemon.h"         // Connection, ServiceJob, JobScheduler
+	#include "DistanceMatrix.h" // DistanceMatrix
+	#include "Evolution.h"      // evolve, EvolutionBuffers
+	#include "Trip.h"           // CHROMOSOMES
+	#include <omp.h>            // omp_set_num_threads
+	#include <algorithm>        // std::push_heap, std::pop_heap, std::nth_element
+	#include <atomic>           // std::atomic
+	#include <chrono>           // std::chrono::milliseconds
+	#include <cstdlib>          // EXIT_SUCCESS
+	#include <iostream>         // cout
+	#include <random>           // std::random_device
+	#include <stdexcept>        // std::invalid_argument
+	#include <string>           // std::string
+	#include <thread>           // std::thread
+	#include <errno.h>          // errno
+	#include <poll.h>           // poll
+	#include <signal.h>         // sigaction
+	#include <string.h>         // memcpy, memset
+	#include <sys/socket.h>     // accept4, recv, setsockopt
+	#include <unistd.h>         // close
+
+#pragma endregion
+
+
+#pragma region Helpers:
+
+	static volatile sig_atomic_t b_stopSignal = 0; // set by SIGINT and SIGTERM
+
+
+	/// <summary>
+	///          Asks the connection loop to shut the daemon down.
+	/// </summary>
+	static void onStopSignal(int)
+	{
+		b_stopSignal = 1;
+	} // end method onStopSignal
+
+
+	/// <summary>
+	///          Microseconds from <paramref name="from"/> to <paramref name="to"/>.
+	/// </summary>
+	static inline long long microseconds(const timePoint from, const timePoint to) noexcept
+	{
+		return static_cast<long long>(std::chrono::duration_cast<std::chrono::microseconds>(to - from).count());
+	} // end method microseconds
+
+
+	/// <summary>
+	///          Sends a rejection of the job <paramref name="ui_tag"/> with <paramref name="s_reason"/>.
+	/// </summary>
+	static void reject(Connection& client, const std::uint32_t ui_job, const std::uint32_t ui_tag, const std::size_t ui_queued, const std::string& s_reason)
+	{
+		const Receipt receipt = { ui_tag, static_cast<std::uint32_t>(ui_queued) };
+
+		client.send(FrameKind::rejected, ui_job, &receipt, sizeof(receipt), s_reason.data(), s_reason.size());
+	} // end method reject
+
+
+	/// <summary>
+	///          Turns a submit frame into a job of the daemon's options with the request's budget on top.
+	/// </summary>
+	/// <param name="s_error">
+	///          Output parameter for why the request is malformed.
+	/// </param>
+	/// <returns>
+	///          The job, null if the request is malformed
+	/// </returns>
+	static std::unique_ptr<ServiceJob> makeJob(const RunOptions& defaults, const std::uint64_t ui_seed, const std::uint32_t ui_id, const FrameHeader& header,
+											   const std::vector<unsigned char>& payload, std::string& s_error)
+	{
+		JobRequest request;
+
+		if (payload.size() < sizeof(request))
+		{
+			s_error = "short request";
+			return nullptr;
+		} // end if
+
+		memcpy(&request, payload.data(), sizeof(request));
+
+		const std::size_t ui_population = (request.ui_population > 0 ? request.ui_population : defaults.ui_population > 0 ? defaults.ui_population : CHROMOSOMES);
+
+		if (request.ui_cities < 2 || request.ui_cities > 65536 || payload.size() != sizeof(request) + request.ui_cities * 2 * sizeof(std::int32_t))
+		{
+			s_error = "a job needs between 2 and 65536 cities, and their coordinates";
+			return nullptr;
+		} // end if
+
+		// the worker builds a full distance matrix for the job, which grows with the square of the cities
+		if (ui_population < 4 || ui_population * request.ui_cities > SERVICE_MAX_GENES || DistanceMatrix::bytes(request.ui_cities) > SERVICE_MAX_MATRIX
+			|| request.i_generations < 0 || request.i_deadline < 0 || request.f_target < 0)
+		{
+			s_error = "population, cities, generations, deadline or target out of range";
+			return nullptr;
+		} // end if
+
+		std::unique_ptr<ServiceJob> job(new ServiceJob());
+		const std::int32_t* i_a_xy = reinterpret_cast<const std::int32_t*>(payload.data() + sizeof(request));
+
+		job->ui_id = ui_id;
+		job->ui_tag = header.ui_job;
+		job->options = defaults;
+		job->options.s_populationFile = RANDOM_POPULATION;
+		job->options.ui_seed = (request.ui_seed != 0 ? request.ui_seed : ui_seed ^ (static_cast<std::uint64_t>(ui_id) * 0x9E3779B97F4A7C15ull));
+		job->options.b_hasSeed = true;
+		job->options.d_targetDistance = (request.f_target > 0 ? request.f_target : defaults.d_targetDistance);
+		job->instance.coordinates.resize(request.ui_cities);
+
+		for (std::size_t i = 0; i < request.ui_cities; i++)
+		{
+			std::int32_t i_a_point[2];
+
+			memcpy(i_a_point, i_a_xy + 2 * i, sizeof(i_a_point));
+			job->instance.coordinates[i] = Point(i_a_point[0], i_a_point[1]);
+		} // end for i
+
+		job->instance.ui_population = ui_population;
+		job->instance.ui_offsprings = (defaults.ui_offsprings > 0 && defaults.ui_offsprings < ui_population ? defaults.ui_offsprings : ui_population / 2) & ~static_cast<std::size_t>(1);
+		job->instance.i_generations = (request.i_generations > 0 ? request.i_generations : defaults.i_generations);
+		job->i_priority = request.i_priority;
+		job->submitted = highRes_Clock::now();
+		job->b_hasDeadline = (request.i_deadline > 0);
+		job->deadline = job->submitted + std::chrono::milliseconds(request.i_deadline);
+
+		return job;
+	} // end method makeJob
+
+
+	/// <summary>
+	///          Body of a worker thread: takes the most urgent job, solves it alone and streams its improving tours to the
+	///          client, until the scheduler closes. Like a batch worker it keeps its population, offspring pool and parent
+	///          slots from job to job.
+	/// </summary>
+	/// <param name="output">
+	///          Serializes the workers' log lines.
+	/// </param>
+	static void serveJobs(JobScheduler& scheduler, std::ofstream& out_file, std::mutex& output)
+	{
+		std::unique_ptr<Population> trip;  // this worker's population, kept across jobs
+		EvolutionBuffers buffers;          // this worker's offspring pool and parents, kept across jobs
+		std::unique_ptr<ServiceJob> job;
+
+		// the operators' own parallel regions run on this worker alone
+		omp_set_num_threads(1);
+
+		while (scheduler.pop(job))
+		{
+			const timePoint started = highRes_Clock::now();
+			const long long i_waited = microseconds(job->submitted, started);
+			const std::size_t ui_cities = job->instance.cities();
+			Connection& client = *job->client;
+
+			if (job->b_hasDeadline && started >= job->deadline)
+			{
+				scheduler.expired();
+				reject(client, job->ui_id, job->ui_tag, 0, "deadline passed in the queue");
+				continue;
+			} // end if
+
+			// what is left of the deadline becomes the run's own
+			if (job->b_hasDeadline)
+			{
+				const long long i_left = std::max(1LL, static_cast<long long>(std::chrono::duration_cast<std::chrono::milliseconds>(job->deadline - started).count()));
+
+				job->options.i_deadline = (job->options.i_deadline > 0 ? std::min(job->options.i_deadline, i_left) : i_left);
+			} // end if
+
+			try
+			{
+				if (!trip || trip->size() != job->instance.ui_population || trip->cities() != ui_cities)
+				{
+					trip.reset(new Population(job->instance.ui_population, ui_cities));
+				} // end if
+
+				loadPopulation(job->options, job->instance, *trip, job->options.ui_seed);
+
+				// the fitness of a reused population belongs to the last job's tours
+				for (std::size_t i = 0; i < trip->size(); i++)
+				{
+					trip->invalidate(i);
+				} // end for i
+
+				const DistanceMatrix distances(job->instance.coordinates.data(), ui_cities);
+				const EvolutionResult result = evolve(job->options, job->instance, *trip, distances, job->options.ui_seed,
+					[&](const int generation, const bool b_improved, const EvolutionResult& best)
+				{
+					if (b_improved)
+					{
+						const TourReport report = { generation, best.f_shortest, static_cast<std::uint32_t>(ui_cities), 0, i_waited, microseconds(started, highRes_Clock::now()) };
+
+						client.send(FrameKind::improved, job->ui_id, &report, sizeof(report), best.shortest.data(), ui_cities * sizeof(gene_t));
+					} // end if
+				}, &buffers);
+
+				const timePoint finished = highRes_Clock::now();
+				const TourReport report = { result.i_bestGeneration, result.f_shortest, static_cast<std::uint32_t>(ui_cities),
+											static_cast<std::uint32_t>(result.e_stopReason), i_waited, microseconds(started, finished) };
+
+				client.send(FrameKind::finished, job->ui_id, &report, sizeof(report), result.shortest.data(), ui_cities * sizeof(gene_t));
+				scheduler.completed(i_waited, microseconds(job->submitted, finished));
+
+				std::lock_guard<std::mutex> guard(output);
+
+				#if ENABLE_STD_OUT
+					std::cout << "job " << job->ui_id << ": " << ui_cities << " cities, priority " << job->i_priority << ", waited " << i_waited << " us, ran "
+							  << report.i_elapsed << " us, shortest distance = " << result.f_shortest << " at generation " << result.i_bestGeneration
+							  << ", stopped: " << stopReasonName(result.e_stopReason) << std::endl;
+				#endif
+				out_file << "job " << job->ui_id << ": " << ui_cities << " cities, priority " << job->i_priority << ", waited " << i_waited << " us, ran "
+						 << report.i_elapsed << " us, shortest distance = " << result.f_shortest << " at generation " << result.i_bestGeneration
+						 << ", stopped: " << stopReasonName(result.e_stopReason) << std::endl;
+			} // end try
+			catch (const std::exception& e)
+			{
+				scheduler.failed();
+				reject(client, job->ui_id, job->ui_tag, 0, e.what());
+			} // end catch
+		} // end while
+	} // end method serveJobs
+
+
+	/// <summary>
+	///          Writes the scheduler metrics as a report line.
+	/// </summary>
+	static void writeMetrics(std::ostream& out, const ServiceMetrics& metrics)
+	{
+		out << "service: " << metrics.i_submitted << " jobs submitted, " << metrics.i_completed << " completed, " << metrics.i_rejected << " rejected, "
+			<< metrics.i_expired << " expired, " << metrics.i_queued << " queued, " << metrics.i_running << " running; wait " << metrics.d_meanWait
+			<< " us, latency " << metrics.d_meanLatency << " us (p50 " << metrics.d_p50Latency << ", p99 " << metrics.d_p99Latency << "), "
+			<< metrics.d_throughput << " jobs/s" << std::endl;
+	} // end method writeMetrics
+
+#pragma endregion
+
+
+#pragma region Implementations:
+
+	/// <summary>
+	///          Wraps an accepted client socket. Writes time out after SERVICE_SEND_TIMEOUT_MS so a client that stops
+	///          reading cannot hold a worker.
+	/// </summary>
+	Connection::Connection(const int i_socket) noexcept
+		: i_socket(i_socket), b_open(true)
+	{
+		const timeval timeout = { SERVICE_SEND_TIMEOUT_MS / 1000, (SERVICE_SEND_TIMEOUT_MS % 1000) * 1000 };
+
+		setsockopt(i_socket, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+	} // end constructor
+
+
+	Connection::~Connection(void)
+	{
+		close(i_socket);
+	} // end destructor
+
+
+	/// <summary>
+	///          Sends one frame unless the connection is closed.
+	/// </summary>
+	/// <returns>
+	///          true if the frame went out
+	/// </returns>
+	bool Connection::send(const FrameKind e_kind, const std::uint32_t ui_job, const void* p_first, const std::size_t ui_firstBytes, const void* p_second,
+						  const std::size_t ui_secondBytes)
+	{
+		std::lock_guard<std::mutex> guard(lock);
+
+		b_open = b_open && writeFrame(i_socket, e_kind, ui_job, p_first, ui_firstBytes, p_second, ui_secondBytes);
+
+		return b_open;
+	} // end method send
+
+
+	/// <summary>
+	///          Drops every further frame, the client has gone or broke the protocol.
+	/// </summary>
+	void Connection::hangUp(void)
+	{
+		std::lock_guard<std::mutex> guard(lock);
+
+		b_open = false;
+		shutdown(i_socket, SHUT_RDWR);
+	} // end method hangUp
+
+
+	JobScheduler::JobScheduler(void)
+		: b_closed(false), start(highRes_Clock::now()), i_order(0), i_running(0), i_submitted(0), i_completed(0), i_rejected(0), i_expired(0),
+		  d_waited(0), d_latency(0)
+	{
+	} // end constructor
+
+
+	/// <summary>
+	///          Whether <paramref name="first"/> should run after <paramref name="second"/>.
+	/// </summary>
+	bool JobScheduler::lessUrgent(const std::unique_ptr<ServiceJob>& first, const std::unique_ptr<ServiceJob>& second) noexcept
+	{
+		if (first->i_priority != second->i_priority)
+		{
+			return first->i_priority < second->i_priority;
+		} // end if
+
+		if (first->b_hasDeadline != second->b_hasDeadline)
+		{
+			return !first->b_hasDeadline;
+		} // end if
+
+		if (first->b_hasDeadline && first->deadline != second->deadline)
+		{
+			return first->deadline > second->deadline;
+		} // end if
+
+		return first->i_order > second->i_order;
+	} // end method lessUrgent
+
+
+	/// <summary>
+	///          Queues <paramref name="job"/> and wakes a worker.
+	/// </summary>
+	/// <returns>
+	///          Jobs waiting, this one included
+	/// </returns>
+	std::size_t JobScheduler::push(std::unique_ptr<ServiceJob> job)
+	{
+		std::size_t ui_queued = 0;
+
+		{
+			std::lock_guard<std::mutex> guard(lock);
+
+			job->i_order = i_order++;
+			queue.push_back(std::move(job));
+			std::push_heap(queue.begin(), queue.end(), lessUrgent);
+			i_submitted++;
+			ui_queued = queue.size();
+		} // end lock
+
+		wake.notify_one();
+
+		return ui_queued;
+	} // end method push
+
+
+	/// <summary>
+	///          Waits for the most urgent job and counts it as running.
+	/// </summary>
+	/// <returns>
+	///          false once the scheduler is closed
+	/// </returns>
+	bool JobScheduler::pop(std::unique_ptr<ServiceJob>& job)
+	{
+		std::unique_lock<std::mutex> guard(lock);
+
+		wake.wait(guard, [this] { return b_closed || !queue.empty(); });
+
+		if (b_closed)
+		{
+			return false;
+		} // end if
+
+		std::pop_heap(queue.begin(), queue.end(), lessUrgent);
+		job = std::move(queue.back());
+		queue.pop_back();
+		i_running++;
+
+		return true;
+	} // end method pop
+
+
+	/// <summary>
+	///          Sends the workers home once their running jobs are done.
+	/// </summary>
+	/// <returns>
+	///          The jobs still waiting, for the caller to reject
+	/// </returns>
+	std::vector<std::unique_ptr<ServiceJob>> JobScheduler::close(void)
+	{
+		std::vector<std::unique_ptr<ServiceJob>> waiting;
+
+		{
+			std::lock_guard<std::mutex> guard(lock);
+
+			b_closed = true;
+			waiting.swap(queue);
+			i_rejected += static_cast<long long>(waiting.size());
+		} // end lock
+
+		wake.notify_all();
+
+		return waiting;
+	} // end method close
+
+
+	/// <summary>
+	///          Counts a job that sent its final tour after <paramref name="i_waited"/> us in the queue and
+	///          <paramref name="i_latency"/> us since submission.
+	/// </summary>
+	void JobScheduler::completed(const long long i_waited, const long long i_latency)
+	{
+		std::lock_guard<std::mutex> guard(lock);
+
+		i_running--;
+		d_waited += i_waited;
+		d_latency += i_latency;
+
+		if (i_v_latencies.size() < SERVICE_LATENCY_WINDOW)
+		{
+			i_v_latencies.push_back(i_latency);
+		} // end if
+		else
+		{
+			i_v_latencies[static_cast<std::size_t>(i_completed % SERVICE_LATENCY_WINDOW)] = i_latency;
+		} // end else
+
+		i_completed++;
+	} // end method completed
+
+
+	void JobScheduler::expired(void)
+	{
+		std::lock_guard<std::mutex> guard(lock);
+
+		i_running--;
+		i_expired++;
+	} // end method expired
+
+
+	void JobScheduler::failed(void)
+	{
+		std::lock_guard<std::mutex> guard(lock);
+
+		i_running--;
+		i_rejected++;
+	} // end method failed
+
+
+	void JobScheduler::rejected(void)
+	{
+		std::lock_guard<std::mutex> guard(lock);
+
+		i_rejected++;
+	} // end method rejected
+
+
+	/// <summary>
+	///          Snapshot of the queue depth, counts, latencies and throughput.
+	/// </summary>
+	ServiceMetrics JobScheduler::metrics(void) const
+	{
+		std::vector<long long> i_v_sorted;
+		ServiceMetrics metrics;
+
+		{
+			std::lock_guard<std::mutex> guard(lock);
+
+			metrics.i_queued = static_cast<std::int64_t>(queue.size());
+			metrics.i_running = i_running;
+			metrics.i_submitted = i_submitted;
+			metrics.i_completed = i_completed;
+			metrics.i_rejected = i_rejected;
+			metrics.i_expired = i_expired;
+			metrics.i_uptime = microseconds(start, highRes_Clock::now());
+			metrics.d_meanWait = (i_completed > 0 ? d_waited / i_completed : 0.0);
+			metrics.d_meanLatency = (i_completed > 0 ? d_latency / i_completed : 0.0);
+			i_v_sorted = i_v_latencies;
+		} // end lock
+
+		metrics.d_p50Latency = metrics.d_p99Latency = 0;
+
+		if (!i_v_sorted.empty())
+		{
+			const std::size_t ui_p50 = i_v_sorted.size() / 2;
+			const std::size_t ui_p99 = std::min(i_v_sorted.size() - 1, i_v_sorted.size() * 99 / 100);
+
+			std::nth_element(i_v_sorted.begin(), i_v_sorted.begin() + ui_p50, i_v_sorted.end());
+			metrics.d_p50Latency = static_cast<double>(i_v_sorted[ui_p50]);
+			std::nth_element(i_v_sorted.begin(), i_v_sorted.begin() + ui_p99, i_v_sorted.end());
+			metrics.d_p99Latency = static_cast<double>(i_v_sorted[ui_p99]);
+		} // end if
+
+		metrics.d_throughput = (metrics.i_uptime > 0 ? metrics.i_completed * 1e6 / metrics.i_uptime : 0.0);
+
+		return metrics;
+	} // end method metrics
+
+
+	/// <summary>
+	///          Serves GA jobs on options.s_serveEndpoint until a client sends a shutdown frame or the process gets SIGINT
+	///          or SIGTERM. The calling thread runs the connection loop: it accepts clients, parses their frames, queues
+	///          submitted jobs and answers metrics requests. options.nThreads worker threads take the queued jobs by
+	///          priority and deadline and solve each alone, streaming every new shortest tour back to the client that
+	///          submitted it. On shutdown the waiting jobs are rejected and the running ones finish.
+	/// </summary>
+	/// <param name="options">
+	///          Options every job starts from, and the endpoint.
+	/// </param>
+	/// <param name="out_file">
+	///          File handle to output file.
+	/// </param>
+	/// <returns>
+	///          0 after a clean shutdown
+	/// </returns>
+	/// <exception cref="std::invalid_argument">Thrown if the options select a mode jobs cannot run in, or the endpoint is malformed.</exception>
+	/// <exception cref="std::runtime_error">Thrown if the endpoint cannot be bound.</exception>
+	int runDaemon(const RunOptions& options, std::ofstream& out_file)
+	{
+		if (!sharesProcess(options) || !options.s_batchSource.empty())
+		{
+			throw std::invalid_argument("The daemon runs every job on one thread with the distance matrix, without islands, ranks, checkpoints, profiles or batches!");
+		} // end if
+
+		RunOptions defaults = options;
+		std::random_device rd{};
+		const std::uint64_t ui_seed = (options.b_hasSeed ? options.ui_seed : (static_cast<std::uint64_t>(rd()) << 32) ^ rd());
+		const int nThreads = std::max(1, options.nThreads);
+		const int i_listen = listenEndpoint(options.s_serveEndpoint);
+		std::vector<std::shared_ptr<Connection>> connections;
+		std::vector<std::thread> workers;
+		std::vector<pollfd> descriptors;
+		std::vector<unsigned char> payload;
+		std::uint32_t ui_nextId = 1;
+		JobScheduler scheduler;
+		std::mutex output;
+		struct sigaction action;
+
+		// jobs share the process, the profiler is not theirs to drive
+		defaults.b_profile = false;
+
+		memset(&action, 0, sizeof(action));
+		action.sa_handler = onStopSignal;
+		sigaction(SIGINT, &action, nullptr);
+		sigaction(SIGTERM, &action, nullptr);
+		b_stopSignal = 0;
+
+		#if ENABLE_STD_OUT
+			std::cout << "# threads = " << nThreads << std::endl;
+			std::cout << "daemon: " << options.s_serveEndpoint << ", seed " << ui_seed << std::endl;
+		#endif
+		out_file << "# threads = " << nThreads << std::endl;
+		out_file << "daemon: " << options.s_serveEndpoint << ", seed " << ui_seed << std::endl;
+
+		for (int i = 0; i < nThreads; i++)
+		{
+			workers.emplace_back(serveJobs, std::ref(scheduler), std::ref(out_file), std::ref(output));
+		} // end for i
+
+		while (!b_stopSignal)
+		{
+			descriptors.assign(1, pollfd{ i_listen, POLLIN, 0 });
+
+			for (const std::shared_ptr<Connection>& connection : connections)
+			{
+				descriptors.push_back(pollfd{ connection->socket(), POLLIN, 0 });
+			} // end for
+
+			if (poll(descriptors.data(), descriptors.size(), SERVICE_POLL_MS) <= 0)
+			{
+				continue;
+			} // end if
+
+			if (descriptors[0].revents & POLLIN)
+			{
+				const int i_client = accept4(i_listen, nullptr, nullptr, SOCK_CLOEXEC);
+
+				if (i_client >= 0)
+				{
+					connections.push_back(std::make_shared<Connection>(i_client));
+				} // end if
+			} // end if
+
+			// read what every client sent and act on each complete frame; descriptors[c + 1] belongs to connections[c]
+			for (std::size_t c = connections.size(); c-- > 0;)
+			{
+				Connection& connection = *connections[c];
+				std::vector<unsigned char>& input = connection.c_v_input;
+				bool b_keep = true;
+
+				if (c + 1 >= descriptors.size() || descriptors[c + 1].revents == 0)
+				{
+					continue;
+				} // end if
+
+				unsigned char c_a_chunk[1 << 16];
+				const ssize_t i_read = recv(connection.socket(), c_a_chunk, sizeof(c_a_chunk), MSG_DONTWAIT);
+
+				if (i_read == 0 || (i_read < 0 && errno != EINTR && errno != EAGAIN && errno != EWOULDBLOCK))
+				{
+					b_keep = false;
+				} // end if
+				else if (i_read > 0)
+				{
+					input.insert(input.end(), c_a_chunk, c_a_chunk + i_read);
+				} // end elif
+
+				std::size_t ui_used = 0;
+
+				while (b_keep && input.size() - ui_used >= sizeof(FrameHeader))
+				{
+					FrameHeader header;
+
+					memcpy(&header, input.data() + ui_used, sizeof(header));
+
+					if (!validFrame(header))
+					{
+						b_keep = false;
+						break;
+					} // end if
+
+					if (input.size() - ui_used < sizeof(header) + header.ui_bytes)
+					{
+						break;
+					} // end if
+
+					payload.assign(input.begin() + ui_used + sizeof(header), input.begin() + ui_used + sizeof(header) + header.ui_bytes);
+					ui_used += sizeof(header) + header.ui_bytes;
+
+					switch (static_cast<FrameKind>(header.ui_kind))
+					{
+						case FrameKind::submit:
+						{
+							std::string s_error;
+							std::unique_ptr<ServiceJob> job = makeJob(defaults, ui_seed, ui_nextId, header, payload, s_error);
+
+							if (!job)
+							{
+								scheduler.rejected();
+								reject(connection, 0, header.ui_job, 0, s_error);
+								break;
+							} // end if
+
+							job->client = connections[c];
+
+							const Receipt receipt = { header.ui_job, 0 };
+							const std::uint32_t ui_id = ui_nextId++;
+
+							// the receipt goes out before a worker can send the job's first tour
+							connection.send(FrameKind::accepted, ui_id, &receipt, sizeof(receipt));
+							scheduler.push(std::move(job));
+							break;
+						} // end case submit
+
+						case FrameKind::stats:
+						{
+							const ServiceMetrics metrics = scheduler.metrics();
+
+							connection.send(FrameKind::stats, 0, &metrics, sizeof(metrics));
+							break;
+						} // end case stats
+
+						case FrameKind::shutdown:
+							b_stopSignal = 1;
+							break;
+
+						default:
+							b_keep = false;
+							break;
+					} // end switch
+				} // end while
+
+				input.erase(input.begin(), input.begin() + static_cast<std::ptrdiff_t>(std::min(ui_used, input.size())));
+
+				if (!b_keep)
+				{
+					// running jobs keep the connection alive until they are done, their frames are dropped
+					connection.hangUp();
+					connections.erase(connections.begin() + static_cast<std::ptrdiff_t>(c));
+				} // end if
+			} // end for c
+		} // end while
+
+		closeEndpoint(options.s_serveEndpoint, i_listen);
+
+		for (const std::unique_ptr<ServiceJob>& job : scheduler.close())
+		{
+			reject(*job->client, job->ui_id, job->ui_tag, 0, "daemon shutting down");
+		} // end for
+
+		for (std::thread& worker : workers)
+		{
+			worker.join();
+		} // end for
+
+		const ServiceMetrics metrics = scheduler.metrics();
+
+		#if ENABLE_STD_OUT
+			writeMetrics(std::cout, metrics);
+		#endif
+		writeMetrics(out_file, metrics);
+		out_file << std::endl << std::endl;
+
+		return EXIT_SUCCESS;
+	} // end method runDaemon
+
+#pragma endregion
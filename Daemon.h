@@ -0,0 +1,124 @@
+#ifndef _DAEMON_H_
+#define _DAEMON_H_
+
+#pragma region Includes:
+
+	#include <condition_variable> // std::condition_variable
+	#include <cstdint>            // fixed width integers
+	#include <fstream>            // std::ofstream
+	#include <memory>             // std::shared_ptr, std::unique_ptr
+	#include <mutex>              // std::mutex
+	#include <vector>             // std::vector
+	#include "Instance.h"         // Instance
+	#include "RunOptions.h"       // RunOptions
+	#include "SolverProtocol.h"   // FrameKind, ServiceMetrics
+	#include "utility.hpp"        // timePoint
+
+#pragma endregion
+
+
+#pragma region Defines:
+
+	#ifndef SERVICE_LATENCY_WINDOW
+		#define SERVICE_LATENCY_WINDOW    1024  // latest job latencies the percentiles are taken over
+	#endif
+
+	#define SERVICE_POLL_MS               200   // ms the connection loop waits before it looks for a stop request
+	#define SERVICE_SEND_TIMEOUT_MS       5000  // ms a worker waits on a client that does not read before dropping its frames
+
+#pragma endregion
+
+
+// A client connection of the daemon. The connection loop reads from it; workers write the tours of its jobs, one
+// frame at a time under the lock. Once a write fails the connection counts as closed and further frames are dropped,
+// its jobs still run to completion. The socket is closed with the last job or loop that holds on to it.
+class Connection
+{
+public:
+	explicit Connection(const int i_socket) noexcept;
+	~Connection(void);
+
+	Connection(const Connection&) = delete;
+	Connection& operator=(const Connection&) = delete;
+
+	bool send(const FrameKind e_kind, const std::uint32_t ui_job, const void* p_first, const std::size_t ui_firstBytes,
+			  const void* p_second = nullptr, const std::size_t ui_secondBytes = 0);
+	void hangUp(void);
+
+	inline int socket(void) const noexcept { return i_socket; }
+
+	std::vector<unsigned char> c_v_input;  // bytes read but not yet parsed, connection loop only
+
+private:
+	int        i_socket;   // stream socket to the client
+	std::mutex lock;       // serializes the frames of concurrent jobs
+	bool       b_open;     // whether frames still go out
+}; // end class Connection
+
+
+// A queued or running job of the daemon.
+struct ServiceJob
+{
+	std::uint32_t               ui_id;         // id the daemon reports the job under
+	std::uint32_t               ui_tag;        // the client's own tag for it
+	std::shared_ptr<Connection> client;        // where its tours go
+	RunOptions                  options;       // the daemon's options with the job's budget on top
+	Instance                    instance;      // cities and dimensions
+	int                         i_priority;    // higher starts first
+	bool                        b_hasDeadline; // whether deadline applies
+	timePoint                   deadline;      // when the final tour is due
+	timePoint                   submitted;     // when the job was accepted
+	long long                   i_order;       // arrival order, breaks ties
+}; // end struct ServiceJob
+
+
+// Priority queue of the daemon's jobs, and its metrics.
+//
+// Workers take the job of the highest priority; within a priority jobs with a deadline go first, earliest deadline
+// first, then the rest in arrival order. A job whose deadline has passed by the time a worker takes it is not run.
+class JobScheduler
+{
+public:
+	JobScheduler(void);
+
+	JobScheduler(const JobScheduler&) = delete;
+	JobScheduler& operator=(const JobScheduler&) = delete;
+
+	std::size_t push(std::unique_ptr<ServiceJob> job);
+	bool pop(std::unique_ptr<ServiceJob>& job);
+	std::vector<std::unique_ptr<ServiceJob>> close(void);
+
+	void completed(const long long i_waited, const long long i_latency);
+	void expired(void);
+	void failed(void);
+	void rejected(void);
+
+	ServiceMetrics metrics(void) const;
+
+private:
+	static bool lessUrgent(const std::unique_ptr<ServiceJob>& first, const std::unique_ptr<ServiceJob>& second) noexcept;
+
+	mutable std::mutex                       lock;          // guards everything below
+	std::condition_variable                  wake;          // signals a queued job or the end
+	std::vector<std::unique_ptr<ServiceJob>> queue;         // heap, most urgent job first
+	bool                                     b_closed;      // whether workers should leave
+	timePoint                                start;         // when the daemon started
+	long long                                i_order;       // arrivals so far
+	long long                                i_running;     // jobs on a worker
+	long long                                i_submitted;   // jobs queued
+	long long                                i_completed;   // jobs that sent their final tour
+	long long                                i_rejected;    // submissions refused and jobs that failed
+	long long                                i_expired;     // jobs past their deadline in the queue
+	double                                   d_waited;      // us all completed jobs spent in the queue
+	double                                   d_latency;     // us from submission to final tour, all completed jobs
+	std::vector<long long>                   i_v_latencies; // ring of the latest SERVICE_LATENCY_WINDOW latencies
+}; // end class JobScheduler
+
+
+#pragma region Prototypes:
+
+	int runDaemon(const RunOptions& options, std::ofstream& out_file);
+
+#pragma endregion
+
+#endif
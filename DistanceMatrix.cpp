@@ -0,0 +1,47 @@
+#pragma region Includes:
+
+	#include "DistanceMatrix.h" // DistanceMatrix
+	#include <string.h>         // memset
+
+#pragma endregion
+
+
+/// <summary>
+///          Builds the full distance table for <paramref name="ui_cities"/> cities and the (0, 0) origin.
+/// </summary>
+/// <param name="coordinates">
+///          The (x, y) coordinates of all cities, indexed by city index.
+/// </param>
+/// <param name="ui_cities">
+///          Number of cities in <paramref name="coordinates"/>.
+/// </param>
+/// <exception cref="std::bad_alloc">Thrown if the table cannot be allocated.</exception>
+DistanceMatrix::DistanceMatrix(const Point* coordinates, const std::size_t ui_cities)
+	: f_a_table(nullptr), ui_cities(ui_cities), ui_stride(roundUp(ui_cities + 1, CACHE_LINE_SIZE / sizeof(float)))
+{
+	const std::size_t ui_rows = ui_cities + 1;
+	const std::size_t ui_bytes = bytes(ui_cities);
+
+	f_a_table = static_cast<float*>(alignedAlloc(ui_bytes));
+	memset(f_a_table, 0, ui_bytes);
+
+	const Point origin(0, 0);
+
+	for (std::size_t i = 0; i < ui_rows; i++)
+	{
+		const Point& from = (i < ui_cities ? coordinates[i] : origin);
+
+		for (std::size_t j = 0; j < ui_rows; j++)
+		{
+			const Point& to = (j < ui_cities ? coordinates[j] : origin);
+
+			f_a_table[i * ui_stride + j] = distance(from.x, from.y, to.x, to.y);
+		} // end for j
+	} // end for i
+} // end constructor
+
+
+DistanceMatrix::~DistanceMatrix(void)
+{
+	alignedFree(f_a_table);
+} // end destructor
@@ -0,0 +1,59 @@
+#ifndef _DISTANCE_MATRIX_H_
+#define _DISTANCE_MATRIX_H_
+
+#pragma region Includes:
+
+	#include <cstddef>     // std::size_t
+	#include "utility.hpp" // Point
+
+#pragma endregion
+
+
+// Dense, index-addressed table of the distances between every pair of cities plus the (0, 0) origin.
+//
+// Row i holds the distances from city i to every other city; the origin is stored as the last
+// row/column (index == cities()). Rows are padded to a whole number of cache lines and the table
+// itself is cache-line aligned, so a lookup is a single load and rows never share a line.
+// The table is immutable once built and therefore safe to read from any number of threads.
+class DistanceMatrix
+{
+public:
+	DistanceMatrix(const Point* coordinates, const std::size_t ui_cities);
+	~DistanceMatrix(void);
+
+	DistanceMatrix(const DistanceMatrix&) = delete;
+	DistanceMatrix& operator=(const DistanceMatrix&) = delete;
+
+	/// <summary>
+	///          Bytes of the table for <paramref name="ui_cities"/> cities, padding included.
+	/// </summary>
+	static inline std::size_t bytes(const std::size_t ui_cities) noexcept
+	{
+		return (ui_cities + 1) * roundUp(ui_cities + 1, CACHE_LINE_SIZE / sizeof(float)) * sizeof(float);
+	} // end method bytes
+
+	/// <summary>
+	///          Distance from city <paramref name="ui_from"/> to city <paramref name="ui_to"/>.
+	/// </summary>
+	inline float operator()(const std::size_t ui_from, const std::size_t ui_to) const noexcept
+	{
+		return f_a_table[ui_from * ui_stride + ui_to];
+	} // end operator ()
+
+	/// <summary>
+	///          Pointer to the row of distances from city <paramref name="ui_from"/>.
+	/// </summary>
+	inline const float* row(const std::size_t ui_from) const noexcept { return f_a_table + ui_from * ui_stride; }
+
+	inline const float* data(void)   const noexcept { return f_a_table; }
+	inline std::size_t  origin(void) const noexcept { return ui_cities; }
+	inline std::size_t  cities(void) const noexcept { return ui_cities; }
+	inline std::size_t  stride(void) const noexcept { return ui_stride; }
+
+private:
+	float*      f_a_table;  // (cities + 1) rows of ui_stride floats
+	std::size_t ui_cities;  // number of cities, also the index of the origin
+	std::size_t ui_stride;  // floats per row, multiple of a cache line
+}; // end class DistanceMatrix
+
+#endif
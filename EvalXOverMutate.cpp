@@ -1,9 +1,16 @@
 #pragma region Includes:
 
-    #include "Trip.h"      // Trip class
+    #include "DistanceMatrix.h" // DistanceMatrix
+    #include "MemoDistance.h" // MemoDistance, distanceV2
+    #include "FitnessKernel.h" // evaluateBatch
+    #include "Population.h" // Population
+    #include "Crossover.hpp" // crossoverChild, WordCrossoverState, BitsetCrossoverState
+    #include <vector>      // std::vector
     #include <omp.h>       // omp directives
     #include <algorithm>   // std::sort
     #include "utility.hpp" // RNG
+    #include "Random.hpp"  // localEngine
+    #include "Profiler.h"  // PROFILE_THREAD, PROFILE_COUNT
     #include "string.h"    // memset
     #include <iostream>
     #include <unordered_map> // hash map
@@ -14,16 +21,59 @@
 
 #pragma region Prototypes:
 
-    void evaluate(Trip trip[CHROMOSOMES], const Point* coordinates);
-    void crossover(Trip parents[TOP_X], Trip offsprings[TOP_X], const Point* coordinates);
-    void mutate(Trip offsprings[TOP_X], const int RATE);
-    void generateComplement(const char* trip1, char* trip2);
+    void evaluate(Population& population, const Point* coordinates);
+    void evaluate(Population& population, const DistanceMatrix& distances, const KernelIsa e_isa);
+    void crossover(const Population& population, std::uint32_t parents[], Population& offsprings, const Point* coordinates);
+    void crossover(const Population& population, std::uint32_t parents[], Population& offsprings, const DistanceMatrix& distances);
+    void mutate(Population& offsprings, const int RATE);
+    void mutate(Population& offsprings, const int RATE, const DistanceMatrix* distances);
+    void mutate(Population& offsprings, const int RATE, const int INVERSIONS, const DistanceMatrix* distances);
+    void mutate(Population& offsprings, const int RATE, const int INVERSIONS, const Point* coordinates);
+    void evaluateRange(Population& population, const std::size_t ui_first, const std::size_t ui_count, const DistanceMatrix& distances, const KernelIsa e_isa);
+    void crossoverRange(const Population& population, std::uint32_t parents[], Population& offsprings, const std::size_t ui_firstPair, const std::size_t ui_pairs,
+						const DistanceMatrix& distances, Xoshiro256& engine);
+    void mutateRange(Population& offsprings, const std::size_t ui_first, const std::size_t ui_count, const int RATE, const int INVERSIONS,
+					 const DistanceMatrix* distances, Xoshiro256& engine);
+    void generateComplement(const gene_t* trip1, gene_t* trip2, const std::size_t ui_cities);
 
-    std::size_t translateToIndex(const char c_city) noexcept;
+	template<typename Distance>
+	void evaluateWith(Population& population, const Distance& distances);
 
-    char translateToCity(const std::size_t ui_index) noexcept;
+	template<typename Distance>
+	void crossoverWith(const Population& population, std::uint32_t parents[], Population& offsprings, const Distance& distances);
 
-	float distanceV2(const Point& p1, const Point& p2);
+	template<typename State, typename Distance>
+	void crossoverPairs(const Population& population, const std::uint32_t parents[], Population& offsprings, const Distance& distances);
+
+	template<typename Distance>
+	void mutateWith(Population& offsprings, const int RATE, const int INVERSIONS, const Distance* distances);
+
+	template<typename Distance>
+	float edgesAt(const gene_t* genome, const std::size_t ui_cities, const std::size_t i, const std::size_t j, const Distance& distances);
+
+	template<typename Distance>
+	float boundaryEdges(const gene_t* genome, const std::size_t ui_cities, const std::size_t ui_first, const std::size_t ui_last, const Distance& distances);
+
+	template<typename State>
+	void crossoverPairRange(const Population& population, const std::uint32_t parents[], Population& offsprings, const std::size_t ui_firstPair,
+							const std::size_t ui_pairs, const DistanceMatrix& distances, Xoshiro256& engine);
+
+#pragma endregion
+
+
+#pragma region Mutation State:
+
+	// What mutating a range of offsprings drew and read, for the profiler.
+	struct MutationTally
+	{
+		std::uint64_t ui_draws = 0;   // random numbers drawn
+		std::uint64_t ui_retries = 0; // second cities drawn again because they equalled the first
+		std::uint64_t ui_lookups = 0; // distances read to update scores
+	}; // end struct MutationTally
+
+	template<typename Distance>
+	inline void mutateTour(Population& offsprings, const std::size_t ui_slot, const int RATE, const int INVERSIONS, const Distance* distances,
+						   Xoshiro256& engine, MutationTally& tally);
 
 #pragma endregion
 
@@ -64,184 +114,270 @@
 			#pragma omp critical(lookup_table)
 			{
 				result = distance(p1.x, p1.y, p2.x, p2.y);
+				PROFILE_COUNT(Counter::allocations, 1);
 				p2p_knownDistances[p1].insert(std::pair<Point, float>(p2, result));
 			} // end critical
 		} // end else
 		return result;
 	} // end method distanceV2
 
+#pragma endregion
 
-	/// <summary>
-	///          Translates an alpha-numeric city name (ABC...012...) to its corresponding index in the coordinates matrix.
-	/// </summary>
-	/// <param name="c_city">
-	///                    The alpha-numeric city name to translate.
-	/// </param>
-	/// <returns>
-	///          The index corresponding to <paramref name="c_city"/> in the coordinates matrix.
-	/// </returns>
-	inline std::size_t translateToIndex(const char c_city) noexcept
-	{
-		return (c_city >= 'A' ? static_cast<std::size_t>(c_city) - static_cast<std::size_t>('A') : static_cast<std::size_t>(c_city) - 22);
-	} // end method translateToIndex
-
-
-	/// <summary>
-	///         Translates an index in range [0,35] to its corresponding alpha-numeric city name (ABC...012...).
-	/// </summary>
-	/// <param name="ui_index">
-	///			The index to translate.
-	/// </param>
-	/// <returns>
-	///			The alpha-numeric city name corresponding to <paramref name="ui_index"/>.
-	/// </returns>
-	inline char translateToCity(const std::size_t ui_index) noexcept
-	{
-		return (ui_index <= 25 ? static_cast<char>(ui_index) + 'A' : static_cast<char>(ui_index - 26) + '0');
-	} // end method translateToCity
 
+#pragma region Population Implementations:
 
     /// <summary>
-    ///          Evaluates the length of the given <paramref name="trip"/> using the provided <paramref name="coordinates"/> for the cities.
-    ///          No value is returned, the value of <paramref name="trip"/>.fitness is set to the length of the trip.
+    ///          Evaluates the length of the tours in <paramref name="population"/> that are not scored through the memoized
+    ///          distances.
     /// </summary>
-    /// <param name="trip">
-    ///                    The trip to evaluate.
+    /// <param name="population">
+    ///                    The tours to evaluate.
     /// </param>
     /// <param name="coordinates">
     ///                           The coordinates of the cities to be used for determining distance between cities.
     /// </param>
-    /// <exception cref=""></exception>
-    void evaluate(Trip trip[CHROMOSOMES], const Point* coordinates)
+    void evaluate(Population& population, const Point* coordinates)
     {
-		static const Point start(0, 0);
+		evaluateWith(population, MemoDistance{coordinates, population.cities()});
+    } // end method evaluate
 
-		#pragma omp parallel for schedule(guided)
-        for (auto i = 0; i < CHROMOSOMES; i++)
-        {
-            auto& t = trip[i];
-            float d_tripLength = distanceV2(start, coordinates[translateToIndex(t.itinerary[0])]);
-            
-            for (auto j = 0; j < CITIES - 1; j++)
-            {
-                auto city_1 = translateToIndex(t.itinerary[j]);
-                auto city_2 = translateToIndex(t.itinerary[j+1]);
-
-                d_tripLength += distanceV2(coordinates[city_1], coordinates[city_2]);
-            } // end for j
-            
-            t.fitness = d_tripLength;
-        } // end for i
 
-        std::sort(trip, trip + CHROMOSOMES);
+    /// <summary>
+    ///          Evaluates the length of the tours in <paramref name="population"/> that are not scored with the batched
+    ///          <see cref="evaluateBatch"/> kernel. Each thread scores blocks of consecutive slots, a block with any stale tour
+    ///          in it is scored whole. Ordering is left to the ranking stage.
+    /// </summary>
+    /// <param name="population">
+    ///                    The tours to evaluate.
+    /// </param>
+    /// <param name="distances">
+    ///                    The distance table built from the city coordinates.
+    /// </param>
+    /// <param name="e_isa">
+    ///                    Instruction set of the kernel.
+    /// </param>
+    void evaluate(Population& population, const DistanceMatrix& distances, const KernelIsa e_isa)
+    {
+		const long long i_size = static_cast<long long>(population.size());
+		const long long i_blockSize = 1024;
+
+		#pragma omp parallel
+		{
+			PROFILE_THREAD(Stage::evaluate);
+
+			#pragma omp for schedule(static) nowait
+			for (long long i = 0; i < i_size; i += i_blockSize)
+			{
+				evaluateRange(population, static_cast<std::size_t>(i), static_cast<std::size_t>(std::min(i_blockSize, i_size - i)), distances, e_isa);
+			} // end for i
+		} // end parallel
     } // end method evaluate
 
 
     /// <summary>
-    ///          Generates <see cref="TOP_X"/> offsprings from the trips in <paramref name="parents"/> and stores them in
-    ///          <paramref name="offsprings"/>.
+    ///          Scores the <paramref name="ui_count"/> tours from slot <paramref name="ui_first"/> on as one batch if any of
+    ///          them is not scored; a block whose tours all kept their genomes keeps its fitness.
+    /// </summary>
+    void evaluateRange(Population& population, const std::size_t ui_first, const std::size_t ui_count, const DistanceMatrix& distances, const KernelIsa e_isa)
+    {
+		if (population.anyUnscored(ui_first, ui_count))
+		{
+			evaluateBatch(population.batch(ui_first, ui_count), distances, e_isa);
+			population.markScored(ui_first, ui_count);
+			PROFILE_COUNT(Counter::distanceLookups, ui_count * population.cities());
+		} // end if
+    } // end method evaluateRange
+
+
+    /// <summary>
+    ///          Evaluates the tours of <paramref name="population"/> that are not scored, reading distances from <paramref name="distances"/>.
+    /// </summary>
+    /// <typeparam name="Distance">
+    ///                     Any source providing operator()(from, to) and origin() over city indices.
+    /// </typeparam>
+    template<typename Distance>
+    void evaluateWith(Population& population, const Distance& distances)
+    {
+		const long long i_size = static_cast<long long>(population.size());
+		const std::size_t ui_cities = population.cities();
+		const std::size_t ui_origin = distances.origin();
+
+		#pragma omp parallel
+		{
+			PROFILE_THREAD(Stage::evaluate);
+			PROFILE_LOCAL(ui_lookups);
+
+			#pragma omp for schedule(guided) nowait
+			for (long long i = 0; i < i_size; i++)
+			{
+				if (population.scored(static_cast<std::size_t>(i)))
+				{
+					continue;
+				} // end if
+
+				const gene_t* genome = population.genome(static_cast<std::size_t>(i));
+				float d_tripLength = distances(ui_origin, genome[0]);
+
+				for (std::size_t j = 0; j + 1 < ui_cities; j++)
+				{
+					d_tripLength += distances(genome[j], genome[j+1]);
+				} // end for j
+
+				population.score(static_cast<std::size_t>(i), d_tripLength);
+				PROFILE_TALLY(ui_lookups, ui_cities);
+			} // end for i
+
+			PROFILE_COUNT(Counter::distanceLookups, ui_lookups);
+		} // end parallel
+    } // end template evaluateWith
+
+
+    /// <summary>
+    ///          Generates offsprings.size() offsprings from the selected <paramref name="parents"/> through the memoized distances.
+    ///          See <see cref="crossoverWith"/>.
     /// </summary>
+    void crossover(const Population& population, std::uint32_t parents[], Population& offsprings, const Point* coordinates)
+    {
+		crossoverWith(population, parents, offsprings, MemoDistance{coordinates, population.cities()});
+    } // end method crossover
+
+
+    /// <summary>
+    ///          Generates offsprings.size() offsprings from the selected <paramref name="parents"/> through the precomputed
+    ///          <paramref name="distances"/>. See <see cref="crossoverWith"/>.
+    /// </summary>
+    void crossover(const Population& population, std::uint32_t parents[], Population& offsprings, const DistanceMatrix& distances)
+    {
+		crossoverWith(population, parents, offsprings, distances);
+    } // end method crossover
+
+
+    /// <summary>
+    ///          Greedy-edge crossover on the structure-of-arrays layout. Parents are given as slots of <paramref name="population"/>,
+    ///          so pairing them only shuffles the slot array; no genome is copied before the children are written.
+    /// </summary>
+    /// <typeparam name="Distance">
+    ///                     Any source providing operator()(from, to) over city indices.
+    /// </typeparam>
+    /// <param name="population">
+    ///                       The population the parents were selected from.
+    /// </param>
     /// <param name="parents">
-    ///                       The selected parents that will reproduce into <see cref="TOP_X"/> offspring.
+    ///                       offsprings.size() slots of selected parents, shuffled in place.
     /// </param>
     /// <param name="offsprings">
-    ///                          Output parameter for generates offsprings.
+    ///                          Output parameter for generated offsprings.
     /// </param>
-    /// <param name="coordinates">
-    ///                           The coordinates of the cities to be used for determining distance between cities.
+    /// <param name="distances">
+    ///                    The distance source to use.
     /// </param>
-    void crossover(Trip parents[TOP_X], Trip offsprings[TOP_X], const Point* coordinates)
-    {       
-		char* c_a_visited = nullptr;
+    template<typename Distance>
+    void crossoverWith(const Population& population, std::uint32_t parents[], Population& offsprings, const Distance& distances)
+    {
+		// shuffle parent pool to increase diversity of children
+		std::shuffle(parents, parents + offsprings.size(), localEngine());
+		PROFILE_COUNT(Counter::rngDraws, offsprings.size() > 0 ? offsprings.size() - 1 : 0);
 
-		static std::random_device rd{};
-		static std::mt19937 engine{ rd() };
+		// small instances get the one-word visited set
+		if (population.cities() <= CROSSOVER_WORD_CITIES)
+		{
+			crossoverPairs<WordCrossoverState>(population, parents, offsprings, distances);
+		} // end if
+		else
+		{
+			crossoverPairs<BitsetCrossoverState>(population, parents, offsprings, distances);
+		} // end else
+    } // end template crossoverWith
 
-		// shuffle parent pool to increase diversity of children
-		std::shuffle(parents, parents + TOP_X, engine);
 
-        // iterate over all pairs of parents
-		#pragma omp parallel for private(c_a_visited) schedule(guided)
-		for (auto i = 0; i < TOP_X ; i+= 2)
-        {
-			// keep track of visited cities with a binary array
-			c_a_visited = new char[CITIES];
-            memset(c_a_visited, '0', static_cast<std::size_t>(CITIES));
-
-            // temp pointers for easy access of parents and children
-            auto& p1 = parents[i];
-            auto& p2 = parents[i+1];
-            auto& c1 = offsprings[i];
-            auto& c2 = offsprings[i+1];
-
-            // source city of the trip from parent 1
-            c1.itinerary[0] = p1.itinerary[0];
-            c1.itinerary[CITIES] = static_cast<char>(NULL);
-
-            // mark first city as visited
-            c_a_visited[translateToIndex(p1.itinerary[0])] = '1';
-            
-			// generate child chromosome
-            for (auto j = 1; j < CITIES; j++)
-            {
-                auto ui_index_p1 = translateToIndex(p1.itinerary[j]);
-                auto ui_index_p2 = translateToIndex(p2.itinerary[j]);
-
-                // next city for both parents has already been visited
-                if (c_a_visited[ui_index_p1] != '0' && c_a_visited[ui_index_p2] != '0')
-                {
-					// pick random city
-                    auto ui_picked = randomIntInRange<std::size_t>(0,CITIES-1);
-
-					// ensure we've never been to this city before
-                    while(c_a_visited[ui_picked] != '0')
-                    {
-                        ui_picked = randomIntInRange<std::size_t>(0,CITIES-1);
-                    } // end while
-
-                    c_a_visited[ui_picked] = '1';
-                    c1.itinerary[j] = translateToCity(ui_picked);
-                } // end if
-                else // at least one of the candidate cities has not been visited
-                { 
-					// get distance to each candidate city
-                    auto ui_index_source = translateToIndex(c1.itinerary[j-1]);
-                    auto f_source_p1 = distanceV2(coordinates[ui_index_source], coordinates[ui_index_p1]);
-                    auto f_source_p2 = distanceV2(coordinates[ui_index_source], coordinates[ui_index_p2]);
-                    
-                    if (f_source_p1 < f_source_p2) 
-                    {
-                        if (c_a_visited[ui_index_p1] == '0') // p1 is closer and available
-                        {
-                            c_a_visited[ui_index_p1] = '1';
-                            c1.itinerary[j] = p1.itinerary[j];
-                        } // end if
-                        else // p1 is closer but unavailable
-                        {
-                            c_a_visited[ui_index_p2] = '1';
-                            c1.itinerary[j] = p2.itinerary[j];
-                        } // end else
-                    } // end if
-                    else
-                    {
-                        if (c_a_visited[ui_index_p2] == '0') // p2 is closer and available
-                        {
-                            c_a_visited[ui_index_p2] = '1';
-                            c1.itinerary[j] = p2.itinerary[j];
-                        } // end if
-                        else // p2 is closer but unavailable
-                        {
-                            c_a_visited[ui_index_p1] = '1';
-                            c1.itinerary[j] = p1.itinerary[j];
-                        } // end else
-                    } // end else
-                } // end else
-            } // end for j
-			delete[] c_a_visited;
-
-            generateComplement(c1.itinerary, c2.itinerary);
-        } // end for i
-    } // end method crossover
+    /// <summary>
+    ///          Crosses the shuffled <paramref name="parents"/> pairwise, each pair yielding a child and its complement.
+    /// </summary>
+    /// <typeparam name="State">
+    ///                     Scratch space of <see cref="crossoverChild"/>, <see cref="WordCrossoverState"/> or <see cref="BitsetCrossoverState"/>.
+    /// </typeparam>
+    /// <typeparam name="Distance">
+    ///                     Any source providing operator()(from, to) over city indices.
+    /// </typeparam>
+    template<typename State, typename Distance>
+    void crossoverPairs(const Population& population, const std::uint32_t parents[], Population& offsprings, const Distance& distances)
+    {
+		const long long i_pairs = static_cast<long long>(offsprings.size() / 2);
+		const std::size_t ui_cities = population.cities();
+
+		#pragma omp parallel
+		{
+			PROFILE_THREAD(Stage::crossover);
+
+			thread_local State state;     // this thread's scratch space, sized once for the instance
+			Xoshiro256& engine = localEngine();
+
+			#pragma omp for schedule(static) nowait
+			for (long long i = 0; i < i_pairs; i++)
+			{
+				gene_t* c1 = offsprings.genome(static_cast<std::size_t>(2 * i));
+
+				crossoverChild(population.genome(parents[2 * i]), population.genome(parents[2 * i + 1]), c1, ui_cities, distances, engine, state);
+				generateComplement(c1, offsprings.genome(static_cast<std::size_t>(2 * i + 1)), ui_cities);
+				offsprings.invalidate(static_cast<std::size_t>(2 * i));
+				offsprings.invalidate(static_cast<std::size_t>(2 * i + 1));
+			} // end for i
+
+			PROFILE_COUNT(Counter::distanceLookups, state.ui_lookups);
+			PROFILE_COUNT(Counter::rngDraws, state.ui_draws);
+			state.ui_lookups = 0;
+			state.ui_draws = 0;
+		} // end parallel
+    } // end template crossoverPairs
+
+
+    /// <summary>
+    ///          Crossover of the <paramref name="ui_pairs"/> parent pairs from pair <paramref name="ui_firstPair"/> on, on the
+    ///          calling thread: shuffles just those parents and writes the children into the matching offspring slots, drawing
+    ///          from <paramref name="engine"/>. Ranges that do not overlap can be crossed at the same time.
+    /// </summary>
+    void crossoverRange(const Population& population, std::uint32_t parents[], Population& offsprings, const std::size_t ui_firstPair, const std::size_t ui_pairs,
+						const DistanceMatrix& distances, Xoshiro256& engine)
+    {
+		std::shuffle(parents + 2 * ui_firstPair, parents + 2 * (ui_firstPair + ui_pairs), engine);
+		PROFILE_COUNT(Counter::rngDraws, ui_pairs > 0 ? 2 * ui_pairs - 1 : 0);
+
+		if (population.cities() <= CROSSOVER_WORD_CITIES)
+		{
+			crossoverPairRange<WordCrossoverState>(population, parents, offsprings, ui_firstPair, ui_pairs, distances, engine);
+		} // end if
+		else
+		{
+			crossoverPairRange<BitsetCrossoverState>(population, parents, offsprings, ui_firstPair, ui_pairs, distances, engine);
+		} // end else
+    } // end method crossoverRange
+
+
+    /// <summary>
+    ///          Crosses the pairs of <see cref="crossoverRange"/> with the calling thread's scratch space.
+    /// </summary>
+    template<typename State>
+    void crossoverPairRange(const Population& population, const std::uint32_t parents[], Population& offsprings, const std::size_t ui_firstPair,
+							const std::size_t ui_pairs, const DistanceMatrix& distances, Xoshiro256& engine)
+    {
+		thread_local State state;     // this thread's scratch space, sized once for the instance
+		const std::size_t ui_cities = population.cities();
+
+		for (std::size_t i = ui_firstPair; i < ui_firstPair + ui_pairs; i++)
+		{
+			gene_t* c1 = offsprings.genome(2 * i);
+
+			crossoverChild(population.genome(parents[2 * i]), population.genome(parents[2 * i + 1]), c1, ui_cities, distances, engine, state);
+			generateComplement(c1, offsprings.genome(2 * i + 1), ui_cities);
+			offsprings.invalidate(2 * i);
+			offsprings.invalidate(2 * i + 1);
+		} // end for i
+
+		PROFILE_COUNT(Counter::distanceLookups, state.ui_lookups);
+		PROFILE_COUNT(Counter::rngDraws, state.ui_draws);
+		state.ui_lookups = 0;
+		state.ui_draws = 0;
+    } // end template crossoverPairRange
 
 
 	/// <summary>
@@ -253,49 +389,245 @@
 	/// <param name="trip2">
 	///         Child to be created as complement of <paramref name="trip1"/>.
 	/// </param>
-    void generateComplement(const char* trip1, char* trip2)
+	/// <param name="ui_cities">
+	///         Number of cities per trip.
+	/// </param>
+    void generateComplement(const gene_t* trip1, gene_t* trip2, const std::size_t ui_cities)
     {
-        for (auto i = 0; i < CITIES; i++)
+        for (std::size_t i = 0; i < ui_cities; i++)
         {
-			std::size_t temp = translateToIndex(trip1[i]);
-			trip2[i] = translateToCity(CITIES - 1 - temp);
+			trip2[i] = static_cast<gene_t>(ui_cities - 1 - trip1[i]);
         } // end for i
     } // end method generateComplement
 
 
     /// <summary>
-    ///          Generates a random mutation in all given <paramref name="offsprings"/> by swapping two random cities in a trip. 
-    ///          Mutation may or may not occur for each offspring, this is determined by <see cref="MUTATE_RATE"/>.
+    ///          Generates a random mutation in all given <paramref name="offsprings"/> by swapping two random cities in a trip.
+    ///          Mutated tours lose their score.
     /// </summary>
     /// <param name="offsprings">
-    ///          The offsprings that should be mutated. Mutations are applied directly to the objects in this array.
+    ///          The offsprings that should be mutated. Mutations are applied directly to their genomes.
     /// </param>
 	/// <param name="RATE">
 	///          The mutation rate to use for determining whether mutation occurs or not.
 	/// </param>
-    void mutate(Trip offsprings[TOP_X], const int RATE)
+    void mutate(Population& offsprings, const int RATE)
     {
-		#pragma omp parallel for schedule(guided)
-        for (auto cur = 0; cur < TOP_X; cur++)
-        {
-            if (randomIntInRange<int>(0,100) <= RATE)
-            {
-                // pick two random cities
-                auto i = randomIntInRange<std::size_t>(0, CITIES-1);
-                auto j = randomIntInRange<std::size_t>(0, CITIES-1);
-
-                while ( i == j)
-                {
-                    j = randomIntInRange<std::size_t>(0, CITIES-1);
-                } // end while
-
-				std::swap(offsprings[cur].itinerary[i], offsprings[cur].itinerary[j]);
-            } // end if
-        } // end for
+		mutate(offsprings, RATE, nullptr);
     } // end method mutate
 
-#pragma endregion
+
+    /// <summary>
+    ///          Generates a random mutation in all given <paramref name="offsprings"/> by swapping two random cities in a trip.
+    ///          A scored tour keeps its score: only the up to four edges touching the swapped cities change, so their
+    ///          difference is added to it.
+    /// </summary>
+    /// <param name="offsprings">
+    ///          The offsprings that should be mutated. Mutations are applied directly to their genomes.
+    /// </param>
+	/// <param name="RATE">
+	///          The mutation rate to use for determining whether mutation occurs or not.
+	/// </param>
+	/// <param name="distances">
+	///          The distance table to update scores from, null to have mutated tours evaluated again.
+	/// </param>
+    void mutate(Population& offsprings, const int RATE, const DistanceMatrix* distances)
+    {
+		mutate(offsprings, RATE, 0, distances);
+    } // end method mutate
+
+
+    /// <summary>
+    ///          Mutates <paramref name="offsprings"/> with a mix of two operators on two random positions: swapping their
+    ///          cities, or reversing the segment between them. A reversal only replaces the two edges at the ends of the
+    ///          segment, the smaller step; both keep a scored tour's score up to date like the swap-only overload. With
+    ///          no inversions the random draws are exactly those of the swap-only overload.
+    /// </summary>
+    /// <param name="offsprings">
+    ///          The offsprings that should be mutated. Mutations are applied directly to their genomes.
+    /// </param>
+	/// <param name="RATE">
+	///          The mutation rate to use for determining whether mutation occurs or not.
+	/// </param>
+	/// <param name="INVERSIONS">
+	///          % of the mutations that reverse a segment instead of swapping.
+	/// </param>
+	/// <param name="distances">
+	///          The distance table to update scores from, null to have mutated tours evaluated again.
+	/// </param>
+    void mutate(Population& offsprings, const int RATE, const int INVERSIONS, const DistanceMatrix* distances)
+    {
+		mutateWith(offsprings, RATE, INVERSIONS, distances);
+    } // end method mutate
+
+
+    /// <summary>
+    ///          Mutates <paramref name="offsprings"/> like the overload above, updating scores from the memoized distanceV2
+    ///          lookup of <paramref name="coordinates"/> instead of the distance table.
+    /// </summary>
+	/// <param name="coordinates">
+	///          The coordinates of the cities, null to have mutated tours evaluated again.
+	/// </param>
+    void mutate(Population& offsprings, const int RATE, const int INVERSIONS, const Point* coordinates)
+    {
+		const MemoDistance memo{coordinates, offsprings.cities()};
+
+		mutateWith(offsprings, RATE, INVERSIONS, coordinates != nullptr ? &memo : nullptr);
+    } // end method mutate
 
 
+    /// <summary>
+    ///          Mutation over any distance source, see <see cref="mutate"/>.
+    /// </summary>
+    /// <typeparam name="Distance">
+    ///                     Any source providing operator()(from, to) and origin() over city indices.
+    /// </typeparam>
+    template<typename Distance>
+    void mutateWith(Population& offsprings, const int RATE, const int INVERSIONS, const Distance* distances)
+    {
+		const long long i_size = static_cast<long long>(offsprings.size());
+
+		#pragma omp parallel
+		{
+			PROFILE_THREAD(Stage::mutate);
+
+			MutationTally tally;
+			Xoshiro256& engine = localEngine();
+
+			#pragma omp for schedule(static) nowait
+			for (long long cur = 0; cur < i_size; cur++)
+			{
+				mutateTour(offsprings, static_cast<std::size_t>(cur), RATE, INVERSIONS, distances, engine, tally);
+			} // end for
+
+			PROFILE_COUNT(Counter::rngDraws, tally.ui_draws);
+			PROFILE_COUNT(Counter::rejectionRetries, tally.ui_retries);
+			PROFILE_COUNT(Counter::distanceLookups, tally.ui_lookups);
+		} // end parallel
+    } // end template mutateWith
+
+
+    /// <summary>
+    ///          Mutates the <paramref name="ui_count"/> offsprings from slot <paramref name="ui_first"/> on like
+    ///          <see cref="mutate"/>, drawing from <paramref name="engine"/> instead of the calling thread's engine.
+    /// </summary>
+    void mutateRange(Population& offsprings, const std::size_t ui_first, const std::size_t ui_count, const int RATE, const int INVERSIONS,
+					 const DistanceMatrix* distances, Xoshiro256& engine)
+    {
+		MutationTally tally;
+
+		for (std::size_t i = ui_first; i < ui_first + ui_count; i++)
+		{
+			mutateTour(offsprings, i, RATE, INVERSIONS, distances, engine, tally);
+		} // end for i
+
+		PROFILE_COUNT(Counter::rngDraws, tally.ui_draws);
+		PROFILE_COUNT(Counter::rejectionRetries, tally.ui_retries);
+		PROFILE_COUNT(Counter::distanceLookups, tally.ui_lookups);
+    } // end method mutateRange
+
+
+    /// <summary>
+    ///          Decides whether the offspring in <paramref name="ui_slot"/> mutates and applies the swap or reversal.
+    /// </summary>
+    /// <param name="engine">
+    ///          Engine of every draw, the calling thread's in <see cref="mutate"/>.
+    /// </param>
+    /// <param name="tally">
+    ///          Draws, retries and lookups for the profiler.
+    /// </param>
+    template<typename Distance>
+    inline void mutateTour(Population& offsprings, const std::size_t ui_slot, const int RATE, const int INVERSIONS, const Distance* distances,
+						   Xoshiro256& engine, MutationTally& tally)
+    {
+		const std::size_t ui_cities = offsprings.cities();
+
+		PROFILE_TALLY(tally.ui_draws, 1);
 
+		if (static_cast<int>(randomBelow(engine, 101)) <= RATE)
+		{
+			// pick two random cities
+			auto i = static_cast<std::size_t>(randomBelow(engine, ui_cities));
+			auto j = static_cast<std::size_t>(randomBelow(engine, ui_cities));
+
+			PROFILE_TALLY(tally.ui_draws, 2);
+
+			while ( i == j)
+			{
+				j = static_cast<std::size_t>(randomBelow(engine, ui_cities));
+				PROFILE_TALLY(tally.ui_draws, 1);
+				PROFILE_TALLY(tally.ui_retries, 1);
+			} // end while
 
+			gene_t* genome = offsprings.genome(ui_slot);
+
+			if (INVERSIONS > 0 && static_cast<int>(randomBelow(engine, 100)) < INVERSIONS)
+			{
+				const std::size_t ui_first = std::min(i, j);
+				const std::size_t ui_last = std::max(i, j);
+
+				PROFILE_TALLY(tally.ui_draws, 1);
+
+				if (distances != nullptr && offsprings.scored(ui_slot))
+				{
+					const float f_before = boundaryEdges(genome, ui_cities, ui_first, ui_last, *distances);
+
+					std::reverse(genome + ui_first, genome + ui_last + 1);
+					offsprings.score(ui_slot, offsprings.fitness(ui_slot) + boundaryEdges(genome, ui_cities, ui_first, ui_last, *distances) - f_before);
+					PROFILE_TALLY(tally.ui_lookups, 4);
+				} // end if
+				else
+				{
+					std::reverse(genome + ui_first, genome + ui_last + 1);
+					offsprings.invalidate(ui_slot);
+				} // end else
+			} // end if
+			else if (distances != nullptr && offsprings.scored(ui_slot))
+			{
+				const float f_before = edgesAt(genome, ui_cities, i, j, *distances);
+
+				std::swap(genome[i], genome[j]);
+				offsprings.score(ui_slot, offsprings.fitness(ui_slot) + edgesAt(genome, ui_cities, i, j, *distances) - f_before);
+				PROFILE_TALLY(tally.ui_lookups, 8);
+			} // end elif
+			else
+			{
+				std::swap(genome[i], genome[j]);
+				offsprings.invalidate(ui_slot);
+			} // end else
+		} // end if
+    } // end template mutateTour
+
+
+    /// <summary>
+    ///          Length of the edges entering and leaving positions <paramref name="i"/> and <paramref name="j"/> of a tour that
+    ///          starts at the origin. When the positions are adjacent their shared edge is counted twice, which cancels out
+    ///          in the difference mutate takes since distances are symmetric.
+    /// </summary>
+    template<typename Distance>
+    float edgesAt(const gene_t* genome, const std::size_t ui_cities, const std::size_t i, const std::size_t j, const Distance& distances)
+    {
+		float f_length = 0.0f;
+
+		for (const std::size_t k : { i, j })
+		{
+			f_length += distances(k > 0 ? genome[k - 1] : distances.origin(), genome[k]);
+			f_length += (k + 1 < ui_cities ? distances(genome[k], genome[k + 1]) : 0.0f);
+		} // end for k
+
+		return f_length;
+    } // end template edgesAt
+
+
+    /// <summary>
+    ///          Length of the edge entering position <paramref name="ui_first"/> and the one leaving <paramref name="ui_last"/>
+    ///          of a tour that starts at the origin, the two edges reversing the segment between them replaces.
+    /// </summary>
+    template<typename Distance>
+    float boundaryEdges(const gene_t* genome, const std::size_t ui_cities, const std::size_t ui_first, const std::size_t ui_last, const Distance& distances)
+    {
+		return distances(ui_first > 0 ? genome[ui_first - 1] : distances.origin(), genome[ui_first])
+			   + (ui_last + 1 < ui_cities ? distances(genome[ui_last], genome[ui_last + 1]) : 0.0f);
+    } // end template boundaryEdges
+
+#pragma endregion
@@ -0,0 +1,301 @@
+#pragma region Includes:
+
+	#include "EventLog.h"   // EventLog, LogEvent, LogFormat
+	#include "Affinity.h"   // unpinThread
+	#include "Instance.h"   // formatTour
+	#include "Stopping.h"   // StopReason, stopReasonName
+	#include <algorithm>    // std::copy, std::min
+	#include <chrono>       // std::chrono::microseconds
+	#include <iostream>     // cout
+	#include <stdexcept>    // std::runtime_error
+	#include <string.h>     // strcmp
+
+#pragma endregion
+
+
+#pragma region Helpers:
+
+	/// <summary>
+	///          Microseconds from <paramref name="from"/> to <paramref name="to"/>.
+	/// </summary>
+	static inline std::int64_t microseconds(const timePoint from, const timePoint to) noexcept
+	{
+		return static_cast<std::int64_t>(std::chrono::duration_cast<std::chrono::microseconds>(to - from).count());
+	} // end method microseconds
+
+
+	/// <summary>
+	///          Ring slots for tours of <paramref name="ui_cities"/> genes: the largest power of two up to LOG_RING_EVENTS
+	///          whose tours fit into LOG_RING_BYTES, but at least 8.
+	/// </summary>
+	static std::size_t ringSlots(const std::size_t ui_cities) noexcept
+	{
+		const std::size_t ui_fit = LOG_RING_BYTES / (std::max<std::size_t>(ui_cities, 1) * sizeof(gene_t));
+		std::size_t ui_slots = 8;
+
+		while (ui_slots * 2 <= LOG_RING_EVENTS && ui_slots * 2 <= ui_fit)
+		{
+			ui_slots *= 2;
+		} // end while
+
+		return ui_slots;
+	} // end method ringSlots
+
+#pragma endregion
+
+
+#pragma region Implementations:
+
+	/// <summary>
+	///          Opens the event stream and starts its writer.
+	/// </summary>
+	/// <param name="s_path">
+	///          File of the JSON and binary sinks, empty for LOG_JSON_FILE or LOG_BINARY_FILE; the text sink ignores it.
+	/// </param>
+	/// <param name="out_file">
+	///          Output file the text sink writes to, besides the console.
+	/// </param>
+	/// <exception cref="std::runtime_error">Thrown if the log file cannot be opened.</exception>
+	EventLog::EventLog(const LogFormat e_format, const std::string& s_path, const std::size_t ui_cities, std::ofstream& out_file)
+		: e_format(e_format), s_path(s_path), ui_cities(ui_cities), ui_mask(ringSlots(ui_cities) - 1), events(ui_mask + 1),
+		  g_v_tours((ui_mask + 1) * ui_cities), p_outFile(&out_file), start(highRes_Clock::now()), lap(start), i_posted(0), i_dropped(0),
+		  ui_head(0), ui_tail(0), b_quit(false)
+	{
+		if (e_format != LogFormat::text)
+		{
+			this->s_path = (s_path.empty() ? (e_format == LogFormat::json ? LOG_JSON_FILE : LOG_BINARY_FILE) : s_path);
+			log_file.open(this->s_path, std::ios::out | std::ios::trunc | (e_format == LogFormat::binary ? std::ios::binary : std::ios::out));
+
+			if (!log_file.is_open())
+			{
+				throw std::runtime_error("cannot open " + this->s_path);
+			} // end if
+		} // end if
+
+		if (e_format == LogFormat::binary)
+		{
+			const EventHeader header = { { 'T', 'S', 'P', 'L' }, EVENT_LOG_VERSION, static_cast<std::uint32_t>(ui_cities), 0 };
+
+			log_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		} // end if
+
+		worker = std::thread(&EventLog::work, this);
+	} // end constructor
+
+
+	EventLog::~EventLog(void)
+	{
+		if (worker.joinable())
+		{
+			b_quit.store(true, std::memory_order_release);
+			worker.join();
+		} // end if
+	} // end destructor
+
+
+	/// <summary>
+	///          Hands an event to the writer without waiting for it.
+	/// </summary>
+	/// <param name="tour">
+	///          ui_cities genes of an improved event, null otherwise.
+	/// </param>
+	/// <returns>
+	///          false if the ring was full and the event was dropped
+	/// </returns>
+	bool EventLog::post(const EventKind e_kind, const int i_generation, const float f_shortest, const gene_t* tour, const std::uint32_t ui_detail) noexcept
+	{
+		const std::size_t ui_slot = ui_tail.load(std::memory_order_relaxed);
+		const timePoint now = highRes_Clock::now();
+
+		if (ui_slot - ui_head.load(std::memory_order_acquire) > ui_mask)
+		{
+			i_dropped++;
+			return false;
+		} // end if
+
+		LogEvent& event = events[ui_slot & ui_mask];
+
+		event.ui_kind = static_cast<std::uint32_t>(e_kind);
+		event.i_generation = i_generation;
+		event.f_shortest = f_shortest;
+		event.ui_cities = (tour != nullptr ? static_cast<std::uint32_t>(ui_cities) : 0);
+		event.ui_detail = ui_detail;
+		event.ui_reserved = 0;
+		event.i_elapsed = microseconds(start, now);
+		event.i_lap = 0;
+
+		if (e_kind == EventKind::generation)
+		{
+			event.i_lap = microseconds(lap, now);
+			lap = now;
+		} // end if
+
+		if (tour != nullptr)
+		{
+			std::copy(tour, tour + ui_cities, g_v_tours.data() + (ui_slot & ui_mask) * ui_cities);
+		} // end if
+
+		ui_tail.store(ui_slot + 1, std::memory_order_release);
+		i_posted++;
+
+		return true;
+	} // end method post
+
+
+	/// <summary>
+	///          Waits until the writer has written every posted event and stops it.
+	/// </summary>
+	/// <exception cref="std::runtime_error">Thrown if the log file could not be written.</exception>
+	void EventLog::finish(void)
+	{
+		b_quit.store(true, std::memory_order_release);
+		worker.join();
+
+		if (e_format != LogFormat::text && !log_file)
+		{
+			throw std::runtime_error("cannot write " + s_path);
+		} // end if
+	} // end method finish
+
+
+	/// <summary>
+	///          Body of the writer thread: drains the ring, flushes the sink whenever it caught up, and sleeps while there
+	///          is nothing to write, until told to quit with the ring empty.
+	/// </summary>
+	void EventLog::work(void)
+	{
+		bool b_dirty = false;
+
+		// started from the GA's thread 0, the writer must not share its CPU when the team is pinned
+		unpinThread();
+
+		for (;;)
+		{
+			const bool b_quitting = b_quit.load(std::memory_order_acquire);
+			const std::size_t ui_slot = ui_head.load(std::memory_order_relaxed);
+
+			if (ui_slot != ui_tail.load(std::memory_order_acquire))
+			{
+				write(events[ui_slot & ui_mask], g_v_tours.data() + (ui_slot & ui_mask) * ui_cities);
+				ui_head.store(ui_slot + 1, std::memory_order_release);
+				b_dirty = true;
+				continue;
+			} // end if
+
+			if (b_dirty)
+			{
+				#if ENABLE_STD_OUT
+					std::cout.flush();
+				#endif
+				(e_format == LogFormat::text ? static_cast<std::ostream&>(*p_outFile) : log_file).flush();
+				b_dirty = false;
+			} // end if
+
+			// the ring was empty after the quit flag was seen, so nothing posted before it is left
+			if (b_quitting)
+			{
+				return;
+			} // end if
+
+			std::this_thread::sleep_for(std::chrono::microseconds(LOG_DRAIN_US));
+		} // end for
+	} // end method work
+
+
+	/// <summary>
+	///          Writes one event to the sink, without flushing.
+	/// </summary>
+	void EventLog::write(const LogEvent& event, const gene_t* tour)
+	{
+		const EventKind e_kind = static_cast<EventKind>(event.ui_kind);
+
+		switch (e_format)
+		{
+			case LogFormat::text:
+				// the classic progress lines: a banner every 20 generations and every new shortest tour
+				if (e_kind == EventKind::generation && event.i_generation % 20 == 0)
+				{
+					std::cout << "generation: " << event.i_generation << '\n';
+				} // end if
+				else if (e_kind == EventKind::improved)
+				{
+					const std::string s_tour = formatTour(tour, ui_cities);
+
+					#if ENABLE_STD_OUT
+						std::cout << "generation: " << event.i_generation << " shortest distance = " << event.f_shortest << "\t itinerary = " << s_tour << '\n';
+					#endif
+					*p_outFile << "generation: " << event.i_generation << " shortest distance = " << event.f_shortest << "\t itinerary = " << s_tour << '\n';
+				} // end elif
+				break;
+
+			case LogFormat::json:
+				log_file << "{\"event\":\"" << (e_kind == EventKind::generation ? "generation" : e_kind == EventKind::improved ? "improved" : "finished")
+						 << "\",\"generation\":" << event.i_generation << ",\"shortest\":" << event.f_shortest << ",\"elapsed_us\":" << event.i_elapsed;
+
+				if (e_kind == EventKind::generation)
+				{
+					log_file << ",\"lap_us\":" << event.i_lap;
+				} // end if
+				else if (e_kind == EventKind::improved)
+				{
+					log_file << ",\"tour\":\"" << formatTour(tour, ui_cities) << '"';
+				} // end elif
+				else
+				{
+					log_file << ",\"stop\":\"" << stopReasonName(static_cast<StopReason>(event.ui_detail)) << '"';
+				} // end else
+
+				log_file << "}\n";
+				break;
+
+			default:
+				log_file.write(reinterpret_cast<const char*>(&event), sizeof(event));
+				log_file.write(reinterpret_cast<const char*>(tour), event.ui_cities * sizeof(gene_t));
+				break;
+		} // end switch
+	} // end method write
+
+
+	/// <summary>
+	///          Name of a log format as given on the command line.
+	/// </summary>
+	const char* logFormatName(const LogFormat e_format) noexcept
+	{
+		switch (e_format)
+		{
+			case LogFormat::json:   return "json";
+			case LogFormat::binary: return "binary";
+			default:                return "text";
+		} // end switch
+	} // end method logFormatName
+
+
+	/// <summary>
+	///          Parses a log format name.
+	/// </summary>
+	/// <param name="name">
+	///          One of text, json or binary.
+	/// </param>
+	/// <param name="e_format">
+	///          Output parameter for the parsed format.
+	/// </param>
+	/// <returns>
+	///          true if <paramref name="name"/> is a known format
+	/// </returns>
+	bool parseLogFormat(const char* name, LogFormat& e_format) noexcept
+	{
+		const LogFormat e_a_all[] = { LogFormat::text, LogFormat::json, LogFormat::binary };
+
+		for (const LogFormat e_candidate : e_a_all)
+		{
+			if (strcmp(name, logFormatName(e_candidate)) == 0)
+			{
+				e_format = e_candidate;
+				return true;
+			} // end if
+		} // end for
+
+		return false;
+	} // end method parseLogFormat
+
+#pragma endregion
@@ -0,0 +1,133 @@
+#ifndef _EVENT_LOG_H_
+#define _EVENT_LOG_H_
+
+#pragma region Includes:
+
+	#include <atomic>       // std::atomic
+	#include <cstddef>      // std::size_t
+	#include <cstdint>      // fixed width integers
+	#include <fstream>      // std::ofstream
+	#include <string>       // std::string
+	#include <thread>       // std::thread
+	#include <vector>       // std::vector
+	#include "Population.h" // gene_t
+	#include "utility.hpp"  // timePoint, CACHE_LINE_SIZE
+
+#pragma endregion
+
+
+#pragma region Defines:
+
+	#define EVENT_LOG_VERSION    1                 // version of the binary stream's header and records
+
+	#ifndef LOG_RING_EVENTS
+		#define LOG_RING_EVENTS  1024              // events the ring holds at most, a power of two
+	#endif
+	#ifndef LOG_RING_BYTES
+		#define LOG_RING_BYTES   (4u << 20)        // bytes of tours the ring may hold, fewer events for large instances
+	#endif
+	#ifndef LOG_DRAIN_US
+		#define LOG_DRAIN_US     1000              // us the writer sleeps while the ring is empty
+	#endif
+
+	#define LOG_JSON_FILE        "progress.jsonl"  // JSON lines stream unless --log-file says otherwise
+	#define LOG_BINARY_FILE      "progress.bin"    // binary stream unless --log-file says otherwise
+
+#pragma endregion
+
+
+// Where and how the progress events of a run are written.
+enum class LogFormat
+{
+	text,   // the classic progress lines on the console and in the output file
+	json,   // one JSON object per event in the log file
+	binary  // EventHeader and LogEvent records in the log file
+}; // end enum LogFormat
+
+
+// What a progress event reports.
+enum class EventKind : std::uint32_t
+{
+	generation = 1, // a generation ended
+	improved   = 2, // a shorter tour was found, its genes follow
+	finished   = 3  // the run ended after i_generation generations, ui_detail holds the StopReason
+}; // end enum EventKind
+
+
+// Header of a binary event stream, 16 bytes.
+struct EventHeader
+{
+	char          c_a_magic[4];  // "TSPL"
+	std::uint32_t ui_version;    // EVENT_LOG_VERSION
+	std::uint32_t ui_cities;     // genes behind every improved record
+	std::uint32_t ui_reserved;   // 0
+}; // end struct EventHeader
+
+
+// A progress event, also the record of the binary stream; 40 bytes, followed by ui_cities genes if improved.
+struct LogEvent
+{
+	std::uint32_t ui_kind;       // EventKind
+	std::int32_t  i_generation;  // generation the event belongs to
+	float         f_shortest;    // shortest tour length so far
+	std::uint32_t ui_cities;     // genes following the record, 0 unless improved
+	std::uint32_t ui_detail;     // StopReason of a finished event, 0 otherwise
+	std::uint32_t ui_reserved;   // 0
+	std::int64_t  i_elapsed;     // us since the log was opened
+	std::int64_t  i_lap;         // us since the previous generation event
+}; // end struct LogEvent
+
+
+// Progress event stream of a run.
+//
+// The GA posts events into a single-producer ring and never waits: the ring's slots, including one tour per slot,
+// are allocated up front, and an event that finds the ring full is dropped and counted. A writer thread drains the
+// ring into the selected sink and flushes once it has caught up, so console and file I/O happen off the generation
+// loop. Calls to post() must not overlap; the observers of evolve are already serialized.
+class EventLog
+{
+public:
+	EventLog(const LogFormat e_format, const std::string& s_path, const std::size_t ui_cities, std::ofstream& out_file);
+	~EventLog(void);
+
+	EventLog(const EventLog&) = delete;
+	EventLog& operator=(const EventLog&) = delete;
+
+	bool post(const EventKind e_kind, const int i_generation, const float f_shortest, const gene_t* tour = nullptr, const std::uint32_t ui_detail = 0) noexcept;
+	void finish(void);
+
+	inline const std::string& path(void) const noexcept { return s_path; }
+	inline long long posted(void) const noexcept  { return i_posted; }
+	inline long long dropped(void) const noexcept { return i_dropped; }
+
+private:
+	void work(void);
+	void write(const LogEvent& event, const gene_t* tour);
+
+	LogFormat                 e_format;     // sink of the events
+	std::string               s_path;       // file of the JSON and binary sinks
+	std::size_t               ui_cities;    // genes per tour
+	std::size_t               ui_mask;      // slots - 1, the slot count is a power of two
+	std::vector<LogEvent>     events;       // ring of events
+	std::vector<gene_t>       g_v_tours;    // tour of every slot, ui_cities genes each
+	std::ofstream*            p_outFile;    // output file of the text sink
+	std::ofstream             log_file;     // file of the JSON and binary sinks
+	timePoint                 start;        // when the log was opened
+	timePoint                 lap;          // when the previous generation event was posted
+	long long                 i_posted;     // events accepted, producer only
+	long long                 i_dropped;    // events dropped on a full ring, producer only
+	alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> ui_head; // next slot the writer reads
+	alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> ui_tail; // next slot the GA fills
+	std::atomic<bool>         b_quit;       // whether the writer should exit once the ring is empty
+	std::thread               worker;       // the writer thread, started last
+}; // end class EventLog
+
+
+#pragma region Prototypes:
+
+	const char* logFormatName(const LogFormat e_format) noexcept;
+	bool parseLogFormat(const char* name, LogFormat& e_format) noexcept;
+
+#pragma endregion
+
+#endif
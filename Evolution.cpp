@@ -0,0 +1,880 @@
+#pragma region Includes:
+
+	#include "Evolution.h"   // EvolutionResult, GenerationObserver
+	#include "Checkpoint.h"  // Snapshot, CheckpointWriter
+	#include "Island.h"      // Mailbox
+	#include "Cluster.h"     // Cluster
+	#include "LocalSearch.h" // NeighborLists, improve
+	#include "Pipeline.h"    // GenerationPipeline
+	#include "Ranking.h"     // rank
+	#include "Random.hpp"    // seedThreads, captureEngines, localEngine, randomBelow
+	#include "Profiler.h"    // profiler, PROFILE_STAGE
+	#include "Validate.h"    // validate, ValidationReport
+	#include "utility.hpp"   // highRes_Clock
+	#include <omp.h>         // omp_get_max_threads, omp_get_thread_num
+	#include <algorithm>     // std::copy, std::partial_sort, std::nth_element, std::min
+	#include <atomic>        // std::atomic
+	#include <exception>     // std::exception_ptr
+	#include <memory>        // std::unique_ptr
+	#include <stdexcept>     // std::invalid_argument
+	#include <string>        // std::to_string
+
+#pragma endregion
+
+
+#pragma region External Function Prototypes:
+
+	extern void evaluate(Population& population, const Point* coordinates);
+	extern void evaluate(Population& population, const DistanceMatrix& distances, const KernelIsa e_isa);
+	extern void select(const Population& population, std::uint32_t parents[], const std::size_t ui_parents);
+	extern void crossover(const Population& population, std::uint32_t parents[], Population& offsprings, const Point* coordinates);
+	extern void crossover(const Population& population, std::uint32_t parents[], Population& offsprings, const DistanceMatrix& distances);
+	extern void mutate(Population& offsprings, const int RATE, const int INVERSIONS, const DistanceMatrix* distances);
+	extern void mutate(Population& offsprings, const int RATE, const int INVERSIONS, const Point* coordinates);
+	extern void populate(Population& population, const Population& offsprings);
+
+#pragma endregion
+
+
+#pragma region Helpers:
+
+	/// <summary>
+	///          Runs <paramref name="i_generations"/> generations on <paramref name="trip"/>: evaluate, rank, select, crossover,
+	///          mutate and populate. Fitness is carried along instead of recomputed: children are scored right after crossover,
+	///          mutation and local search adjust the scores, and populate moves them into trip, so evaluating trip only walks
+	///          tours whose genomes changed behind the operators' backs. Every operator splits its work over the calling
+	///          thread's OpenMP team, which is a team of one on an island.
+	/// </summary>
+	/// <param name="neighbors">
+	///          Candidate lists of the local search stage, null when options.d_localSearch leaves it off.
+	/// </param>
+	/// <param name="pipeline">
+	///          Task graph running select to populate over offsprings and parents, null to run them as parallel loops.
+	/// </param>
+	/// <param name="i_firstGeneration">
+	///          Generation to start at, above 0 when resuming from a checkpoint.
+	/// </param>
+	/// <param name="validation">
+	///          Tally of the validation stage, which checks trip before it is evaluated unless options.e_validation is off.
+	/// </param>
+	/// <param name="controller">
+	///          Sets the mutation rate and operator mix of every generation once it has been ranked.
+	/// </param>
+	/// <param name="stop">
+	///          Counts the evaluations and ends the loop early once a stopping criterion is met.
+	/// </param>
+	/// <param name="arrive">
+	///          Called with the generation number before it is evaluated.
+	/// </param>
+	/// <param name="ranked">
+	///          Called with the generation number once it has been ranked, before parents are selected.
+	/// </param>
+	template<typename Arrive, typename Ranked>
+	static void runGenerations(const RunOptions& options, const Point* coordinates, const DistanceMatrix& distances, const NeighborLists* neighbors,
+							   Population& trip, Population& offsprings, std::vector<std::uint32_t>& parents, GenerationPipeline* pipeline, const int i_firstGeneration,
+							   const int i_generations, ValidationReport& validation, MutationController& controller, StopCriteria& stop, Arrive arrive, Ranked ranked)
+	{
+		const bool b_useMatrix = (options.e_distanceMode == DistanceMode::matrix);
+
+		// find the shortest path in each generation
+		for (int generation = i_firstGeneration; generation < i_generations; generation++) {
+
+			arrive(generation);
+			profiler().nextGeneration();
+
+			#if ENABLE_VALIDATION
+				// check the tours about to be scored: the first generation, populated children and migrants
+				if (options.e_validation != ValidationMode::off)
+				{
+					PROFILE_STAGE(Stage::validate);
+					validate(trip, options.e_validation, options.d_validateSample, generation, validation);
+				} // end validate
+			#else
+				(void)validation;
+			#endif
+
+			// evaluate the distance of the trips that are not scored yet: the first generation and migrants
+			{
+				PROFILE_STAGE(Stage::evaluate);
+				stop.evaluated(trip.unscored());
+
+				if (b_useMatrix)
+				{
+					evaluate(trip, distances, options.e_kernelIsa);
+				} // end if
+				else
+				{
+					evaluate(trip, coordinates);
+				} // end else
+			} // end evaluate
+
+			// bring the best trip to the front and the worst to the back
+			{
+				PROFILE_STAGE(Stage::rank);
+				rank(trip, offsprings.size(), options.e_rankingMode);
+			} // end rank
+
+			// update mutation rate to diversify converging population
+			{
+				PROFILE_STAGE(Stage::adapt);
+				controller.update(generation, trip);
+			} // end adapt
+
+			ranked(generation);
+
+			// a met criterion ends the run here, the generation's best has been recorded
+			if (stop.reached(generation, trip.keys()[0].fitness))
+			{
+				break;
+			} // end if
+
+			// select to populate in one go, chunk by chunk
+			if (pipeline != nullptr)
+			{
+				PROFILE_STAGE(Stage::pipeline);
+				stop.evaluated(offsprings.size());
+				pipeline->run(controller.rate(), controller.inversionShare());
+				continue;
+			} // end pipeline
+
+			// choose parents from trip
+			{
+				PROFILE_STAGE(Stage::select);
+				select(trip, parents.data(), parents.size());
+			} // end select
+
+			// generates offsprings from the parents
+			{
+				PROFILE_STAGE(Stage::crossover);
+
+				if (b_useMatrix)
+				{
+					crossover(trip, parents.data(), offsprings, distances);
+				} // end if
+				else
+				{
+					crossover(trip, parents.data(), offsprings, coordinates);
+				} // end else
+			} // end crossover
+
+			// score the children while they are packed together, the fitness then travels with them into trip
+			{
+				PROFILE_STAGE(Stage::evaluate);
+				stop.evaluated(offsprings.unscored());
+
+				if (b_useMatrix)
+				{
+					evaluate(offsprings, distances, options.e_kernelIsa);
+				} // end if
+				else
+				{
+					evaluate(offsprings, coordinates);
+				} // end else
+			} // end evaluate
+
+			// mutate offsprings, updating their scores by the edges a swap changes
+			{
+				PROFILE_STAGE(Stage::mutate);
+
+				if (b_useMatrix)
+				{
+					mutate(offsprings, controller.rate(), controller.inversionShare(), &distances);
+				} // end if
+				else
+				{
+					mutate(offsprings, controller.rate(), controller.inversionShare(), coordinates);
+				} // end else
+			} // end mutate
+
+			// polish some offsprings with 2-opt and Or-opt
+			if (neighbors != nullptr)
+			{
+				PROFILE_STAGE(Stage::localSearch);
+				improve(offsprings, distances, *neighbors, options.d_localSearch, options.i_localBudget);
+			} // end local search
+
+			// populate the next generation.
+			{
+				PROFILE_STAGE(Stage::populate);
+				populate(trip, offsprings);
+			} // end populate
+		} // end for generation
+	} // end template runGenerations
+
+
+	/// <summary>
+	///          Copies the tour ranked first in <paramref name="trip"/> into <paramref name="result"/> if it is shorter.
+	/// </summary>
+	/// <returns>
+	///          true if it was
+	/// </returns>
+	static bool recordBest(const Population& trip, const int i_generation, EvolutionResult& result)
+	{
+		const float f_best = trip.keys()[0].fitness;
+
+		if (result.f_shortest >= 0 && result.f_shortest <= f_best)
+		{
+			return false;
+		} // end if
+
+		result.f_shortest = f_best;
+		result.i_bestGeneration = i_generation;
+		std::copy(trip.genome(trip.slotOfRank(0)), trip.genome(trip.slotOfRank(0)) + trip.cities(), result.shortest.begin());
+
+		return true;
+	} // end method recordBest
+
+
+	/// <summary>
+	///          Copies the rate, operator mix and diversity <paramref name="controller"/> ended with into <paramref name="result"/>.
+	/// </summary>
+	static void recordController(const MutationController& controller, EvolutionResult& result) noexcept
+	{
+		result.diversity = controller.metrics();
+		result.i_mutationRate = controller.rate();
+		result.i_inversionShare = controller.inversionShare();
+	} // end method recordController
+
+
+	/// <summary>
+	///          Island-model run: <paramref name="trip"/> is cut into options.ui_islands sub-populations, each evolved by a
+	///          thread of its own without ever waiting for the others. Every options.i_migrationInterval generations an
+	///          island posts copies of its options.ui_migrants best tours to the mailbox of the next island on the ring, or
+	///          of a random one; at the start of every generation it takes whatever has arrived and overwrites the survivors
+	///          ranked just above the replacement boundary with it. A full mailbox drops the migration rather than block.
+	///          Migration timing depends on thread scheduling, so unlike the loop-parallel run an island run does not
+	///          repeat exactly from its seed. An island that fails stops the others at their next generation and its
+	///          exception is rethrown once all have left.
+	/// </summary>
+	/// <exception cref="std::invalid_argument">Thrown if an island is too small for its offsprings and migrants.</exception>
+	/// <exception cref="std::runtime_error">Thrown if validation aborts the run.</exception>
+	/// <exception cref="std::bad_alloc">Thrown if the islands cannot be allocated.</exception>
+	static EvolutionResult evolveIslands(const RunOptions& options, const Instance& instance, const Population& trip, const DistanceMatrix& distances,
+										 const NeighborLists* neighbors, const std::uint64_t ui_seed, const GenerationObserver& observer)
+	{
+		const Point* coordinates = instance.coordinates.data();
+		const std::size_t ui_cities = instance.cities();
+		const std::size_t ui_islands = options.ui_islands;
+		const std::size_t ui_migrants = options.ui_migrants;
+		const int i_interval = options.i_migrationInterval;
+
+		std::vector<std::unique_ptr<Population>> islands(ui_islands);     // sub-populations
+		std::vector<std::unique_ptr<Population>> offsprings(ui_islands);  // their offspring pools
+		std::vector<std::unique_ptr<Mailbox>> mailboxes(ui_islands);      // their inboxes
+		std::vector<std::vector<std::uint32_t>> parents(ui_islands);      // their selected parents
+
+		// every island gets its share of the tours and of the offsprings, rounded down to whole pairs
+		for (std::size_t i = 0; i < ui_islands; i++)
+		{
+			const std::size_t ui_begin = trip.size() * i / ui_islands;
+			const std::size_t ui_size = trip.size() * (i + 1) / ui_islands - ui_begin;
+			const std::size_t ui_offsprings = (instance.ui_offsprings * ui_size / trip.size()) & ~static_cast<std::size_t>(1);
+
+			if (ui_offsprings < 2 || ui_size < ui_offsprings + ui_migrants + 1)
+			{
+				throw std::invalid_argument("Island " + std::to_string(i) + " of " + std::to_string(ui_size) + " tours is too small for "
+											+ std::to_string(ui_offsprings) + " offsprings and " + std::to_string(ui_migrants) + " migrants!");
+			} // end if
+
+			mailboxes[i].reset(new Mailbox(ui_migrants * ui_cities));
+		} // end for i
+
+		EvolutionResult result;
+		result.shortest.resize(ui_cities);
+		result.f_shortest = -1.0f;
+		result.i_bestGeneration = -1;
+		result.i_generations = 0;
+		result.i_migrations = 0;
+		result.i_droppedMigrations = 0;
+		result.i_evaluations = 0;
+		result.e_stopReason = StopReason::generations;
+		result.i_mutationRate = options.i_mutationRate;
+		result.i_inversionShare = 0;
+		result.i_resumedAt = 0;
+		result.i_checkpoints = 0;
+		result.i_skippedCheckpoints = 0;
+
+		// start a timer
+		const timePoint start = highRes_Clock::now();
+
+		std::atomic<bool> b_failed(false);  // whether an island has thrown
+		StopCriteria stop(options, instance.i_generations); // shared by all islands
+		std::exception_ptr failure;         // what the first failing island threw
+
+		// islands take the profiler's thread slots, island 0 times the stages
+		if (options.b_profile)
+		{
+			profiler().begin(ui_islands, instance.i_generations);
+		} // end if
+
+		#pragma omp parallel num_threads(static_cast<int>(ui_islands))
+		{
+			const std::size_t ui_island = static_cast<std::size_t>(omp_get_thread_num());
+			const std::size_t ui_begin = trip.size() * ui_island / ui_islands;
+			const std::size_t ui_size = trip.size() * (ui_island + 1) / ui_islands - ui_begin;
+			float f_islandBest = -1.0f;
+			int i_ran = 0;
+			long long i_sent = 0, i_dropped = 0;
+			ValidationReport validation;
+			MutationController controller(options.e_mutationSchedule, options.i_mutationRate, options.d_diversityTarget);
+
+			// the operators' own parallel regions run on this thread alone
+			omp_set_num_threads(1);
+			localEngine().seed(ui_seed, static_cast<std::uint64_t>(ui_island));
+
+			// exceptions must not leave the parallel region
+			try
+			{
+				// an island allocates and first touches its own tours, so they live on the node its thread is pinned to
+				islands[ui_island].reset(new Population(ui_size, ui_cities));
+				offsprings[ui_island].reset(new Population((instance.ui_offsprings * ui_size / trip.size()) & ~static_cast<std::size_t>(1), ui_cities));
+				parents[ui_island].resize(offsprings[ui_island]->size());
+
+				Population& island = *islands[ui_island];
+				const std::size_t ui_survivors = island.size() - offsprings[ui_island]->size();
+
+				for (std::size_t j = 0; j < ui_size; j++)
+				{
+					std::copy(trip.genome(ui_begin + j), trip.genome(ui_begin + j) + ui_cities, island.genome(j));
+				} // end for j
+
+				runGenerations(options, coordinates, distances, neighbors, island, *offsprings[ui_island], parents[ui_island], nullptr, 0, instance.i_generations, validation, controller, stop,
+					[&](const int generation)
+				{
+					if (b_failed.load(std::memory_order_relaxed))
+					{
+						throw std::runtime_error("another island failed");
+					} // end if
+
+					// overwrite the weakest survivors with migrants, never the island's best; ranking only orders the best and
+					// the replaced tail, so the weakest of the survivors not yet overwritten are moved to the end first
+					std::size_t ui_rank = ui_survivors;
+
+					while (generation > 0 && ui_rank >= ui_migrants + 1 && mailboxes[ui_island]->pop([&](const gene_t* packet)
+					{
+						std::nth_element(island.keys() + 1, island.keys() + ui_rank - ui_migrants, island.keys() + ui_rank);
+
+						for (std::size_t m = 0; m < ui_migrants; m++)
+						{
+							const std::size_t ui_slot = island.slotOfRank(--ui_rank);
+
+							std::copy(packet + m * ui_cities, packet + (m + 1) * ui_cities, island.genome(ui_slot));
+							island.invalidate(ui_slot);
+						} // end for m
+					}));
+				},
+					[&](const int generation)
+				{
+					const bool b_islandImproved = (f_islandBest < 0 || island.keys()[0].fitness < f_islandBest);
+
+					i_ran = generation + 1;
+
+					if (b_islandImproved)
+					{
+						f_islandBest = island.keys()[0].fitness;
+					} // end if
+
+					if (b_islandImproved || ui_island == 0)
+					{
+						#pragma omp critical(island_best)
+						{
+							const bool b_improved = b_islandImproved && recordBest(island, generation, result);
+
+							if (observer && (b_improved || ui_island == 0))
+							{
+								observer(generation, b_improved, result);
+							} // end if
+						} // end critical
+					} // end if
+
+					if (ui_islands > 1 && (generation + 1) % i_interval == 0)
+					{
+						const std::size_t ui_target = (options.e_topology == MigrationTopology::ring
+														? (ui_island + 1) % ui_islands
+														: (ui_island + 1 + randomBelow(localEngine(), ui_islands - 1)) % ui_islands);
+						Population::Key* keys = island.keys();
+
+						// ranking only guarantees the best in front, order the next few survivors too
+						std::partial_sort(keys + 1, keys + ui_migrants, keys + ui_survivors);
+
+						const bool b_sent = mailboxes[ui_target]->push([&](gene_t* packet)
+						{
+							for (std::size_t m = 0; m < ui_migrants; m++)
+							{
+								std::copy(island.genome(island.slotOfRank(m)), island.genome(island.slotOfRank(m)) + ui_cities, packet + m * ui_cities);
+							} // end for m
+						});
+
+						(b_sent ? i_sent : i_dropped)++;
+					} // end if
+				});
+			} // end try
+			catch (...)
+			{
+				#pragma omp critical(island_best)
+				{
+					failure = (b_failed.exchange(true) ? failure : std::current_exception());
+				} // end critical
+			} // end catch
+
+			#pragma omp critical(island_best)
+			{
+				result.i_migrations += i_sent;
+				result.i_droppedMigrations += i_dropped;
+				result.validation.i_checked += validation.i_checked;
+				result.validation.i_invalid += validation.i_invalid;
+				result.validation.i_repaired += validation.i_repaired;
+				result.i_generations = std::max(result.i_generations, i_ran);
+
+				if (ui_island == 0)
+				{
+					recordController(controller, result);
+				} // end if
+			} // end critical
+		} // end parallel
+
+		// stop the timer
+		if (options.b_profile)
+		{
+			profiler().end();
+		} // end if
+
+		if (failure)
+		{
+			std::rethrow_exception(failure);
+		} // end if
+
+		result.i_evaluations = stop.evaluations();
+		result.e_stopReason = stop.reason();
+		result.i_elapsed = static_cast<long long>(std::chrono::duration_cast<std::chrono::microseconds>(highRes_Clock::now() - start).count());
+
+		return result;
+	} // end method evolveIslands
+
+
+
+	/// <summary>
+	///          Multi-process run, one rank of options.ui_ranks: this process evolves its shard of <paramref name="trip"/>
+	///          with all its threads and trades tours with the other ranks through a <see cref="Cluster"/>. Every
+	///          options.i_migrationInterval generations it sends its options.ui_migrants best tours to the next rank or a
+	///          random one without waiting, and at the start of every generation merges whatever has arrived like an island
+	///          does. Ranks report every new shortest tour and finally their best one to rank 0, which keeps the global
+	///          shortest tour and waits for every rank's final report before it returns.
+	/// </summary>
+	/// <exception cref="std::invalid_argument">Thrown if the shard is too small or islands were asked for as well.</exception>
+	/// <exception cref="std::runtime_error">Thrown if the ranks cannot communicate or a rank never reports back.</exception>
+	static EvolutionResult evolveDistributed(const RunOptions& options, const Instance& instance, const Population& trip, const DistanceMatrix& distances,
+											 const NeighborLists* neighbors, const std::uint64_t ui_seed, const GenerationObserver& observer)
+	{
+		const std::size_t ui_cities = instance.cities();
+		const std::size_t ui_rank = options.ui_rank;
+		const std::size_t ui_ranks = options.ui_ranks;
+		const std::size_t ui_migrants = options.ui_migrants;
+		const std::size_t ui_begin = trip.size() * ui_rank / ui_ranks;
+		const std::size_t ui_size = trip.size() * (ui_rank + 1) / ui_ranks - ui_begin;
+		const std::size_t ui_offsprings = (instance.ui_offsprings * ui_size / trip.size()) & ~static_cast<std::size_t>(1);
+		const std::size_t ui_survivors = ui_size - ui_offsprings;
+
+		if (options.ui_islands > 0)
+		{
+			throw std::invalid_argument("Islands cannot be combined with ranks!");
+		} // end if
+
+		if (ui_offsprings < 2 || ui_size < ui_offsprings + ui_migrants + 1)
+		{
+			throw std::invalid_argument("Shard of " + std::to_string(ui_size) + " tours is too small for " + std::to_string(ui_offsprings)
+										+ " offsprings and " + std::to_string(ui_migrants) + " migrants!");
+		} // end if
+
+		Cluster cluster(options.s_endpoint, ui_rank, ui_ranks, ui_cities, ui_migrants);
+		Population shard(ui_size, ui_cities);                       // this rank's tours
+		Population offsprings(ui_offsprings, ui_cities);            // pool of generate children
+		std::vector<std::uint32_t> parents(ui_offsprings);          // slots of the selected parents
+		std::size_t ui_reported = 0;                                // ranks whose final report rank 0 has
+		MutationController controller(options.e_mutationSchedule, options.i_mutationRate, options.d_diversityTarget);
+		StopCriteria stop(options, instance.i_generations);         // this rank's criteria, met on its own shard
+		std::unique_ptr<GenerationPipeline> pipeline(options.e_pipeline == PipelineMode::tasks
+													 ? new GenerationPipeline(options, distances, neighbors, shard, offsprings, parents) : nullptr);
+
+		for (std::size_t j = 0; j < ui_size; j++)
+		{
+			std::copy(trip.genome(ui_begin + j), trip.genome(ui_begin + j) + ui_cities, shard.genome(j));
+		} // end for j
+
+		EvolutionResult result;
+		result.shortest.resize(ui_cities);
+		result.f_shortest = -1.0f;
+		result.i_bestGeneration = -1;
+		result.i_generations = 0;
+		result.i_migrations = 0;
+		result.i_droppedMigrations = 0;
+		result.i_evaluations = 0;
+		result.e_stopReason = StopReason::generations;
+		result.i_mutationRate = options.i_mutationRate;
+		result.i_inversionShare = 0;
+		result.i_resumedAt = 0;
+		result.i_checkpoints = 0;
+		result.i_skippedCheckpoints = 0;
+
+		// takes one message off the socket: migrants join the shard, reports update rank 0's shortest tour
+		auto deliver = [&](const WireHeader& header, const int generation)
+		{
+			if (header.ui_kind == static_cast<std::uint16_t>(MessageKind::migrants))
+			{
+				// overwrite the weakest survivors, never the best; the first generation has no ranking yet
+				const std::size_t ui_tours = std::min<std::size_t>(header.ui_tours, ui_survivors > 0 ? ui_survivors - 1 : 0);
+
+				// ranking only orders the best and the replaced tail, move the weakest survivors to the end first
+				if (generation > 0 && ui_tours > 0)
+				{
+					std::nth_element(shard.keys() + 1, shard.keys() + ui_survivors - ui_tours, shard.keys() + ui_survivors);
+				} // end if
+
+				for (std::size_t m = 0; generation > 0 && m < ui_tours; m++)
+				{
+					const std::size_t ui_slot = shard.slotOfRank(ui_survivors - 1 - m);
+
+					std::copy(cluster.inbox() + m * ui_cities, cluster.inbox() + (m + 1) * ui_cities, shard.genome(ui_slot));
+					shard.invalidate(ui_slot);
+				} // end for m
+			} // end if
+			else if (ui_rank == 0 && header.ui_tours == 1)
+			{
+				ui_reported += (header.ui_kind == static_cast<std::uint16_t>(MessageKind::done));
+
+				if (result.f_shortest < 0 || header.f_fitness < result.f_shortest)
+				{
+					result.f_shortest = header.f_fitness;
+					result.i_bestGeneration = header.i_generation;
+					std::copy(cluster.inbox(), cluster.inbox() + ui_cities, result.shortest.begin());
+
+					if (observer)
+					{
+						observer(header.i_generation, true, result);
+					} // end if
+				} // end if
+			} // end elif
+		}; // end lambda deliver
+
+		// start a timer
+		const timePoint start = highRes_Clock::now();
+
+		// give every thread of every rank its own engine, rank 0 keeps the streams of a single-process run
+		seedThreads(ui_seed ^ (static_cast<std::uint64_t>(ui_rank) * 0x9E3779B97F4A7C15ull));
+
+		// time every stage from here on, the probes are no-ops until begin
+		if (options.b_profile)
+		{
+			profiler().begin(static_cast<std::size_t>(omp_get_max_threads()), instance.i_generations);
+		} // end if
+
+		runGenerations(options, instance.coordinates.data(), distances, neighbors, shard, offsprings, parents, pipeline.get(), 0, instance.i_generations, result.validation, controller, stop,
+			[&](const int generation)
+		{
+			WireHeader header;
+
+			while (cluster.receive(header))
+			{
+				deliver(header, generation);
+			} // end while
+		},
+			[&](const int generation)
+		{
+			const bool b_improved = recordBest(shard, generation, result);
+
+			result.i_generations = generation + 1;
+
+			// other ranks tell rank 0, which drops the report if its queue is full: the final report repeats the best
+			if (b_improved && ui_rank > 0)
+			{
+				std::copy(result.shortest.begin(), result.shortest.end(), cluster.outbox());
+				cluster.send(0, MessageKind::best, generation, 1, result.f_shortest, false);
+			} // end if
+
+			if (observer && ui_rank == 0)
+			{
+				observer(generation, b_improved, result);
+			} // end if
+
+			if (ui_ranks > 1 && (generation + 1) % options.i_migrationInterval == 0)
+			{
+				const std::size_t ui_target = (options.e_topology == MigrationTopology::ring
+												? (ui_rank + 1) % ui_ranks
+												: (ui_rank + 1 + randomBelow(localEngine(), ui_ranks - 1)) % ui_ranks);
+				Population::Key* keys = shard.keys();
+
+				// ranking only guarantees the best in front, order the next few survivors too
+				std::partial_sort(keys + 1, keys + ui_migrants, keys + ui_survivors);
+
+				for (std::size_t m = 0; m < ui_migrants; m++)
+				{
+					std::copy(shard.genome(shard.slotOfRank(m)), shard.genome(shard.slotOfRank(m)) + ui_cities, cluster.outbox() + m * ui_cities);
+				} // end for m
+
+				(cluster.send(ui_target, MessageKind::migrants, generation, ui_migrants, keys[0].fitness, false) ? result.i_migrations : result.i_droppedMigrations)++;
+			} // end if
+
+		});
+
+		// stop the timer
+		if (options.b_profile)
+		{
+			profiler().end();
+		} // end if
+
+		recordController(controller, result);
+		result.i_evaluations = stop.evaluations();
+		result.e_stopReason = stop.reason();
+
+		if (ui_rank > 0)
+		{
+			std::copy(result.shortest.begin(), result.shortest.end(), cluster.outbox());
+
+			if (!cluster.send(0, MessageKind::done, result.i_bestGeneration, 1, result.f_shortest, true))
+			{
+				throw std::runtime_error("Rank 0 did not take the final report!");
+			} // end if
+		} // end if
+		else
+		{
+			// the run is over once every other rank has reported
+			while (ui_reported + 1 < ui_ranks)
+			{
+				WireHeader header;
+
+				if (!cluster.wait(CLUSTER_TIMEOUT_MS))
+				{
+					throw std::runtime_error(std::to_string(ui_ranks - 1 - ui_reported) + " rank(s) did not report back!");
+				} // end if
+
+				while (cluster.receive(header))
+				{
+					deliver(header, result.i_generations);
+				} // end while
+			} // end while
+		} // end else
+
+		result.i_elapsed = static_cast<long long>(std::chrono::duration_cast<std::chrono::microseconds>(highRes_Clock::now() - start).count());
+
+		return result;
+	} // end method evolveDistributed
+
+#pragma endregion
+
+
+#pragma region Implementations:
+
+	/// <summary>
+	///          Runs the generation loop of the genetic algorithm on <paramref name="trip"/>: evaluate, rank, select, crossover,
+	///          mutate and populate, instance.i_generations times. With options.ui_islands set the population is split into
+	///          islands evolving side by side instead, see <see cref="evolveIslands"/>; with options.ui_ranks above one this
+	///          process evolves one rank's shard, see <see cref="evolveDistributed"/>. The loop-parallel run alone can write
+	///          checkpoints every options.i_checkpointInterval generations and resume from one; a resumed run repeats the
+	///          rest of the original bit for bit as long as the thread count and the time-free options are the same.
+	/// </summary>
+	/// <param name="options">
+	///          Starting mutation rate, engine selection and island settings.
+	/// </param>
+	/// <param name="instance">
+	///          The instance <paramref name="trip"/> belongs to.
+	/// </param>
+	/// <param name="trip">
+	///          The initial population, evolved in place unless islands copy it.
+	/// </param>
+	/// <param name="distances">
+	///          Distance table of the instance's cities.
+	/// </param>
+	/// <param name="ui_seed">
+	///          Master seed of the per-thread engines; call after omp_set_num_threads so the team is the one running the loop.
+	/// </param>
+	/// <param name="observer">
+	///          Called after every generation has been ranked, may be empty. Islands call it one at a time: island 0 for every
+	///          generation, the others when they find a new shortest tour.
+	/// </param>
+	/// <param name="buffers">
+	///          Offspring pool and parent slots to reuse, null to allocate them for this call. Islands and ranks allocate their own.
+	/// </param>
+	/// <returns>
+	///          The shortest tour and the time spent.
+	/// </returns>
+	/// <exception cref="std::invalid_argument">
+	///          Thrown if an island is too small for its offsprings and migrants, if checkpoints are asked of an island or
+	///          multi-process run or the resumed snapshot was taken with other settings, or if the task pipeline is asked of
+	///          an island run or cannot cut the population into its chunks.
+	/// </exception>
+	/// <exception cref="std::runtime_error">Thrown if validation aborts the run, or a snapshot cannot be read or written.</exception>
+	/// <exception cref="std::bad_alloc">Thrown if the offspring pool cannot be allocated.</exception>
+	EvolutionResult evolve(const RunOptions& options, const Instance& instance, Population& trip, const DistanceMatrix& distances,
+						   const std::uint64_t ui_seed, const GenerationObserver& observer, EvolutionBuffers* buffers)
+	{
+		// the local search reads the same candidate lists on every thread, island and generation
+		const std::unique_ptr<const NeighborLists> neighbors(options.d_localSearch > 0 ? new NeighborLists(distances) : nullptr);
+
+		if ((options.ui_ranks > 1 || options.ui_islands > 0) && (!options.s_checkpointFile.empty() || !options.s_resumeFile.empty()))
+		{
+			throw std::invalid_argument("Checkpoints need a single-process run without islands!");
+		} // end if
+
+		if (options.ui_islands > 0 && options.e_pipeline == PipelineMode::tasks)
+		{
+			throw std::invalid_argument("The task pipeline needs a run without islands!");
+		} // end if
+
+		if (options.ui_ranks > 1)
+		{
+			return evolveDistributed(options, instance, trip, distances, neighbors.get(), ui_seed, observer);
+		} // end if
+
+		if (options.ui_islands > 0)
+		{
+			return evolveIslands(options, instance, trip, distances, neighbors.get(), ui_seed, observer);
+		} // end if
+
+		const std::size_t ui_cities = instance.cities();
+
+		EvolutionBuffers own;                                        // used unless the caller lends its buffers
+		EvolutionBuffers& reused = (buffers != nullptr ? *buffers : own);
+
+		if (!reused.offsprings || reused.offsprings->size() != instance.ui_offsprings || reused.offsprings->cities() != ui_cities)
+		{
+			reused.offsprings.reset(new Population(instance.ui_offsprings, ui_cities));
+		} // end if
+
+		reused.parents.resize(instance.ui_offsprings);
+
+		std::vector<std::uint32_t>& parents = reused.parents;        // slots of the selected parents
+		Population& offsprings = *reused.offsprings;                 // pool of generate children
+		MutationController controller(options.e_mutationSchedule, options.i_mutationRate, options.d_diversityTarget);
+		StopCriteria stop(options, instance.i_generations);
+
+		EvolutionResult result;
+		result.shortest.resize(ui_cities);
+		result.f_shortest = -1.0f;
+		result.i_bestGeneration = -1;
+		result.i_generations = 0;
+		result.i_migrations = 0;
+		result.i_droppedMigrations = 0;
+		result.i_evaluations = 0;
+		result.e_stopReason = StopReason::generations;
+		result.i_mutationRate = options.i_mutationRate;
+		result.i_inversionShare = 0;
+		result.i_resumedAt = 0;
+		result.i_checkpoints = 0;
+		result.i_skippedCheckpoints = 0;
+
+		// start a timer
+		const timePoint start = highRes_Clock::now();
+
+		// give every thread its own engine
+		seedThreads(ui_seed);
+
+		// a resumed run continues where the snapshot left off, down to the next draw of every engine
+		if (!options.s_resumeFile.empty())
+		{
+			const Snapshot snapshot(options.s_resumeFile);
+			const SnapshotHeader& header = snapshot.header();
+
+			if (header.ui_offsprings != instance.ui_offsprings || header.ui_threads != static_cast<std::uint32_t>(omp_get_max_threads()))
+			{
+				throw std::invalid_argument(options.s_resumeFile + " was taken with " + std::to_string(header.ui_offsprings) + " offsprings and "
+											+ std::to_string(header.ui_threads) + " threads!");
+			} // end if
+
+			snapshot.restore(trip);
+			std::copy(snapshot.shortest(), snapshot.shortest() + ui_cities, result.shortest.begin());
+			result.f_shortest = header.f_shortest;
+			result.i_bestGeneration = header.i_bestGeneration;
+			result.i_generations = header.i_generation;
+			result.i_resumedAt = header.i_generation;
+			result.validation.i_checked = header.i_checked;
+			result.validation.i_invalid = header.i_invalid;
+			result.validation.i_repaired = header.i_repaired;
+			controller.restore(header.i_mutationRate, header.i_inversionShare, header.d_pressure);
+			stop.restore(header.i_evaluations, header.f_shortest, header.i_improved);
+			restoreEngines(snapshot.engines());
+		} // end if
+
+		std::unique_ptr<CheckpointWriter> writer(options.s_checkpointFile.empty() ? nullptr : new CheckpointWriter(options.s_checkpointFile));
+		std::unique_ptr<GenerationPipeline> pipeline(options.e_pipeline == PipelineMode::tasks
+													 ? new GenerationPipeline(options, distances, neighbors.get(), trip, offsprings, parents) : nullptr);
+		std::vector<std::uint64_t> engines; // scratch for the engine states of a checkpoint
+
+		// time every stage from here on, the probes are no-ops until begin
+		if (options.b_profile)
+		{
+			profiler().begin(static_cast<std::size_t>(omp_get_max_threads()), instance.i_generations);
+		} // end if
+
+		runGenerations(options, instance.coordinates.data(), distances, neighbors.get(), trip, offsprings, parents, pipeline.get(), result.i_resumedAt, instance.i_generations,
+			result.validation, controller, stop,
+			[&](const int generation)
+		{
+			// snapshot the start of every interval's generation; packing is a copy, the writer thread does the rest
+			if (!writer || generation == result.i_resumedAt || generation % options.i_checkpointInterval != 0)
+			{
+				return;
+			} // end if
+
+			if (!writer->idle())
+			{
+				writer->skip();
+				return;
+			} // end if
+
+			SnapshotHeader header = {};
+
+			header.ui_cities = static_cast<std::uint32_t>(ui_cities);
+			header.ui_population = static_cast<std::uint32_t>(trip.size());
+			header.ui_offsprings = static_cast<std::uint32_t>(offsprings.size());
+			header.ui_threads = static_cast<std::uint32_t>(omp_get_max_threads());
+			header.i_generation = generation;
+			header.i_bestGeneration = result.i_bestGeneration;
+			header.f_shortest = result.f_shortest;
+			header.i_mutationRate = controller.rate();
+			header.i_inversionShare = controller.inversionShare();
+			header.i_improved = stop.improvedAt();
+			header.d_pressure = controller.pressure();
+			header.i_evaluations = stop.evaluations();
+			header.i_checked = result.validation.i_checked;
+			header.i_invalid = result.validation.i_invalid;
+			header.i_repaired = result.validation.i_repaired;
+
+			captureEngines(engines);
+			writer->next().pack(header, engines, result.shortest.data(), trip);
+			writer->post();
+		},
+			[&](const int generation)
+		{
+			// whenever a shorter path was found, update the shortest path
+			const bool b_improved = recordBest(trip, generation, result);
+
+			result.i_generations = generation + 1;
+
+			if (observer)
+			{
+				observer(generation, b_improved, result);
+			} // end if
+		});
+
+		// stop the timer
+		if (options.b_profile)
+		{
+			profiler().end();
+		} // end if
+
+		if (writer)
+		{
+			writer->finish();
+			result.i_checkpoints = writer->written();
+			result.i_skippedCheckpoints = writer->skipped();
+		} // end if
+
+		recordController(controller, result);
+		result.i_evaluations = stop.evaluations();
+		result.e_stopReason = stop.reason();
+		result.i_elapsed = static_cast<long long>(std::chrono::duration_cast<std::chrono::microseconds>(highRes_Clock::now() - start).count());
+
+		return result;
+	} // end method evolve
+
+#pragma endregion
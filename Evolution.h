@@ -0,0 +1,64 @@
+#ifndef _EVOLUTION_H_
+#define _EVOLUTION_H_
+
+#pragma region Includes:
+
+	#include <cstdint>          // std::uint64_t
+	#include <functional>       // std::function
+	#include <memory>           // std::unique_ptr
+	#include <vector>           // std::vector
+	#include "Population.h"     // Population, gene_t
+	#include "DistanceMatrix.h" // DistanceMatrix
+	#include "Instance.h"       // Instance
+	#include "RunOptions.h"     // RunOptions
+	#include "Validate.h"       // ValidationReport
+	#include "MutationControl.h" // DiversityMetrics
+	#include "Stopping.h"       // StopReason
+
+#pragma endregion
+
+
+// Outcome of evolving a population.
+struct EvolutionResult
+{
+	std::vector<gene_t> shortest;            // the shortest tour found
+	float               f_shortest;          // its length, negative until the first generation
+	int                 i_bestGeneration;    // generation that found it
+	int                 i_generations;       // generations run, the most of any island
+	long long           i_evaluations;       // tours evaluated from scratch
+	StopReason          e_stopReason;        // criterion that ended the run
+	long long           i_elapsed;           // microseconds spent in the generation loop
+	long long           i_migrations;        // migrant packets islands posted
+	long long           i_droppedMigrations; // migrant packets dropped on a full mailbox
+	ValidationReport    validation;          // tours the validation stage checked, of this rank only in a multi-process run
+	DiversityMetrics    diversity;           // last diversity measurement of the adaptive schedule, of island 0 or this rank
+	int                 i_mutationRate;      // mutation rate of the last generation, of island 0 or this rank
+	int                 i_inversionShare;    // % of the last generation's mutations that reversed a segment
+	int                 i_resumedAt;         // generation a resumed run continued from, 0 for a fresh run
+	long long           i_checkpoints;       // snapshots handed to the checkpoint writer
+	long long           i_skippedCheckpoints; // snapshots dropped while the writer was still busy
+}; // end struct EvolutionResult
+
+
+// Offspring pool and parent slots of the loop-parallel run. A caller evolving many instances one after another passes
+// the same buffers to every evolve call; they are only reallocated when the number of offsprings or cities changes.
+struct EvolutionBuffers
+{
+	std::unique_ptr<Population> offsprings; // pool of generated children
+	std::vector<std::uint32_t>  parents;    // slots of the selected parents
+}; // end struct EvolutionBuffers
+
+
+// Called after every generation has been ranked, b_improved telling whether it found a new shortest tour. Island runs
+// call it from island threads, one at a time.
+typedef std::function<void(const int i_generation, const bool b_improved, const EvolutionResult& result)> GenerationObserver;
+
+
+#pragma region Prototypes:
+
+	EvolutionResult evolve(const RunOptions& options, const Instance& instance, Population& trip, const DistanceMatrix& distances,
+						   const std::uint64_t ui_seed, const GenerationObserver& observer, EvolutionBuffers* buffers = nullptr);
+
+#pragma endregion
+
+#endif
@@ -0,0 +1,91 @@
+// Benchmark and correctness check of the batch fitness kernel.
+// usage: bench_fitness [#repetitions]
+//
+// Loads chromosome.txt and cities.txt, checks every instruction set the CPU supports against the
+// scalar reference and reports evaluation throughput for each.
+
+#pragma region Includes:
+
+	#include <iostream>        // cout
+	#include <fstream>         // ifstream
+	#include <cstdlib>         // atoi
+	#include "utility.hpp"     // Point, highRes_Clock
+	#include "Trip.h"          // Trip
+	#include "FitnessKernel.h" // evaluateBatch, verifyBatchKernel
+
+#pragma endregion
+
+
+#define KERNEL_TOLERANCE 1e-5f // largest accepted relative difference to the scalar reference
+
+
+int main(int argc, char* argv[])
+{
+	const int i_repetitions = (argc > 1 ? atoi(argv[1]) : MAX_GENERATION);
+	const KernelIsa e_a_kernels[] = { KernelIsa::scalar, KernelIsa::sse41, KernelIsa::avx2 };
+
+	Trip* trip = new Trip[CHROMOSOMES];
+	Point coordinates[CITIES];
+	int i_output = EXIT_SUCCESS;
+
+	std::ifstream chromosome_file("chromosome.txt");
+	std::ifstream cities_file("cities.txt");
+
+	for (int i = 0; i < CHROMOSOMES; i++)
+	{
+		chromosome_file >> trip[i].itinerary;
+	} // end for i
+
+	for (int i = 0; i < CITIES; i++)
+	{
+		char city;
+		cities_file >> city;
+		int index = (city >= 'A') ? city - 'A' : city - '0' + 26;
+		cities_file >> coordinates[index].x >> coordinates[index].y;
+	} // end for i
+
+	if (!chromosome_file || !cities_file)
+	{
+		std::cout << "Reading chromosome.txt or cities.txt failed! Exiting ..." << std::endl;
+		delete[] trip;
+		return EXIT_FAILURE;
+	} // end if
+
+	const DistanceMatrix distances(coordinates, CITIES);
+	const TourBatch batch = { trip[0].itinerary, sizeof(Trip), &trip[0].fitness, sizeof(Trip), CHROMOSOMES, CITIES, GenomeEncoding::ascii };
+
+	std::cout << "detected: " << kernelIsaName(detectKernelIsa()) << ", " << CHROMOSOMES << " tours x " << i_repetitions << " repetitions" << std::endl;
+
+	for (const KernelIsa e_isa : e_a_kernels)
+	{
+		if (resolveKernelIsa(e_isa) != e_isa)
+		{
+			std::cout << kernelIsaName(e_isa) << ":\tnot supported" << std::endl;
+			continue;
+		} // end if
+
+		const float f_error = verifyBatchKernel(batch, distances, e_isa);
+
+		timePoint start = highRes_Clock::now();
+
+		for (int r = 0; r < i_repetitions; r++)
+		{
+			evaluateBatch(batch, distances, e_isa);
+		} // end for r
+
+		timePoint end = highRes_Clock::now();
+		const double d_seconds = std::chrono::duration_cast<std::chrono::duration<double>>(end - start).count();
+
+		std::cout << kernelIsaName(e_isa) << ":\t" << (d_seconds > 0 ? CHROMOSOMES * static_cast<double>(i_repetitions) / d_seconds : 0.0)
+				  << " tours/s\tmax rel. error = " << f_error << (f_error > KERNEL_TOLERANCE ? "\tFAILED" : "\tok") << std::endl;
+
+		if (f_error > KERNEL_TOLERANCE)
+		{
+			i_output = EXIT_FAILURE;
+		} // end if
+	} // end for e_isa
+
+	delete[] trip;
+
+	return i_output;
+} // end Main
@@ -0,0 +1,386 @@
+#pragma region Includes:
+
+	#include "FitnessKernel.h" // TourBatch, KernelIsa
+	#include <string.h>        // strcmp, memcpy
+	#include <cstdint>         // std::uint16_t
+	#include <cmath>           // std::fabs
+	#include <vector>          // std::vector
+
+	#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+		#define KERNEL_X86 1
+		#include <immintrin.h> // SSE4.1 / AVX2 intrinsics
+	#else
+		#define KERNEL_X86 0
+	#endif
+
+#pragma endregion
+
+
+#pragma region Helpers:
+
+	/// <summary>
+	///          Decodes gene <paramref name="ui_index"/> of <paramref name="genome"/> into its city index.
+	/// </summary>
+	/// <param name="genome">
+	///          First gene of the genome.
+	/// </param>
+	/// <param name="ui_index">
+	///          Position of the gene in the genome.
+	/// </param>
+	/// <param name="e_encoding">
+	///          How the genes of <paramref name="genome"/> are encoded.
+	/// </param>
+	/// <returns>
+	///          The city index of the gene.
+	/// </returns>
+	static inline std::size_t decodeGene(const char* genome, const std::size_t ui_index, const GenomeEncoding e_encoding) noexcept
+	{
+		if (e_encoding == GenomeEncoding::index16)
+		{
+			std::uint16_t ui_gene;
+
+			memcpy(&ui_gene, genome + 2 * ui_index, sizeof(ui_gene));
+			return ui_gene;
+		} // end if
+
+		const std::size_t ui_gene = static_cast<unsigned char>(genome[ui_index]);
+
+		if (e_encoding == GenomeEncoding::index)
+		{
+			return ui_gene;
+		} // end if
+
+		return (ui_gene >= 'A' ? ui_gene - 'A' : ui_gene - 22);
+	} // end method decodeGene
+
+
+	/// <summary>
+	///          Address of the fitness value of tour <paramref name="ui_tour"/> in <paramref name="batch"/>.
+	/// </summary>
+	static inline float* fitnessAt(const TourBatch& batch, const std::size_t ui_tour) noexcept
+	{
+		return reinterpret_cast<float*>(reinterpret_cast<char*>(batch.fitness) + ui_tour * batch.ui_fitnessStride);
+	} // end method fitnessAt
+
+#pragma endregion
+
+
+#pragma region Kernels:
+
+	/// <summary>
+	///          Reference kernel, evaluates tours [<paramref name="ui_first"/>, count) one edge at a time.
+	/// </summary>
+	static void evaluateScalar(const TourBatch& batch, const DistanceMatrix& distances, const std::size_t ui_first)
+	{
+		const std::size_t ui_origin = distances.origin();
+
+		for (std::size_t t = ui_first; t < batch.ui_count; t++)
+		{
+			const char* genome = batch.genomes + t * batch.ui_genomeStride;
+			std::size_t ui_previous = ui_origin;
+			float f_length = 0.0f;
+
+			for (std::size_t j = 0; j < batch.ui_cities; j++)
+			{
+				const std::size_t ui_current = decodeGene(genome, j, batch.e_encoding);
+
+				f_length += distances(ui_previous, ui_current);
+				ui_previous = ui_current;
+			} // end for j
+
+			*fitnessAt(batch, t) = f_length;
+		} // end for t
+	} // end method evaluateScalar
+
+
+#if KERNEL_X86
+
+	/// <summary>
+	///          SSE4.1 kernel, evaluates 4 tours per step. Index math is vectorized, table loads are scalar
+	///          since SSE has no gather.
+	/// </summary>
+	__attribute__((target("sse4.1")))
+	static void evaluateSse41(const TourBatch& batch, const DistanceMatrix& distances)
+	{
+		const std::size_t ui_full = batch.ui_count & ~static_cast<std::size_t>(3);
+		const std::size_t ui_stride = batch.ui_genomeStride;
+		const float* f_a_table = distances.data();
+
+		const __m128i v_rowStride = _mm_set1_epi32(static_cast<int>(distances.stride()));
+		const __m128i v_letterBound = _mm_set1_epi32('A' - 1);
+		const __m128i v_letterBase = _mm_set1_epi32('A');
+		const __m128i v_digitBase = _mm_set1_epi32(22);
+		const bool b_ascii = (batch.e_encoding == GenomeEncoding::ascii);
+
+		alignas(16) int i_a_index[4];
+		alignas(16) float f_a_sum[4];
+
+		for (std::size_t t = 0; t < ui_full; t += 4)
+		{
+			const char* genome = batch.genomes + t * ui_stride;
+			__m128i v_previous = _mm_set1_epi32(static_cast<int>(distances.origin()));
+			__m128 v_sum = _mm_setzero_ps();
+
+			for (std::size_t j = 0; j < batch.ui_cities; j++)
+			{
+				__m128i v_gene;
+
+				if (b_ascii)
+				{
+					const unsigned char* c_a_genome = reinterpret_cast<const unsigned char*>(genome);
+					v_gene = _mm_setr_epi32(c_a_genome[j], c_a_genome[ui_stride + j], c_a_genome[2 * ui_stride + j], c_a_genome[3 * ui_stride + j]);
+
+					const __m128i v_isLetter = _mm_cmpgt_epi32(v_gene, v_letterBound);
+					v_gene = _mm_sub_epi32(v_gene, _mm_blendv_epi8(v_digitBase, v_letterBase, v_isLetter));
+				} // end if
+				else
+				{
+					v_gene = _mm_setr_epi32(static_cast<int>(decodeGene(genome, j, batch.e_encoding)),
+											static_cast<int>(decodeGene(genome + ui_stride, j, batch.e_encoding)),
+											static_cast<int>(decodeGene(genome + 2 * ui_stride, j, batch.e_encoding)),
+											static_cast<int>(decodeGene(genome + 3 * ui_stride, j, batch.e_encoding)));
+				} // end else
+
+				_mm_store_si128(reinterpret_cast<__m128i*>(i_a_index), _mm_add_epi32(_mm_mullo_epi32(v_previous, v_rowStride), v_gene));
+				v_sum = _mm_add_ps(v_sum, _mm_setr_ps(f_a_table[i_a_index[0]], f_a_table[i_a_index[1]], f_a_table[i_a_index[2]], f_a_table[i_a_index[3]]));
+				v_previous = v_gene;
+			} // end for j
+
+			_mm_store_ps(f_a_sum, v_sum);
+
+			for (std::size_t k = 0; k < 4; k++)
+			{
+				*fitnessAt(batch, t + k) = f_a_sum[k];
+			} // end for k
+		} // end for t
+
+		evaluateScalar(batch, distances, ui_full);
+	} // end method evaluateSse41
+
+
+	/// <summary>
+	///          AVX2 kernel, evaluates 8 tours per step, gathering one gene of each tour and then the
+	///          8 matching distances from the table.
+	/// </summary>
+	__attribute__((target("avx2")))
+	static void evaluateAvx2(const TourBatch& batch, const DistanceMatrix& distances)
+	{
+		const std::size_t ui_full = batch.ui_count & ~static_cast<std::size_t>(7);
+		const int i_stride = static_cast<int>(batch.ui_genomeStride);
+		const float* f_a_table = distances.data();
+
+		const __m256i v_offsets = _mm256_setr_epi32(0, i_stride, 2 * i_stride, 3 * i_stride, 4 * i_stride, 5 * i_stride, 6 * i_stride, 7 * i_stride);
+		const std::size_t ui_geneBytes = (batch.e_encoding == GenomeEncoding::index16 ? 2 : 1);
+		const __m256i v_geneMask = _mm256_set1_epi32(ui_geneBytes == 2 ? 0xFFFF : 0xFF);
+		const __m256i v_rowStride = _mm256_set1_epi32(static_cast<int>(distances.stride()));
+		const __m256i v_letterBound = _mm256_set1_epi32('A' - 1);
+		const __m256i v_letterBase = _mm256_set1_epi32('A');
+		const __m256i v_digitBase = _mm256_set1_epi32(22);
+		const bool b_ascii = (batch.e_encoding == GenomeEncoding::ascii);
+
+		alignas(32) float f_a_sum[8];
+
+		for (std::size_t t = 0; t < ui_full; t += 8)
+		{
+			const char* genome = batch.genomes + t * batch.ui_genomeStride;
+			__m256i v_previous = _mm256_set1_epi32(static_cast<int>(distances.origin()));
+			__m256 v_sum = _mm256_setzero_ps();
+
+			for (std::size_t j = 0; j < batch.ui_cities; j++)
+			{
+				__m256i v_gene = _mm256_and_si256(_mm256_i32gather_epi32(reinterpret_cast<const int*>(genome + j * ui_geneBytes), v_offsets, 1), v_geneMask);
+
+				if (b_ascii)
+				{
+					const __m256i v_isLetter = _mm256_cmpgt_epi32(v_gene, v_letterBound);
+					v_gene = _mm256_sub_epi32(v_gene, _mm256_blendv_epi8(v_digitBase, v_letterBase, v_isLetter));
+				} // end if
+
+				const __m256i v_index = _mm256_add_epi32(_mm256_mullo_epi32(v_previous, v_rowStride), v_gene);
+				v_sum = _mm256_add_ps(v_sum, _mm256_i32gather_ps(f_a_table, v_index, 4));
+				v_previous = v_gene;
+			} // end for j
+
+			_mm256_store_ps(f_a_sum, v_sum);
+
+			for (std::size_t k = 0; k < 8; k++)
+			{
+				*fitnessAt(batch, t + k) = f_a_sum[k];
+			} // end for k
+		} // end for t
+
+		evaluateScalar(batch, distances, ui_full);
+	} // end method evaluateAvx2
+
+#endif
+
+#pragma endregion
+
+
+#pragma region Implementations:
+
+	/// <summary>
+	///          Finds the widest instruction set supported by the running CPU.
+	/// </summary>
+	/// <returns>
+	///          The best <see cref="KernelIsa"/> available, never <see cref="KernelIsa::automatic"/>.
+	/// </returns>
+	KernelIsa detectKernelIsa(void) noexcept
+	{
+		#if KERNEL_X86
+			__builtin_cpu_init();
+
+			if (__builtin_cpu_supports("avx2"))
+			{
+				return KernelIsa::avx2;
+			} // end if
+			if (__builtin_cpu_supports("sse4.1"))
+			{
+				return KernelIsa::sse41;
+			} // end if
+		#endif
+
+		return KernelIsa::scalar;
+	} // end method detectKernelIsa
+
+
+	/// <summary>
+	///          Maps a requested instruction set onto one the running CPU supports. Requests for an unsupported
+	///          instruction set fall back to the best supported one.
+	/// </summary>
+	/// <param name="e_isa">
+	///          The requested instruction set.
+	/// </param>
+	/// <returns>
+	///          The instruction set the kernel will actually use.
+	/// </returns>
+	KernelIsa resolveKernelIsa(const KernelIsa e_isa) noexcept
+	{
+		static const KernelIsa e_best = detectKernelIsa();
+
+		if (e_isa == KernelIsa::automatic || static_cast<int>(e_isa) > static_cast<int>(e_best))
+		{
+			return e_best;
+		} // end if
+
+		return e_isa;
+	} // end method resolveKernelIsa
+
+
+	/// <summary>
+	///          Human readable name of <paramref name="e_isa"/>.
+	/// </summary>
+	const char* kernelIsaName(const KernelIsa e_isa) noexcept
+	{
+		switch (e_isa)
+		{
+			case KernelIsa::scalar: return "scalar";
+			case KernelIsa::sse41:  return "sse41";
+			case KernelIsa::avx2:   return "avx2";
+			default:                return "auto";
+		} // end switch
+	} // end method kernelIsaName
+
+
+	/// <summary>
+	///          Parses an instruction set name as printed by <see cref="kernelIsaName"/>.
+	/// </summary>
+	/// <param name="name">
+	///          One of auto, scalar, sse41 or avx2.
+	/// </param>
+	/// <param name="e_isa">
+	///          Output parameter for the parsed instruction set.
+	/// </param>
+	/// <returns>
+	///          true if <paramref name="name"/> is a known instruction set
+	/// </returns>
+	bool parseKernelIsa(const char* name, KernelIsa& e_isa) noexcept
+	{
+		const KernelIsa e_a_all[] = { KernelIsa::automatic, KernelIsa::scalar, KernelIsa::sse41, KernelIsa::avx2 };
+
+		for (const KernelIsa e_candidate : e_a_all)
+		{
+			if (strcmp(name, kernelIsaName(e_candidate)) == 0)
+			{
+				e_isa = e_candidate;
+				return true;
+			} // end if
+		} // end for
+
+		return false;
+	} // end method parseKernelIsa
+
+
+	/// <summary>
+	///          Computes the length of every tour in <paramref name="batch"/>, starting at the (0, 0) origin,
+	///          and stores it in the batch's fitness slots.
+	/// </summary>
+	/// <param name="batch">
+	///          The tours to evaluate.
+	/// </param>
+	/// <param name="distances">
+	///          The distance table built from the city coordinates.
+	/// </param>
+	/// <param name="e_isa">
+	///          Instruction set to use, resolved against the running CPU.
+	/// </param>
+	void evaluateBatch(const TourBatch& batch, const DistanceMatrix& distances, const KernelIsa e_isa)
+	{
+		switch (resolveKernelIsa(e_isa))
+		{
+			#if KERNEL_X86
+				case KernelIsa::avx2:
+					evaluateAvx2(batch, distances);
+					break;
+				case KernelIsa::sse41:
+					evaluateSse41(batch, distances);
+					break;
+			#endif
+			default:
+				evaluateScalar(batch, distances, 0);
+				break;
+		} // end switch
+	} // end method evaluateBatch
+
+
+	/// <summary>
+	///          Evaluates <paramref name="batch"/> with both the scalar reference and the <paramref name="e_isa"/> kernel
+	///          and reports how far they disagree. The batch is left holding the <paramref name="e_isa"/> results.
+	/// </summary>
+	/// <param name="batch">
+	///          The tours to evaluate.
+	/// </param>
+	/// <param name="distances">
+	///          The distance table built from the city coordinates.
+	/// </param>
+	/// <param name="e_isa">
+	///          Instruction set to check against the scalar reference.
+	/// </param>
+	/// <returns>
+	///          The largest relative difference between the two results over all tours.
+	/// </returns>
+	float verifyBatchKernel(const TourBatch& batch, const DistanceMatrix& distances, const KernelIsa e_isa)
+	{
+		std::vector<float> f_v_reference(batch.ui_count);
+		float f_maxError = 0.0f;
+
+		evaluateBatch(batch, distances, KernelIsa::scalar);
+
+		for (std::size_t t = 0; t < batch.ui_count; t++)
+		{
+			f_v_reference[t] = *fitnessAt(batch, t);
+		} // end for t
+
+		evaluateBatch(batch, distances, e_isa);
+
+		for (std::size_t t = 0; t < batch.ui_count; t++)
+		{
+			const float f_error = std::fabs(*fitnessAt(batch, t) - f_v_reference[t]) / (f_v_reference[t] > 0.0f ? f_v_reference[t] : 1.0f);
+
+			f_maxError = (f_error > f_maxError ? f_error : f_maxError);
+		} // end for t
+
+		return f_maxError;
+	} // end method verifyBatchKernel
+
+#pragma endregion
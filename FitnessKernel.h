@@ -0,0 +1,67 @@
+#ifndef _FITNESS_KERNEL_H_
+#define _FITNESS_KERNEL_H_
+
+#pragma region Includes:
+
+	#include <cstddef>          // std::size_t
+	#include "DistanceMatrix.h" // DistanceMatrix
+
+#pragma endregion
+
+
+#pragma region Enums:
+
+	// Instruction set used by the batch fitness kernel.
+	enum class KernelIsa
+	{
+		automatic, // best instruction set supported by the running CPU
+		scalar,    // portable reference loop
+		sse41,     // 4 tours per step, SSE4.1 index math with scalar table loads
+		avx2       // 8 tours per step, AVX2 gathers for genes and distances
+	}; // end enum KernelIsa
+
+
+	// How cities are stored in a genome.
+	enum class GenomeEncoding
+	{
+		ascii,  // alpha-numeric city names ABC...012... as used by Trip::itinerary
+		index,  // city indices 0 .. cities - 1, one byte each
+		index16 // city indices 0 .. cities - 1, two bytes each in native byte order
+	}; // end enum GenomeEncoding
+
+#pragma endregion
+
+
+#pragma region Structs:
+
+	// Strided view of a batch of tours and the place to store their fitness.
+	//
+	// The AVX2 path loads genes with 4-byte gathers, so at least 3 readable bytes must follow the
+	// first byte of the last gene of every genome (true for Trip and for any padded record layout).
+	struct TourBatch
+	{
+		const char*    genomes;          // first gene of the first tour
+		std::size_t    ui_genomeStride;  // bytes between the first genes of consecutive tours
+		float*         fitness;          // fitness of the first tour
+		std::size_t    ui_fitnessStride; // bytes between the fitness values of consecutive tours
+		std::size_t    ui_count;         // number of tours in the batch
+		std::size_t    ui_cities;        // genes per tour
+		GenomeEncoding e_encoding;       // how genes are stored
+	}; // end struct TourBatch
+
+#pragma endregion
+
+
+#pragma region Prototypes:
+
+	KernelIsa detectKernelIsa(void) noexcept;
+	KernelIsa resolveKernelIsa(const KernelIsa e_isa) noexcept;
+	const char* kernelIsaName(const KernelIsa e_isa) noexcept;
+	bool parseKernelIsa(const char* name, KernelIsa& e_isa) noexcept;
+
+	void evaluateBatch(const TourBatch& batch, const DistanceMatrix& distances, const KernelIsa e_isa);
+	float verifyBatchKernel(const TourBatch& batch, const DistanceMatrix& distances, const KernelIsa e_isa);
+
+#pragma endregion
+
+#endif
@@ -0,0 +1,264 @@
+#pragma region Includes:
+
+	#include "Generator.h"   // TourSet, TourSink
+	#include "Random.hpp"    // Xoshiro256, randomBelow
+	#include <omp.h>         // omp directives
+	#include <algorithm>     // std::min, std::swap
+	#include <limits>        // numeric limits
+	#include <stdexcept>     // std::length_error
+	#include <unordered_set> // hash set
+	#include <vector>        // std::vector
+	#include <string.h>      // memcpy
+
+#pragma endregion
+
+
+#pragma region Defines:
+
+	#ifndef GENERATOR_BLOCK
+		#define GENERATOR_BLOCK    1024          // tours drawn from one engine stream
+	#endif
+
+	#ifndef GENERATOR_CHUNK
+		#define GENERATOR_CHUNK    (1 << 16)     // tours handed to the sink at once, multiple of GENERATOR_BLOCK
+	#endif
+
+	#define COORDINATE_RANGE       100           // coordinates are drawn from [0, COORDINATE_RANGE) like initialize does
+
+#pragma endregion
+
+
+#pragma region Implementations:
+
+	/// <summary>
+	///          Allocates a set for <paramref name="ui_expected"/> fingerprints at a load factor of at most 2/3.
+	/// </summary>
+	/// <param name="ui_expected">
+	///          Largest number of fingerprints that will be inserted.
+	/// </param>
+	/// <exception cref="std::bad_alloc">Thrown if the table cannot be allocated.</exception>
+	TourSet::TourSet(const std::size_t ui_expected)
+		: ui_a_slots(nullptr), ui_mask(0)
+	{
+		std::size_t ui_capacity = 64;
+
+		while (ui_capacity < ui_expected + ui_expected / 2)
+		{
+			ui_capacity <<= 1;
+		} // end while
+
+		ui_a_slots.reset(new std::atomic<std::uint64_t>[ui_capacity]);
+		ui_mask = ui_capacity - 1;
+
+		const long long i_capacity = static_cast<long long>(ui_capacity);
+
+		#pragma omp parallel for schedule(static)
+		for (long long i = 0; i < i_capacity; i++)
+		{
+			ui_a_slots[i].store(0, std::memory_order_relaxed);
+		} // end for i
+	} // end constructor
+
+
+	/// <summary>
+	///          Adds <paramref name="ui_fingerprint"/> to the set, safe to call from any number of threads.
+	/// </summary>
+	/// <param name="ui_fingerprint">
+	///          Fingerprint of a genome, see <see cref="fingerprint"/>.
+	/// </param>
+	/// <returns>
+	///          true if the fingerprint was not in the set yet
+	/// </returns>
+	bool TourSet::insert(std::uint64_t ui_fingerprint) noexcept
+	{
+		// 0 marks free slots
+		ui_fingerprint += (ui_fingerprint == 0);
+
+		for (std::size_t i = ui_fingerprint & ui_mask; ; i = (i + 1) & ui_mask)
+		{
+			std::uint64_t ui_current = ui_a_slots[i].load(std::memory_order_relaxed);
+
+			if (ui_current == 0 && ui_a_slots[i].compare_exchange_strong(ui_current, ui_fingerprint, std::memory_order_relaxed))
+			{
+				return true;
+			} // end if
+
+			// either occupied all along or another thread just claimed the slot
+			if (ui_current == ui_fingerprint)
+			{
+				return false;
+			} // end if
+		} // end for i
+	} // end method insert
+
+
+	/// <summary>
+	///          64-bit fingerprint of a genome, hashing its genes eight bytes at a time.
+	/// </summary>
+	/// <param name="genome">
+	///          The genome to hash.
+	/// </param>
+	/// <param name="ui_cities">
+	///          Number of genes.
+	/// </param>
+	/// <returns>
+	///          The fingerprint.
+	/// </returns>
+	std::uint64_t fingerprint(const gene_t* genome, const std::size_t ui_cities) noexcept
+	{
+		const unsigned char* c_a_bytes = reinterpret_cast<const unsigned char*>(genome);
+		const std::size_t ui_bytes = ui_cities * sizeof(gene_t);
+		std::uint64_t ui_hash = 0x9E3779B97F4A7C15ull ^ ui_bytes;
+
+		for (std::size_t i = 0; i < ui_bytes; i += sizeof(std::uint64_t))
+		{
+			std::uint64_t ui_word = 0;
+
+			memcpy(&ui_word, c_a_bytes + i, std::min(sizeof(ui_word), ui_bytes - i));
+
+			ui_hash = (ui_hash ^ ui_word) * 0xBF58476D1CE4E5B9ull;
+			ui_hash ^= ui_hash >> 31;
+		} // end for i
+
+		ui_hash = (ui_hash ^ (ui_hash >> 29)) * 0x94D049BB133111EBull;
+
+		return ui_hash ^ (ui_hash >> 32);
+	} // end method fingerprint
+
+
+	/// <summary>
+	///          Places <paramref name="ui_cities"/> cities on distinct integer coordinates in [0, 100) x [0, 100), the range
+	///          widened for instances too large to fit.
+	/// </summary>
+	/// <param name="coordinates">
+	///          Output array of <paramref name="ui_cities"/> points.
+	/// </param>
+	/// <param name="ui_cities">
+	///          Number of cities.
+	/// </param>
+	/// <param name="ui_seed">
+	///          Seed of the generator, the same seed always places the same cities.
+	/// </param>
+	void generateCoordinates(Point* coordinates, const std::size_t ui_cities, const std::uint64_t ui_seed)
+	{
+		Xoshiro256 engine(ui_seed, 0);
+		std::unordered_set<std::uint64_t> taken;
+		std::uint64_t ui_range = COORDINATE_RANGE;
+
+		while (ui_cities * 2 > ui_range * ui_range)
+		{
+			ui_range *= 2;
+		} // end while
+
+		for (std::size_t i = 0; i < ui_cities; i++)
+		{
+			std::uint64_t ui_x, ui_y;
+
+			do
+			{
+				ui_x = randomBelow(engine, ui_range);
+				ui_y = randomBelow(engine, ui_range);
+			} while (!taken.insert(ui_x * ui_range + ui_y).second);
+
+			coordinates[i] = Point(static_cast<int>(ui_x), static_cast<int>(ui_y));
+		} // end for i
+	} // end method generateCoordinates
+
+
+	/// <summary>
+	///          Generates <paramref name="ui_count"/> distinct random tours through <paramref name="ui_cities"/> cities and
+	///          streams them to <paramref name="sink"/> in chunks, so the population never has to fit in memory.
+	/// </summary>
+	/// <param name="ui_count">
+	///          Number of tours.
+	/// </param>
+	/// <param name="ui_cities">
+	///          Number of cities per tour.
+	/// </param>
+	/// <param name="ui_seed">
+	///          Seed of the generator.
+	/// </param>
+	/// <param name="sink">
+	///          Receives the tours, called from the calling thread only.
+	/// </param>
+	/// <returns>
+	///          Number of duplicate tours that were drawn and replaced.
+	/// </returns>
+	/// <exception cref="std::length_error">Thrown if the genes cannot hold the city indices or there are fewer than
+	///                                     <paramref name="ui_count"/> distinct tours.</exception>
+	/// <remarks>
+	///          Every tour is a Fisher-Yates shuffle. Tours are drawn in blocks of <see cref="GENERATOR_BLOCK"/>, each from an
+	///          engine seeded with the block number, so the output depends on the seed but not on the number of threads;
+	///          only the rare replacement of a duplicate depends on which thread inserted its fingerprint first.
+	/// </remarks>
+	std::size_t generatePopulation(const std::size_t ui_count, const std::size_t ui_cities, const std::uint64_t ui_seed, const TourSink& sink)
+	{
+		if (ui_cities == 0 || ui_cities - 1 > std::numeric_limits<gene_t>::max())
+		{
+			throw std::length_error("city count does not fit the gene type");
+		} // end if
+
+		// small instances may not have enough distinct tours
+		std::uint64_t ui_tours = 1;
+
+		for (std::size_t i = 2; i <= ui_cities && ui_tours < ui_count; i++)
+		{
+			ui_tours *= i;
+		} // end for i
+
+		if (ui_tours < ui_count)
+		{
+			throw std::length_error("population is larger than the number of distinct tours");
+		} // end if
+
+		const std::size_t ui_chunk = std::min<std::size_t>(GENERATOR_CHUNK, roundUp(ui_count, GENERATOR_BLOCK));
+		std::vector<gene_t> g_v_chunk(ui_chunk * ui_cities);
+		TourSet seen(ui_count);
+		std::size_t ui_duplicates = 0;
+
+		for (std::size_t ui_first = 0; ui_first < ui_count; ui_first += ui_chunk)
+		{
+			const std::size_t ui_tourCount = std::min(ui_chunk, ui_count - ui_first);
+			const long long i_blocks = static_cast<long long>((ui_tourCount + GENERATOR_BLOCK - 1) / GENERATOR_BLOCK);
+			gene_t* g_a_chunk = g_v_chunk.data();
+
+			#pragma omp parallel for schedule(static) reduction(+:ui_duplicates)
+			for (long long b = 0; b < i_blocks; b++)
+			{
+				const std::size_t ui_begin = static_cast<std::size_t>(b) * GENERATOR_BLOCK;
+				const std::size_t ui_end = std::min<std::size_t>(ui_begin + GENERATOR_BLOCK, ui_tourCount);
+				Xoshiro256 engine(ui_seed, (ui_first + ui_begin) / GENERATOR_BLOCK + 1);
+
+				for (std::size_t t = ui_begin; t < ui_end; t++)
+				{
+					gene_t* genome = g_a_chunk + t * ui_cities;
+
+					for (std::size_t j = 0; j < ui_cities; j++)
+					{
+						genome[j] = static_cast<gene_t>(j);
+					} // end for j
+
+					while (true)
+					{
+						for (std::size_t j = ui_cities - 1; j > 0; j--)
+						{
+							std::swap(genome[j], genome[randomBelow(engine, j + 1)]);
+						} // end for j
+
+						if (seen.insert(fingerprint(genome, ui_cities)))
+						{
+							break;
+						} // end if
+
+						ui_duplicates++;
+					} // end while
+				} // end for t
+			} // end for b
+
+			sink(g_a_chunk, ui_tourCount, ui_cities);
+		} // end for ui_first
+
+		return ui_duplicates;
+	} // end method generatePopulation
+
+#pragma endregion
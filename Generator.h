@@ -0,0 +1,52 @@
+#ifndef _GENERATOR_H_
+#define _GENERATOR_H_
+
+#pragma region Includes:
+
+	#include <cstddef>      // std::size_t
+	#include <cstdint>      // std::uint64_t
+	#include <atomic>       // std::atomic
+	#include <functional>   // std::function
+	#include <memory>       // std::unique_ptr
+	#include "utility.hpp"  // Point
+	#include "Population.h" // gene_t
+
+#pragma endregion
+
+
+// Concurrent set of 64-bit genome fingerprints, open addressing with linear probing.
+//
+// Sized once for the expected number of tours and never grown; inserts from any number of threads
+// are a compare-and-swap on the probed slot, no locks. Two different tours sharing a fingerprint
+// only makes the second one look like a duplicate, so the set never lets a real duplicate through.
+class TourSet
+{
+public:
+	explicit TourSet(const std::size_t ui_expected);
+
+	TourSet(const TourSet&) = delete;
+	TourSet& operator=(const TourSet&) = delete;
+
+	bool insert(std::uint64_t ui_fingerprint) noexcept;
+
+	inline std::size_t capacity(void) const noexcept { return ui_mask + 1; }
+
+private:
+	std::unique_ptr<std::atomic<std::uint64_t>[]> ui_a_slots; // fingerprints, 0 marks a free slot
+	std::size_t                                   ui_mask;    // capacity - 1, capacity is a power of two
+}; // end class TourSet
+
+
+// Receives the generated tours chunk by chunk, in order: ui_count genomes stored ui_stride genes apart.
+typedef std::function<void(const gene_t* genomes, const std::size_t ui_count, const std::size_t ui_stride)> TourSink;
+
+
+#pragma region Prototypes:
+
+	std::uint64_t fingerprint(const gene_t* genome, const std::size_t ui_cities) noexcept;
+	void generateCoordinates(Point* coordinates, const std::size_t ui_cities, const std::uint64_t ui_seed);
+	std::size_t generatePopulation(const std::size_t ui_count, const std::size_t ui_cities, const std::uint64_t ui_seed, const TourSink& sink);
+
+#pragma endregion
+
+#endif
@@ -0,0 +1,280 @@
+#pragma region Includes:
+
+	#include "Instance.h"       // Instance
+	#include "Trip.h"           // CHROMOSOMES, translateToIndex, translateToCity
+	#include "PopulationFile.h" // MappedPopulationFile
+	#include "Generator.h"      // generatePopulation
+	#include <fstream>          // ifstream
+	#include <limits>           // numeric limits
+	#include <stdexcept>        // std::runtime_error, std::invalid_argument
+	#include <algorithm>        // std::count
+	#include <string.h>         // memcpy
+
+#pragma endregion
+
+
+#pragma region Helpers:
+
+	/// <summary>
+	///          Counts the lines of a text file without parsing them; a last line without a line feed counts too.
+	/// </summary>
+	/// <exception cref="std::runtime_error">Thrown if the file cannot be opened.</exception>
+	static std::size_t countLines(const char* path)
+	{
+		std::ifstream in_file(path, std::ios::in | std::ios::binary);
+		std::vector<char> c_v_block(1 << 20);
+		std::size_t ui_lines = 0;
+		char c_last = '\n';
+
+		if (!in_file.is_open())
+		{
+			throw std::runtime_error(std::string("cannot open ") + path);
+		} // end if
+
+		while (in_file.read(c_v_block.data(), c_v_block.size()) || in_file.gcount() > 0)
+		{
+			const std::streamsize i_read = in_file.gcount();
+
+			ui_lines += static_cast<std::size_t>(std::count(c_v_block.data(), c_v_block.data() + i_read, '\n'));
+			c_last = c_v_block[static_cast<std::size_t>(i_read) - 1];
+		} // end while
+
+		return ui_lines + (c_last != '\n');
+	} // end method countLines
+
+
+	/// <summary>
+	///          Whether <paramref name="population"/> names the binary file source rather than generation.
+	/// </summary>
+	static inline bool isPopulationFile(const std::string& population) noexcept
+	{
+		return !population.empty() && population != RANDOM_POPULATION;
+	} // end method isPopulationFile
+
+#pragma endregion
+
+
+#pragma region Implementations:
+
+	/// <summary>
+	///          Reads the cities of a run and derives its dimensions from the inputs selected by <paramref name="options"/>.
+	/// </summary>
+	/// <param name="options">
+	///          Input files and explicit dimensions from the command line.
+	/// </param>
+	/// <returns>
+	///          The instance to solve.
+	/// </returns>
+	/// <exception cref="std::runtime_error">Thrown if an input cannot be read.</exception>
+	/// <exception cref="std::invalid_argument">Thrown if the inputs and dimensions do not fit together.</exception>
+	Instance loadInstance(const RunOptions& options)
+	{
+		Instance instance;
+		std::size_t ui_available = 0;
+
+		if (isPopulationFile(options.s_populationFile))
+		{
+			// binary files carry their own coordinates
+			const MappedPopulationFile population_file(options.s_populationFile.c_str());
+
+			instance.coordinates.resize(population_file.cities());
+			population_file.coordinates(instance.coordinates.data());
+			ui_available = population_file.population();
+		} // end if
+		else
+		{
+			instance.coordinates = readCities(options.s_citiesFile.c_str());
+
+			if (options.s_populationFile == RANDOM_POPULATION)
+			{
+				ui_available = (options.ui_population > 0 ? options.ui_population : CHROMOSOMES);
+			} // end if
+			else if (instance.cities() > NAMED_CITIES)
+			{
+				throw std::invalid_argument("text chromosome files only name up to 36 cities, use a binary population file or --population=random");
+			} // end elif
+			else
+			{
+				ui_available = countLines(options.s_chromosomeFile.c_str());
+			} // end else
+		} // end else
+
+		instance.ui_population = (options.ui_population > 0 ? options.ui_population : ui_available);
+		instance.ui_offsprings = (options.ui_offsprings > 0 ? options.ui_offsprings : instance.ui_population / 2) & ~static_cast<std::size_t>(1);
+		instance.i_generations = options.i_generations;
+
+		if (instance.cities() < 2 || instance.cities() - 1 > std::numeric_limits<gene_t>::max())
+		{
+			throw std::invalid_argument("an instance needs between 2 and 65536 cities");
+		} // end if
+
+		if (instance.ui_population > ui_available || instance.ui_population > std::numeric_limits<std::uint32_t>::max())
+		{
+			throw std::invalid_argument("the input holds fewer tours than the requested population size");
+		} // end if
+
+		if (instance.ui_offsprings == 0 || instance.ui_offsprings > instance.ui_population)
+		{
+			throw std::invalid_argument("the number of offsprings must be between 2 and the population size");
+		} // end if
+
+		return instance;
+	} // end method loadInstance
+
+
+	/// <summary>
+	///          Fills <paramref name="population"/> with the initial tours: mapped from the binary population file, generated,
+	///          or parsed from the text chromosome file.
+	/// </summary>
+	/// <param name="options">
+	///          Input files of the run.
+	/// </param>
+	/// <param name="instance">
+	///          The instance returned by <see cref="loadInstance"/> for the same <paramref name="options"/>.
+	/// </param>
+	/// <param name="population">
+	///          Population of instance.ui_population tours through instance.cities() cities.
+	/// </param>
+	/// <param name="ui_seed">
+	///          Seed of the generator, only used for generated populations.
+	/// </param>
+	/// <exception cref="std::runtime_error">Thrown if an input cannot be read or is malformed.</exception>
+	void loadPopulation(const RunOptions& options, const Instance& instance, Population& population, const std::uint64_t ui_seed)
+	{
+		if (isPopulationFile(options.s_populationFile))
+		{
+			const MappedPopulationFile population_file(options.s_populationFile.c_str());
+
+			if (!population_file.verify())
+			{
+				throw std::runtime_error(options.s_populationFile + " failed its checksum");
+			} // end if
+
+			population_file.load(population);
+		} // end if
+		else if (options.s_populationFile == RANDOM_POPULATION)
+		{
+			std::size_t ui_next = 0;
+			const std::size_t ui_bytes = instance.cities() * sizeof(gene_t);
+
+			generatePopulation(population.size(), instance.cities(), ui_seed, [&](const gene_t* genomes, const std::size_t ui_count, const std::size_t ui_stride)
+			{
+				for (std::size_t i = 0; i < ui_count; i++)
+				{
+					memcpy(population.genome(ui_next++), genomes + i * ui_stride, ui_bytes);
+				} // end for i
+			});
+		} // end elif
+		else
+		{
+			// chromosome.txt:
+			//   T8JHFKM7BO5XWYSQ29IP04DL6NU3ERVA1CZG
+			//   FWLXU2DRSAQEVYOBCPNI608194ZHJM73GK5T
+			std::ifstream chromosome_file(options.s_chromosomeFile);
+			std::string itinerary;
+
+			for (std::size_t i = 0; i < population.size(); i++)
+			{
+				if (!(chromosome_file >> itinerary) || itinerary.size() != instance.cities())
+				{
+					throw std::runtime_error(options.s_chromosomeFile + " does not hold enough tours through all cities");
+				} // end if
+
+				population.fromNames(i, itinerary.c_str());
+			} // end for i
+		} // end else
+	} // end method loadPopulation
+
+
+	/// <summary>
+	///          Reads a cities file of "name x y" lines. If every name is a distinct alpha-numeric name ABC...012... within the
+	///          city count, the name is the city index like in the original cities.txt; otherwise cities are indexed in file order.
+	/// </summary>
+	/// <param name="path">
+	///          The cities file.
+	/// </param>
+	/// <returns>
+	///          The coordinates by city index.
+	/// </returns>
+	/// <exception cref="std::runtime_error">Thrown if the file cannot be opened.</exception>
+	std::vector<Point> readCities(const char* path)
+	{
+		// cities.txt:
+		// name    x       y
+		// A       83      99
+		// B       77      35
+		std::ifstream cities_file(path);
+		std::vector<std::string> names;
+		std::vector<Point> coordinates;
+		std::string name;
+		int x, y;
+
+		if (!cities_file.is_open())
+		{
+			throw std::runtime_error(std::string("cannot open ") + path);
+		} // end if
+
+		while (cities_file >> name >> x >> y)
+		{
+			names.push_back(name);
+			coordinates.push_back(Point(x, y));
+		} // end while
+
+		if (coordinates.size() > NAMED_CITIES)
+		{
+			return coordinates;
+		} // end if
+
+		std::vector<Point> byName(coordinates.size());
+		std::vector<bool> b_v_seen(coordinates.size(), false);
+
+		for (std::size_t i = 0; i < names.size(); i++)
+		{
+			const std::size_t ui_index = (names[i].size() == 1 ? translateToIndex(names[i][0]) : coordinates.size());
+
+			// not the alpha-numeric naming, keep the file order
+			if (ui_index >= coordinates.size() || b_v_seen[ui_index])
+			{
+				return coordinates;
+			} // end if
+
+			b_v_seen[ui_index] = true;
+			byName[ui_index] = coordinates[i];
+		} // end for i
+
+		return byName;
+	} // end method readCities
+
+
+	/// <summary>
+	///          Printable itinerary: city names for instances of at most 36 cities, dash-separated city indices otherwise.
+	/// </summary>
+	/// <param name="genome">
+	///          The tour.
+	/// </param>
+	/// <param name="ui_cities">
+	///          Number of cities.
+	/// </param>
+	/// <returns>
+	///          The itinerary.
+	/// </returns>
+	std::string formatTour(const gene_t* genome, const std::size_t ui_cities)
+	{
+		std::string itinerary;
+
+		for (std::size_t j = 0; j < ui_cities; j++)
+		{
+			if (ui_cities <= NAMED_CITIES)
+			{
+				itinerary += translateToCity(genome[j]);
+			} // end if
+			else
+			{
+				itinerary += (j > 0 ? "-" : "") + std::to_string(genome[j]);
+			} // end else
+		} // end for j
+
+		return itinerary;
+	} // end method formatTour
+
+#pragma endregion
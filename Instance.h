@@ -0,0 +1,50 @@
+#ifndef _INSTANCE_H_
+#define _INSTANCE_H_
+
+#pragma region Includes:
+
+	#include <cstddef>      // std::size_t
+	#include <cstdint>      // std::uint64_t
+	#include <string>       // std::string
+	#include <vector>       // std::vector
+	#include "utility.hpp"  // Point
+	#include "Population.h" // Population, gene_t
+	#include "RunOptions.h" // RunOptions
+
+#pragma endregion
+
+
+#pragma region Defines:
+
+	#define RANDOM_POPULATION  "random" // --population value that generates the initial tours
+	#define NAMED_CITIES       36       // cities with a one-character name ABC...012...
+
+#pragma endregion
+
+
+// Problem instance of a run: the cities and the dimensions of the GA.
+//
+// The city count comes from the cities file (or the binary population file), the population size from
+// the number of tours in the input; both can be overridden on the command line, as can the number of
+// offsprings and generations. Nothing here depends on the compile-time CHROMOSOMES/CITIES/TOP_X.
+struct Instance
+{
+	std::vector<Point> coordinates;   // (x, y) of every city by index
+	std::size_t        ui_population; // tours in the population
+	std::size_t        ui_offsprings; // tours replaced every generation, even
+	int                i_generations; // generations to run
+
+	inline std::size_t cities(void) const noexcept { return coordinates.size(); }
+}; // end struct Instance
+
+
+#pragma region Prototypes:
+
+	Instance loadInstance(const RunOptions& options);
+	void loadPopulation(const RunOptions& options, const Instance& instance, Population& population, const std::uint64_t ui_seed);
+	std::vector<Point> readCities(const char* path);
+	std::string formatTour(const gene_t* genome, const std::size_t ui_cities);
+
+#pragma endregion
+
+#endif
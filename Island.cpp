@@ -0,0 +1,64 @@
+#pragma region Includes:
+
+	#include "Island.h"   // Mailbox, MigrationTopology
+	#include <string.h>   // strcmp
+
+#pragma endregion
+
+
+#pragma region Implementations:
+
+	/// <summary>
+	///          Creates an empty mailbox for packets of <paramref name="ui_packetGenes"/> genes.
+	/// </summary>
+	/// <exception cref="std::bad_alloc">Thrown if the packets cannot be allocated.</exception>
+	Mailbox::Mailbox(const std::size_t ui_packetGenes)
+		: ui_enqueue(0), ui_dequeue(0), g_v_packets(MAILBOX_PACKETS * ui_packetGenes), ui_packetGenes(ui_packetGenes)
+	{
+		static_assert((MAILBOX_PACKETS & (MAILBOX_PACKETS - 1)) == 0, "MAILBOX_PACKETS must be a power of two");
+
+		for (std::size_t i = 0; i < MAILBOX_PACKETS; i++)
+		{
+			c_a_cells[i].ui_sequence.store(i, std::memory_order_relaxed);
+		} // end for i
+	} // end constructor
+
+
+	/// <summary>
+	///          Name of <paramref name="e_topology"/> as accepted by <see cref="parseMigrationTopology"/>.
+	/// </summary>
+	const char* migrationTopologyName(const MigrationTopology e_topology) noexcept
+	{
+		return (e_topology == MigrationTopology::ring ? "ring" : "random");
+	} // end method migrationTopologyName
+
+
+	/// <summary>
+	///          Parses a migration topology name.
+	/// </summary>
+	/// <param name="name">
+	///          ring or random.
+	/// </param>
+	/// <param name="e_topology">
+	///          Output parameter for the parsed topology.
+	/// </param>
+	/// <returns>
+	///          true if <paramref name="name"/> is a known topology
+	/// </returns>
+	bool parseMigrationTopology(const char* name, MigrationTopology& e_topology) noexcept
+	{
+		const MigrationTopology e_a_all[] = { MigrationTopology::ring, MigrationTopology::random };
+
+		for (const MigrationTopology e_candidate : e_a_all)
+		{
+			if (strcmp(name, migrationTopologyName(e_candidate)) == 0)
+			{
+				e_topology = e_candidate;
+				return true;
+			} // end if
+		} // end for
+
+		return false;
+	} // end method parseMigrationTopology
+
+#pragma endregion
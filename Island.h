@@ -0,0 +1,158 @@
+#ifndef _ISLAND_H_
+#define _ISLAND_H_
+
+#pragma region Includes:
+
+	#include <atomic>       // std::atomic
+	#include <cstddef>      // std::size_t
+	#include <vector>       // std::vector
+	#include "Population.h" // gene_t
+	#include "utility.hpp"  // CACHE_LINE_SIZE
+
+#pragma endregion
+
+
+#pragma region Defines:
+
+	#ifndef MAILBOX_PACKETS
+		#define MAILBOX_PACKETS    4      // migrations a mailbox holds before further ones are dropped, a power of two
+	#endif
+
+#pragma endregion
+
+
+// Which islands an island sends its migrants to.
+enum class MigrationTopology
+{
+	ring,   // island i always sends to island i + 1
+	random  // every migration goes to an island drawn at random
+}; // end enum MigrationTopology
+
+
+// Bounded lock-free queue of migrant packets, the inbox of one island.
+//
+// Any number of islands may post to it while its owner drains it; both sides only ever fail instead of waiting, so an
+// island never blocks on another. Every cell carries a sequence number telling whether it is free for the enqueue
+// position or holds the packet of the dequeue position (Vyukov's bounded queue). A packet is ui_packetGenes genes, the
+// migrants' genomes back to back; the payload is copied in and out by the caller's function while the cell is claimed.
+class Mailbox
+{
+public:
+	explicit Mailbox(const std::size_t ui_packetGenes);
+
+	Mailbox(const Mailbox&) = delete;
+	Mailbox& operator=(const Mailbox&) = delete;
+
+	/// <summary>
+	///          Posts a packet written by <paramref name="fill"/>(gene_t* packet).
+	/// </summary>
+	/// <returns>
+	///          false if the mailbox is full, the packet is dropped without calling <paramref name="fill"/>
+	/// </returns>
+	template<typename Fill>
+	bool push(Fill fill) noexcept
+	{
+		std::size_t ui_position = ui_enqueue.load(std::memory_order_relaxed);
+		Cell* cell;
+
+		for (;;)
+		{
+			cell = &c_a_cells[ui_position & (MAILBOX_PACKETS - 1)];
+			const std::size_t ui_sequence = cell->ui_sequence.load(std::memory_order_acquire);
+			const std::ptrdiff_t i_difference = static_cast<std::ptrdiff_t>(ui_sequence - ui_position);
+
+			if (i_difference == 0)
+			{
+				if (ui_enqueue.compare_exchange_weak(ui_position, ui_position + 1, std::memory_order_relaxed))
+				{
+					break;
+				} // end if
+			} // end if
+			else if (i_difference < 0)
+			{
+				return false;
+			} // end elif
+			else
+			{
+				ui_position = ui_enqueue.load(std::memory_order_relaxed);
+			} // end else
+		} // end for
+
+		fill(packet(ui_position));
+		cell->ui_sequence.store(ui_position + 1, std::memory_order_release);
+
+		return true;
+	} // end template push
+
+	/// <summary>
+	///          Takes the oldest packet and hands it to <paramref name="drain"/>(const gene_t* packet).
+	/// </summary>
+	/// <returns>
+	///          false if the mailbox is empty
+	/// </returns>
+	template<typename Drain>
+	bool pop(Drain drain) noexcept
+	{
+		std::size_t ui_position = ui_dequeue.load(std::memory_order_relaxed);
+		Cell* cell;
+
+		for (;;)
+		{
+			cell = &c_a_cells[ui_position & (MAILBOX_PACKETS - 1)];
+			const std::size_t ui_sequence = cell->ui_sequence.load(std::memory_order_acquire);
+			const std::ptrdiff_t i_difference = static_cast<std::ptrdiff_t>(ui_sequence - (ui_position + 1));
+
+			if (i_difference == 0)
+			{
+				if (ui_dequeue.compare_exchange_weak(ui_position, ui_position + 1, std::memory_order_relaxed))
+				{
+					break;
+				} // end if
+			} // end if
+			else if (i_difference < 0)
+			{
+				return false;
+			} // end elif
+			else
+			{
+				ui_position = ui_dequeue.load(std::memory_order_relaxed);
+			} // end else
+		} // end for
+
+		drain(static_cast<const gene_t*>(packet(ui_position)));
+		cell->ui_sequence.store(ui_position + MAILBOX_PACKETS, std::memory_order_release);
+
+		return true;
+	} // end template pop
+
+private:
+	// Sequence number of one packet, on a cache line of its own.
+	struct Cell
+	{
+		std::atomic<std::size_t> ui_sequence;
+		char c_a_pad[CACHE_LINE_SIZE - sizeof(std::atomic<std::size_t>)];
+	}; // end struct Cell
+
+	inline gene_t* packet(const std::size_t ui_position) noexcept
+	{
+		return g_v_packets.data() + (ui_position & (MAILBOX_PACKETS - 1)) * ui_packetGenes;
+	} // end method packet
+
+	std::atomic<std::size_t> ui_enqueue;                                            // next position to post to
+	char c_a_padEnqueue[CACHE_LINE_SIZE - sizeof(std::atomic<std::size_t>)];
+	std::atomic<std::size_t> ui_dequeue;                                            // next position to take from
+	char c_a_padDequeue[CACHE_LINE_SIZE - sizeof(std::atomic<std::size_t>)];
+	Cell                     c_a_cells[MAILBOX_PACKETS];                            // sequence numbers
+	std::vector<gene_t>      g_v_packets;                                           // MAILBOX_PACKETS packets
+	const std::size_t        ui_packetGenes;                                        // genes per packet
+}; // end class Mailbox
+
+
+#pragma region Prototypes:
+
+	const char* migrationTopologyName(const MigrationTopology e_topology) noexcept;
+	bool parseMigrationTopology(const char* name, MigrationTopology& e_topology) noexcept;
+
+#pragma endregion
+
+#endif
@@ -0,0 +1,146 @@
+// Benchmark of the array-of-Trip layout against the structure-of-arrays Population.
+// usage: bench_layout [#threads] [#generations]
+//
+// Loads chromosome.txt and cities.txt into both layouts and runs the same GA generation on each,
+// reporting the average time per generation spent in every stage.
+
+#pragma region Includes:
+
+	#include <iostream>         // cout
+	#include <iomanip>          // setw
+	#include <fstream>          // ifstream
+	#include <cstdlib>          // atoi
+	#include <vector>           // std::vector
+	#include <omp.h>            // omp_set_num_threads
+	#include "utility.hpp"      // Point, highRes_Clock
+	#include "Trip.h"           // Trip
+	#include "Population.h"     // Population
+	#include "DistanceMatrix.h" // DistanceMatrix
+	#include "Ranking.h"        // rank
+
+#pragma endregion
+
+
+#pragma region External Function Prototypes:
+
+	extern void evaluate(Trip trip[CHROMOSOMES], const DistanceMatrix& distances, const KernelIsa e_isa);
+	extern void select(const Trip trip[CHROMOSOMES], Trip parents[TOP_X]);
+	extern void crossover(Trip parents[TOP_X], Trip offsprings[TOP_X], const DistanceMatrix& distances);
+	extern void mutate(Trip offsprings[TOP_X], const int RATE);
+	extern void populate(Trip trip[CHROMOSOMES], Trip offsprings[TOP_X]);
+
+	extern void evaluate(Population& population, const DistanceMatrix& distances, const KernelIsa e_isa);
+	extern void select(const Population& population, std::uint32_t parents[], const std::size_t ui_parents);
+	extern void crossover(const Population& population, std::uint32_t parents[], Population& offsprings, const DistanceMatrix& distances);
+	extern void mutate(Population& offsprings, const int RATE);
+	extern void populate(Population& population, const Population& offsprings);
+
+#pragma endregion
+
+
+#define STAGES 5 // evaluate, select, crossover, mutate, populate
+
+
+/// <summary>
+///          Microseconds elapsed since <paramref name="start"/>, restarting it.
+/// </summary>
+static double lap(timePoint& start)
+{
+	const timePoint now = highRes_Clock::now();
+	const double d_elapsed = static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(now - start).count());
+
+	start = now;
+	return d_elapsed;
+} // end method lap
+
+
+/// <summary>
+///          Prints one row of average per-generation stage times.
+/// </summary>
+static void report(const char* name, const double d_a_stages[STAGES], const int i_generations)
+{
+	double d_total = 0.0;
+
+	std::cout << std::setw(8) << name;
+
+	for (int i = 0; i < STAGES; i++)
+	{
+		std::cout << std::setw(12) << d_a_stages[i] / i_generations;
+		d_total += d_a_stages[i];
+	} // end for i
+
+	std::cout << std::setw(12) << d_total / i_generations << std::endl;
+} // end method report
+
+
+int main(int argc, char* argv[])
+{
+	const int nThreads = (argc > 1 ? atoi(argv[1]) : 1);
+	const int i_generations = (argc > 2 ? atoi(argv[2]) : 20);
+
+	Trip *trip = new Trip[CHROMOSOMES], *parents = new Trip[TOP_X], *offsprings = new Trip[TOP_X];
+	Population population(CHROMOSOMES, CITIES), children(TOP_X, CITIES);
+	std::vector<std::uint32_t> selected(TOP_X);
+	Point coordinates[CITIES];
+
+	std::ifstream chromosome_file("chromosome.txt");
+	std::ifstream cities_file("cities.txt");
+
+	for (int i = 0; i < CHROMOSOMES; i++)
+	{
+		chromosome_file >> trip[i].itinerary;
+		population.fromNames(i, trip[i].itinerary);
+	} // end for i
+
+	for (int i = 0; i < CITIES; i++)
+	{
+		char city;
+		cities_file >> city;
+		int index = (city >= 'A') ? city - 'A' : city - '0' + 26;
+		cities_file >> coordinates[index].x >> coordinates[index].y;
+	} // end for i
+
+	if (!chromosome_file || !cities_file)
+	{
+		std::cout << "Reading chromosome.txt or cities.txt failed! Exiting ..." << std::endl;
+		delete[] trip;
+		delete[] parents;
+		delete[] offsprings;
+		return EXIT_FAILURE;
+	} // end if
+
+	const DistanceMatrix distances(coordinates, CITIES);
+	double d_a_aos[STAGES] = { 0.0 }, d_a_soa[STAGES] = { 0.0 };
+
+	omp_set_num_threads(nThreads);
+
+	for (int generation = 0; generation < i_generations; generation++)
+	{
+		timePoint start = highRes_Clock::now();
+
+		evaluate(trip, distances, KernelIsa::automatic);   d_a_aos[0] += lap(start);
+		select(trip, parents);                             d_a_aos[1] += lap(start);
+		crossover(parents, offsprings, distances);         d_a_aos[2] += lap(start);
+		mutate(offsprings, MUTATE_RATE);                   d_a_aos[3] += lap(start);
+		populate(trip, offsprings);                        d_a_aos[4] += lap(start);
+
+		evaluate(population, distances, KernelIsa::automatic);
+		rank(population, TOP_X, RankingMode::sort);                     d_a_soa[0] += lap(start);
+		select(population, selected.data(), selected.size());           d_a_soa[1] += lap(start);
+		crossover(population, selected.data(), children, distances);    d_a_soa[2] += lap(start);
+		mutate(children, MUTATE_RATE);                                  d_a_soa[3] += lap(start);
+		populate(population, children);                                d_a_soa[4] += lap(start);
+	} // end for generation
+
+	std::cout << "# threads = " << nThreads << ", " << i_generations << " generations, us per generation" << std::endl;
+	std::cout << std::setw(8) << "layout" << std::setw(12) << "evaluate" << std::setw(12) << "select" << std::setw(12) << "crossover"
+			  << std::setw(12) << "mutate" << std::setw(12) << "populate" << std::setw(12) << "total" << std::endl;
+	report("Trip[]", d_a_aos, i_generations);
+	report("SoA", d_a_soa, i_generations);
+
+	delete[] trip;
+	delete[] parents;
+	delete[] offsprings;
+
+	return EXIT_SUCCESS;
+} // end Main
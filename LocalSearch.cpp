@@ -0,0 +1,417 @@
+#pragma region Includes:
+
+	#include "LocalSearch.h" // NeighborLists, improveTour
+	#include "Profiler.h"    // PROFILE_THREAD, Profiler::now
+	#include <algorithm>     // std::partial_sort, std::reverse, std::rotate, std::min
+	#include <limits>        // std::numeric_limits
+	#include <omp.h>         // omp directives
+
+#pragma endregion
+
+
+#pragma region Defines:
+
+	#define MOVE_EPSILON    1e-4f // least gain a move must bring, keeps rounding noise from cycling
+
+#pragma endregion
+
+
+#pragma region Helpers:
+
+	// Working state of one local search: the tour as a path starting at the origin, the position of every node on it,
+	// and the queue of nodes whose don't-look bit is off.
+	struct LocalSearch
+	{
+		const DistanceMatrix&       distances; // distance table
+		const NeighborLists&        neighbors; // candidate lists
+		std::size_t                 ui_last;   // position of the last city, the number of cities
+		std::vector<std::uint32_t>& path;      // origin then the cities, by position
+		std::vector<std::uint32_t>& position;  // position of every node
+		std::vector<std::uint32_t>& queue;     // ring buffer of nodes to look at
+		std::vector<char>&          queued;    // whether a node is in the queue, its don't-look bit cleared
+		std::size_t                 ui_head;   // next node to take from the queue
+		std::size_t                 ui_count;  // nodes in the queue
+
+		inline float d(const std::size_t ui_from, const std::size_t ui_to) const noexcept { return distances(ui_from, ui_to); }
+
+		// length of the edge leaving position ui_at, the open end of the path has none
+		inline float edgeAfter(const std::size_t ui_at) const noexcept { return (ui_at < ui_last ? d(path[ui_at], path[ui_at + 1]) : 0.0f); }
+
+		inline void push(const std::uint32_t ui_node) noexcept
+		{
+			if (!queued[ui_node])
+			{
+				queued[ui_node] = 1;
+				queue[(ui_head + ui_count++) % queue.size()] = ui_node;
+			} // end if
+		} // end method push
+
+		inline void pushAt(const std::size_t ui_at) noexcept
+		{
+			if (ui_at <= ui_last)
+			{
+				push(path[ui_at]);
+			} // end if
+		} // end method pushAt
+
+		inline void renumber(const std::size_t ui_from, const std::size_t ui_to) noexcept
+		{
+			for (std::size_t k = ui_from; k <= ui_to; k++)
+			{
+				position[path[k]] = static_cast<std::uint32_t>(k);
+			} // end for k
+		} // end method renumber
+
+		// change in length from reversing positions i to j, 1 <= i <= j
+		inline float reverseDelta(const std::size_t i, const std::size_t j) const noexcept
+		{
+			const float f_before = d(path[i - 1], path[i]) + edgeAfter(j);
+			const float f_after = d(path[i - 1], path[j]) + (j < ui_last ? d(path[i], path[j + 1]) : 0.0f);
+
+			return f_after - f_before;
+		} // end method reverseDelta
+
+		bool tryReverse(const std::size_t i, const std::size_t j)
+		{
+			if (reverseDelta(i, j) >= -MOVE_EPSILON)
+			{
+				return false;
+			} // end if
+
+			std::reverse(path.begin() + i, path.begin() + j + 1);
+			renumber(i, j);
+
+			pushAt(i - 1);
+			pushAt(i);
+			pushAt(j);
+			pushAt(j + 1);
+
+			return true;
+		} // end method tryReverse
+
+		bool twoOpt(const std::uint32_t ui_t1);
+		bool orOpt(const std::uint32_t ui_t1);
+		bool moveSegment(const std::size_t ui_start, const std::size_t ui_end);
+	}; // end struct LocalSearch
+
+
+	/// <summary>
+	///          2-opt moves that connect <paramref name="ui_t1"/> to one of its neighbors, replacing its edge to its successor
+	///          or to its predecessor. Neighbors are sorted, so the scan stops at the first one farther away than the edge
+	///          given up.
+	/// </summary>
+	bool LocalSearch::twoOpt(const std::uint32_t ui_t1)
+	{
+		const std::size_t p = position[ui_t1];
+		const std::uint32_t* ui_a_near = neighbors.of(ui_t1);
+
+		if (p < ui_last)
+		{
+			const float f_edge = d(ui_t1, path[p + 1]);
+
+			for (std::size_t k = 0; k < neighbors.width() && d(ui_t1, ui_a_near[k]) < f_edge; k++)
+			{
+				const std::size_t q = position[ui_a_near[k]];
+
+				if ((q > p + 1 && tryReverse(p + 1, q)) || (q < p && tryReverse(q + 1, p)))
+				{
+					return true;
+				} // end if
+			} // end for k
+		} // end if
+
+		if (p > 0)
+		{
+			const float f_edge = d(path[p - 1], ui_t1);
+
+			for (std::size_t k = 0; k < neighbors.width() && d(ui_t1, ui_a_near[k]) < f_edge; k++)
+			{
+				const std::size_t q = position[ui_a_near[k]];
+
+				if ((q > p && tryReverse(p, q - 1)) || (q >= 1 && q + 1 < p && tryReverse(q, p - 1)))
+				{
+					return true;
+				} // end if
+			} // end for k
+		} // end if
+
+		return false;
+	} // end method twoOpt
+
+
+	/// <summary>
+	///          Tries to move the segment at positions <paramref name="ui_start"/> to <paramref name="ui_end"/> next to a
+	///          neighbor of either of its ends, in either orientation.
+	/// </summary>
+	bool LocalSearch::moveSegment(const std::size_t ui_start, const std::size_t ui_end)
+	{
+		const std::uint32_t ui_first = path[ui_start], ui_second = path[ui_end];
+		const std::size_t ui_length = ui_end - ui_start + 1;
+
+		// what taking the segment out saves
+		const float f_removed = d(path[ui_start - 1], ui_first) + edgeAfter(ui_end)
+								- (ui_end < ui_last ? d(path[ui_start - 1], path[ui_end + 1]) : 0.0f);
+
+		for (const std::uint32_t ui_end_node : { ui_first, ui_second })
+		{
+			const std::uint32_t* ui_a_near = neighbors.of(ui_end_node);
+
+			for (std::size_t k = 0; k < neighbors.width() && d(ui_end_node, ui_a_near[k]) < f_removed; k++)
+			{
+				const std::size_t q = position[ui_a_near[k]];
+
+				if (q >= ui_start && q <= ui_end)
+				{
+					continue;
+				} // end if
+
+				// the gap after the neighbor and the one before it
+				for (const std::size_t g : { q, q - 1 })
+				{
+					if (g > ui_last || (g + 1 >= ui_start && g <= ui_end))
+					{
+						continue;
+					} // end if
+
+					const std::uint32_t ui_a = path[g];
+					const float f_bridge = (g < ui_last ? d(ui_a, path[g + 1]) : 0.0f);
+					const float f_forward = d(ui_a, ui_first) + (g < ui_last ? d(ui_second, path[g + 1]) : 0.0f) - f_bridge;
+					const float f_reversed = d(ui_a, ui_second) + (g < ui_last ? d(ui_first, path[g + 1]) : 0.0f) - f_bridge;
+					const bool b_reverse = f_reversed < f_forward;
+
+					if (std::min(f_forward, f_reversed) - f_removed >= -MOVE_EPSILON)
+					{
+						continue;
+					} // end if
+
+					pushAt(ui_start - 1);
+					pushAt(ui_end + 1);
+					pushAt(g);
+					pushAt(g + 1);
+					push(ui_first);
+					push(ui_second);
+
+					if (g > ui_end)
+					{
+						std::rotate(path.begin() + ui_start, path.begin() + ui_end + 1, path.begin() + g + 1);
+
+						if (b_reverse)
+						{
+							std::reverse(path.begin() + g + 1 - ui_length, path.begin() + g + 1);
+						} // end if
+
+						renumber(ui_start, g);
+					} // end if
+					else
+					{
+						std::rotate(path.begin() + g + 1, path.begin() + ui_start, path.begin() + ui_end + 1);
+
+						if (b_reverse)
+						{
+							std::reverse(path.begin() + g + 1, path.begin() + g + 1 + ui_length);
+						} // end if
+
+						renumber(g + 1, ui_end);
+					} // end else
+
+					return true;
+				} // end for g
+			} // end for k
+		} // end for ui_end_node
+
+		return false;
+	} // end method moveSegment
+
+
+	/// <summary>
+	///          Or-opt moves of the segments of up to OR_OPT_SEGMENT cities that start or end at <paramref name="ui_t1"/>.
+	/// </summary>
+	bool LocalSearch::orOpt(const std::uint32_t ui_t1)
+	{
+		const std::size_t p = position[ui_t1];
+
+		if (p == 0)
+		{
+			return false;
+		} // end if
+
+		for (std::size_t ui_length = 1; ui_length <= OR_OPT_SEGMENT; ui_length++)
+		{
+			if (p + ui_length - 1 <= ui_last && moveSegment(p, p + ui_length - 1))
+			{
+				return true;
+			} // end if
+
+			if (ui_length > 1 && p >= ui_length && moveSegment(p - ui_length + 1, p))
+			{
+				return true;
+			} // end if
+		} // end for ui_length
+
+		return false;
+	} // end method orOpt
+
+#pragma endregion
+
+
+#pragma region Implementations:
+
+	/// <summary>
+	///          Collects the nearest nodes of every city and of the origin; the origin is a node like any other here, moves
+	///          only never take it off the front of the path.
+	/// </summary>
+	/// <exception cref="std::bad_alloc">Thrown if the lists cannot be allocated.</exception>
+	NeighborLists::NeighborLists(const DistanceMatrix& distances)
+		: ui_width(std::min<std::size_t>(NEIGHBOR_LIST_SIZE, distances.cities()))
+	{
+		const std::size_t ui_nodes = distances.cities() + 1;
+		std::vector<std::uint32_t> ui_v_others(ui_nodes);
+
+		ui_v_neighbors.resize(ui_nodes * ui_width);
+
+		for (std::size_t i = 0; i < ui_nodes; i++)
+		{
+			const float* f_a_row = distances.row(i);
+			std::size_t ui_others = 0;
+
+			for (std::size_t j = 0; j < ui_nodes; j++)
+			{
+				if (j != i)
+				{
+					ui_v_others[ui_others++] = static_cast<std::uint32_t>(j);
+				} // end if
+			} // end for j
+
+			std::partial_sort(ui_v_others.begin(), ui_v_others.begin() + ui_width, ui_v_others.begin() + ui_others,
+							  [f_a_row](const std::uint32_t a, const std::uint32_t b) { return f_a_row[a] < f_a_row[b]; });
+			std::copy(ui_v_others.begin(), ui_v_others.begin() + ui_width, ui_v_neighbors.begin() + i * ui_width);
+		} // end for i
+	} // end constructor
+
+
+	/// <summary>
+	///          Improves one tour with 2-opt and Or-opt moves until no move between neighbors shortens it. Every move is
+	///          scored in O(1) from the edges it replaces. Nodes start with their don't-look bit cleared; a node whose moves
+	///          all fail gets it set, and the ends of every changed edge get it cleared again.
+	/// </summary>
+	/// <param name="genome">
+	///          The tour, rewritten in place.
+	/// </param>
+	/// <returns>
+	///          How much shorter the tour got.
+	/// </returns>
+	float improveTour(gene_t* genome, const std::size_t ui_cities, const DistanceMatrix& distances, const NeighborLists& neighbors)
+	{
+		thread_local std::vector<std::uint32_t> path, position, queue;
+		thread_local std::vector<char> queued;
+
+		path.resize(ui_cities + 1);
+		position.resize(ui_cities + 1);
+		queue.resize(ui_cities + 1);
+		queued.assign(ui_cities + 1, 0);
+
+		LocalSearch search = { distances, neighbors, ui_cities, path, position, queue, queued, 0, 0 };
+		float f_before = 0.0f, f_after = 0.0f;
+
+		path[0] = static_cast<std::uint32_t>(distances.origin());
+
+		for (std::size_t k = 0; k < ui_cities; k++)
+		{
+			path[k + 1] = genome[k];
+		} // end for k
+
+		search.renumber(0, ui_cities);
+
+		for (std::size_t k = 0; k <= ui_cities; k++)
+		{
+			f_before += search.edgeAfter(k);
+			search.push(path[k]);
+		} // end for k
+
+		while (search.ui_count > 0)
+		{
+			const std::uint32_t ui_node = queue[search.ui_head];
+
+			search.ui_head = (search.ui_head + 1) % queue.size();
+			search.ui_count--;
+			queued[ui_node] = 0;
+
+			if (search.twoOpt(ui_node) || search.orOpt(ui_node))
+			{
+				search.push(ui_node);
+			} // end if
+		} // end while
+
+		for (std::size_t k = 0; k < ui_cities; k++)
+		{
+			genome[k] = static_cast<gene_t>(path[k + 1]);
+			f_after += search.edgeAfter(k);
+		} // end for k
+
+		return f_before - f_after;
+	} // end method improveTour
+
+
+	/// <summary>
+	///          Local search stage: improves an evenly spread <paramref name="d_fraction"/> of <paramref name="offsprings"/>
+	///          with <see cref="improveTour"/>, in parallel. Tours take very different times, so threads take them 16 at a time.
+	/// </summary>
+	/// <param name="d_fraction">
+	///          Share of the offsprings to improve, in (0, 1].
+	/// </param>
+	/// <param name="i_budget">
+	///          Microseconds the stage may take, 0 for no limit. Tours not started by then are left as they are, so a budget
+	///          makes the run depend on timing.
+	/// </param>
+	void improve(Population& offsprings, const DistanceMatrix& distances, const NeighborLists& neighbors, const double d_fraction,
+				 const long long i_budget)
+	{
+		const long long i_size = static_cast<long long>(offsprings.size());
+		const std::uint64_t ui_deadline = (i_budget > 0 ? Profiler::now() + static_cast<std::uint64_t>(i_budget) * 1000
+														: std::numeric_limits<std::uint64_t>::max());
+
+		#pragma omp parallel
+		{
+			PROFILE_THREAD(Stage::localSearch);
+
+			#pragma omp for schedule(dynamic, 16) nowait
+			for (long long i = 0; i < i_size; i++)
+			{
+				improveRange(offsprings, static_cast<std::size_t>(i), 1, distances, neighbors, d_fraction, ui_deadline);
+			} // end for i
+		} // end parallel
+	} // end method improve
+
+
+	/// <summary>
+	///          The local search stage for the <paramref name="ui_count"/> offsprings from slot <paramref name="ui_first"/> on,
+	///          on the calling thread; which tours are picked does not depend on how the offsprings are split.
+	/// </summary>
+	/// <param name="ui_deadline">
+	///          <see cref="Profiler::now"/> after which no further tour is started, the maximum for no limit.
+	/// </param>
+	void improveRange(Population& offsprings, const std::size_t ui_first, const std::size_t ui_count, const DistanceMatrix& distances,
+					  const NeighborLists& neighbors, const double d_fraction, const std::uint64_t ui_deadline)
+	{
+		const std::size_t ui_cities = offsprings.cities();
+		const bool b_budget = (ui_deadline != std::numeric_limits<std::uint64_t>::max());
+
+		for (std::size_t ui_slot = ui_first; ui_slot < ui_first + ui_count; ui_slot++)
+		{
+			// tour i is picked when the running share crosses a whole number
+			const bool b_picked = static_cast<long long>((ui_slot + 1) * d_fraction) > static_cast<long long>(ui_slot * d_fraction);
+
+			if (b_picked && (!b_budget || Profiler::now() < ui_deadline))
+			{
+				const float f_gain = improveTour(offsprings.genome(ui_slot), ui_cities, distances, neighbors);
+
+				// a scored tour stays scored, the moves know exactly what they saved
+				if (offsprings.scored(ui_slot))
+				{
+					offsprings.score(ui_slot, offsprings.fitness(ui_slot) - f_gain);
+				} // end if
+			} // end if
+		} // end for ui_slot
+	} // end method improveRange
+
+#pragma endregion
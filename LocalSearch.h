@@ -0,0 +1,57 @@
+#ifndef _LOCAL_SEARCH_H_
+#define _LOCAL_SEARCH_H_
+
+#pragma region Includes:
+
+	#include <cstddef>          // std::size_t
+	#include <cstdint>          // std::uint32_t, std::uint64_t
+	#include <vector>           // std::vector
+	#include "DistanceMatrix.h" // DistanceMatrix
+	#include "Population.h"     // Population, gene_t
+
+#pragma endregion
+
+
+#pragma region Defines:
+
+	#ifndef NEIGHBOR_LIST_SIZE
+		#define NEIGHBOR_LIST_SIZE    8     // nearest cities a move may connect a city to
+	#endif
+
+	#ifndef OR_OPT_SEGMENT
+		#define OR_OPT_SEGMENT    3     // longest segment an Or-opt move relocates
+	#endif
+
+#pragma endregion
+
+
+// The NEIGHBOR_LIST_SIZE nearest cities of every city, closest first. Built once per run from the distance table
+// and only read afterwards, so any number of threads may share it.
+class NeighborLists
+{
+public:
+	explicit NeighborLists(const DistanceMatrix& distances);
+
+	NeighborLists(const NeighborLists&) = delete;
+	NeighborLists& operator=(const NeighborLists&) = delete;
+
+	inline const std::uint32_t* of(const std::size_t ui_city) const noexcept { return ui_v_neighbors.data() + ui_city * ui_width; }
+	inline std::size_t          width(void) const noexcept                   { return ui_width; }
+
+private:
+	std::vector<std::uint32_t> ui_v_neighbors; // ui_width cities per city
+	std::size_t                ui_width;       // neighbors per city, NEIGHBOR_LIST_SIZE or fewer on tiny instances
+}; // end class NeighborLists
+
+
+#pragma region Prototypes:
+
+	float improveTour(gene_t* genome, const std::size_t ui_cities, const DistanceMatrix& distances, const NeighborLists& neighbors);
+	void improve(Population& offsprings, const DistanceMatrix& distances, const NeighborLists& neighbors, const double d_fraction,
+				 const long long i_budget);
+	void improveRange(Population& offsprings, const std::size_t ui_first, const std::size_t ui_count, const DistanceMatrix& distances,
+					  const NeighborLists& neighbors, const double d_fraction, const std::uint64_t ui_deadline);
+
+#pragma endregion
+
+#endif
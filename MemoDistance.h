@@ -0,0 +1,36 @@
+#ifndef _MEMO_DISTANCE_H_
+#define _MEMO_DISTANCE_H_
+
+#pragma region Includes:
+
+	#include <cstddef>     // std::size_t
+	#include "utility.hpp" // Point
+
+#pragma endregion
+
+
+#pragma region Prototypes:
+
+	float distanceV2(const Point& p1, const Point& p2);
+
+#pragma endregion
+
+
+// Index-addressed view of the memoized distanceV2 lookup, so the operators can be written once against
+// the same (from, to) interface as DistanceMatrix. Index ui_cities is the (0, 0) origin.
+struct MemoDistance
+{
+	const Point* coordinates;
+	std::size_t  ui_cities;
+
+	inline float operator()(const std::size_t ui_from, const std::size_t ui_to) const
+	{
+		static const Point origin(0, 0);
+
+		return distanceV2(ui_from < ui_cities ? coordinates[ui_from] : origin, ui_to < ui_cities ? coordinates[ui_to] : origin);
+	} // end operator ()
+
+	inline std::size_t origin(void) const noexcept { return ui_cities; }
+}; // end struct MemoDistance
+
+#endif
@@ -0,0 +1,220 @@
+// Benchmark of memory bandwidth by NUMA node, thread count and page placement.
+// usage: bench_memory [MiB per array] [repetitions]
+//
+// Pins a team to the CPUs of one node at a time, growing it from one thread to the whole node, and times a read
+// sweep and a triad (a = b + s * c) over arrays first touched by the team itself, so the scaling of each socket on
+// its own memory shows. With more than one node it repeats every node's full team on pages touched from the next
+// node, and runs all CPUs spread over the nodes once with pages touched by their own threads and once with pages
+// touched by the master thread alone, the placement a serially initialized population gets.
+// Every figure is the best of the repetitions, in GB/s of array data read and written.
+
+#pragma region Includes:
+
+	#include <iostream>         // cout
+	#include <iomanip>          // setw, setprecision
+	#include <algorithm>        // std::min
+	#include <cstdlib>          // atoi
+	#include <string>           // std::string, std::to_string
+	#include <vector>           // std::vector
+	#include <omp.h>            // omp_get_thread_num
+	#include "utility.hpp"      // alignedAlloc, highRes_Clock
+	#include "Affinity.h"       // NumaTopology, pinThread
+
+#pragma endregion
+
+
+#pragma region Defines:
+
+	#define MEMORY_MIB           256   // default MiB per array, well beyond the last level cache
+	#define MEMORY_REPETITIONS   5     // default timed sweeps per row
+	#define MEMORY_SCALAR        3.0   // factor of the triad
+
+#pragma endregion
+
+
+// Where the pages of a row's arrays are first touched.
+enum class Touch
+{
+	local,  // by the team that sweeps them, each thread its own static share
+	remote, // by one thread on another node
+	serial  // by the master thread alone
+}; // end enum Touch
+
+
+static double d_sink = 0.0; // keeps the read sweeps from being optimized away
+
+
+/// <summary>
+///          Pins the threads of a team of <paramref name="i_threads"/> to <paramref name="i_v_cpus"/> in turn.
+/// </summary>
+static void pinTeam(const std::vector<int>& i_v_cpus, const int i_threads)
+{
+	#pragma omp parallel num_threads(i_threads)
+	{
+		pinThread(i_v_cpus[static_cast<std::size_t>(omp_get_thread_num()) % i_v_cpus.size()]);
+	} // end parallel
+} // end method pinTeam
+
+
+/// <summary>
+///          Fills <paramref name="d_a_array"/>, with a team of <paramref name="i_threads"/> splitting it statically.
+/// </summary>
+static void fill(double* d_a_array, const long long i_count, const double d_value, const int i_threads)
+{
+	#pragma omp parallel for schedule(static) num_threads(i_threads)
+	for (long long i = 0; i < i_count; i++)
+	{
+		d_a_array[i] = d_value;
+	} // end for i
+} // end method fill
+
+
+/// <summary>
+///          Times <paramref name="i_repetitions"/> read sweeps of b and triads, giving the seconds of the fastest of each.
+/// </summary>
+static void sweep(double* d_a_a, const double* d_a_b, const double* d_a_c, const long long i_count, const int i_threads,
+				  const int i_repetitions, double& d_read, double& d_triad)
+{
+	d_read = d_triad = 1e30;
+
+	// the first round is a warm-up
+	for (int r = 0; r <= i_repetitions; r++)
+	{
+		double d_sum = 0.0;
+		timePoint start = highRes_Clock::now();
+
+		#pragma omp parallel for schedule(static) num_threads(i_threads) reduction(+:d_sum)
+		for (long long i = 0; i < i_count; i++)
+		{
+			d_sum += d_a_b[i];
+		} // end for i
+
+		timePoint end = highRes_Clock::now();
+		d_sink += d_sum;
+
+		if (r > 0)
+		{
+			d_read = std::min(d_read, std::chrono::duration<double>(end - start).count());
+		} // end if
+
+		start = highRes_Clock::now();
+
+		#pragma omp parallel for schedule(static) num_threads(i_threads)
+		for (long long i = 0; i < i_count; i++)
+		{
+			d_a_a[i] = d_a_b[i] + MEMORY_SCALAR * d_a_c[i];
+		} // end for i
+
+		end = highRes_Clock::now();
+		d_sink += d_a_a[i_count / 2];
+
+		if (r > 0)
+		{
+			d_triad = std::min(d_triad, std::chrono::duration<double>(end - start).count());
+		} // end if
+	} // end for r
+} // end method sweep
+
+
+/// <summary>
+///          Allocates and places the arrays of one row, times them on a team pinned to <paramref name="i_v_team"/> and
+///          prints the row.
+/// </summary>
+/// <param name="i_toucher">
+///          CPU the remote and serial placements touch the pages from.
+/// </param>
+static void measure(const std::string& s_label, const std::vector<int>& i_v_team, const int i_threads, const Touch e_touch,
+					const int i_toucher, const long long i_count, const int i_repetitions)
+{
+	const std::size_t ui_bytes = static_cast<std::size_t>(i_count) * sizeof(double);
+	double* d_a_a = static_cast<double*>(alignedAlloc(ui_bytes));
+	double* d_a_b = static_cast<double*>(alignedAlloc(ui_bytes));
+	double* d_a_c = static_cast<double*>(alignedAlloc(ui_bytes));
+	double d_read = 0.0, d_triad = 0.0;
+
+	if (e_touch == Touch::local)
+	{
+		pinTeam(i_v_team, i_threads);
+		fill(d_a_a, i_count, 0.0, i_threads);
+		fill(d_a_b, i_count, 1.0, i_threads);
+		fill(d_a_c, i_count, 2.0, i_threads);
+	} // end if
+	else
+	{
+		// a team of one is the master thread, the only one that touches the pages
+		pinTeam(std::vector<int>(1, i_toucher), 1);
+		fill(d_a_a, i_count, 0.0, 1);
+		fill(d_a_b, i_count, 1.0, 1);
+		fill(d_a_c, i_count, 2.0, 1);
+		pinTeam(i_v_team, i_threads);
+	} // end else
+
+	sweep(d_a_a, d_a_b, d_a_c, i_count, i_threads, i_repetitions, d_read, d_triad);
+
+	std::cout << std::setw(10) << s_label
+			  << std::setw(8) << (e_touch == Touch::local ? "local" : e_touch == Touch::remote ? "remote" : "serial")
+			  << std::setw(9) << i_threads
+			  << std::setw(12) << std::fixed << std::setprecision(2) << ui_bytes / d_read / 1e9
+			  << std::setw(12) << 3 * ui_bytes / d_triad / 1e9 << std::endl;
+
+	alignedFree(d_a_a);
+	alignedFree(d_a_b);
+	alignedFree(d_a_c);
+} // end method measure
+
+
+int main(int argc, char* argv[])
+{
+	const long long i_mib = (argc > 1 ? atoi(argv[1]) : MEMORY_MIB);
+	const int i_repetitions = (argc > 2 ? atoi(argv[2]) : MEMORY_REPETITIONS);
+
+	if (i_mib <= 0 || i_repetitions <= 0)
+	{
+		std::cout << "usage: bench_memory [MiB per array] [repetitions]" << std::endl;
+		return EXIT_FAILURE;
+	} // end if
+
+	const long long i_count = i_mib * 1024 * 1024 / static_cast<long long>(sizeof(double));
+	const NumaTopology topology;
+
+	std::cout << topology.nodes() << " NUMA node(s), " << i_mib << " MiB per array, best of " << i_repetitions << std::endl;
+	std::cout << std::setw(10) << "cpus" << std::setw(8) << "touch" << std::setw(9) << "threads"
+			  << std::setw(12) << "read GB/s" << std::setw(12) << "triad GB/s" << std::endl;
+
+	// per-socket scaling: 1, 2, 4, ... threads and then the whole node
+	for (std::size_t n = 0; n < topology.nodes(); n++)
+	{
+		const std::vector<int>& i_v_cpus = topology.cpus(n);
+		const int i_width = static_cast<int>(i_v_cpus.size());
+
+		for (int t = 1; t < i_width * 2; t *= 2)
+		{
+			measure("node " + std::to_string(n), i_v_cpus, std::min(t, i_width), Touch::local, i_v_cpus[0], i_count, i_repetitions);
+		} // end for t
+	} // end for n
+
+	if (topology.nodes() > 1)
+	{
+		for (std::size_t n = 0; n < topology.nodes(); n++)
+		{
+			const std::vector<int>& i_v_cpus = topology.cpus(n);
+
+			measure("node " + std::to_string(n), i_v_cpus, static_cast<int>(i_v_cpus.size()), Touch::remote,
+					topology.cpus((n + 1) % topology.nodes())[0], i_count, i_repetitions);
+		} // end for n
+
+		std::size_t ui_cpus = 0;
+
+		for (std::size_t n = 0; n < topology.nodes(); n++)
+		{
+			ui_cpus += topology.cpus(n).size();
+		} // end for n
+
+		const std::vector<int> i_v_spread = topology.placement(AffinityPolicy::spread, ui_cpus);
+
+		measure("spread", i_v_spread, static_cast<int>(i_v_spread.size()), Touch::local, i_v_spread[0], i_count, i_repetitions);
+		measure("spread", i_v_spread, static_cast<int>(i_v_spread.size()), Touch::serial, i_v_spread[0], i_count, i_repetitions);
+	} // end if
+
+	return (d_sink != 0.0 ? EXIT_SUCCESS : EXIT_FAILURE);
+} // end Main
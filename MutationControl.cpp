@@ -0,0 +1,249 @@
+#pragma region Includes:
+
+	#include "MutationControl.h" // MutationController, DiversityMetrics
+	#include <algorithm>         // std::sort, std::min, std::max
+	#include <cmath>             // std::log, std::sqrt, std::lround
+	#include <string.h>          // strcmp
+
+#pragma endregion
+
+
+#pragma region Helpers:
+
+	/// <summary>
+	///          64-bit FNV-1a hash of the first <paramref name="ui_cities"/> genes of <paramref name="genome"/>.
+	/// </summary>
+	static std::uint64_t hashGenome(const gene_t* genome, const std::size_t ui_cities) noexcept
+	{
+		std::uint64_t ui_hash = 0xCBF29CE484222325ull;
+
+		for (std::size_t j = 0; j < ui_cities; j++)
+		{
+			ui_hash = (ui_hash ^ genome[j]) * 0x100000001B3ull;
+		} // end for j
+
+		return ui_hash;
+	} // end method hashGenome
+
+
+	/// <summary>
+	///          Clamps <paramref name="d_value"/> to [0, 1].
+	/// </summary>
+	static double unit(const double d_value) noexcept
+	{
+		return std::min(1.0, std::max(0.0, d_value));
+	} // end method unit
+
+#pragma endregion
+
+
+#pragma region Implementations:
+
+	/// <summary>
+	///          Measures the diversity of <paramref name="population"/>: mean and spread of all fitness values, and over
+	///          <paramref name="ui_sample"/> genomes taken at even slot distances, the entropy of every city's successor
+	///          and the share of duplicate genomes by hash. Costs O(size + sample * cities * log sample) and no random draws.
+	/// </summary>
+	/// <param name="population">
+	///          A scored population, its keys hold the fitness values.
+	/// </param>
+	/// <param name="ui_v_successors">
+	///          Scratch space, reused between calls.
+	/// </param>
+	/// <param name="ui_v_hashes">
+	///          Scratch space, reused between calls.
+	/// </param>
+	DiversityMetrics measureDiversity(const Population& population, const std::size_t ui_sample, std::vector<std::uint32_t>& ui_v_successors,
+									  std::vector<std::uint64_t>& ui_v_hashes)
+	{
+		const std::size_t ui_size = population.size();
+		const std::size_t ui_cities = population.cities();
+		const std::size_t ui_tours = std::min(ui_sample, ui_size);
+		const Population::Key* keys = population.keys();
+		DiversityMetrics metrics;
+
+		if (ui_size == 0 || ui_cities == 0)
+		{
+			return metrics;
+		} // end if
+
+		double d_sum = 0, d_squares = 0;
+
+		for (std::size_t i = 0; i < ui_size; i++)
+		{
+			d_sum += keys[i].fitness;
+			d_squares += static_cast<double>(keys[i].fitness) * keys[i].fitness;
+		} // end for i
+
+		metrics.d_fitnessMean = d_sum / ui_size;
+		metrics.d_fitnessStdDev = std::sqrt(std::max(0.0, d_squares / ui_size - metrics.d_fitnessMean * metrics.d_fitnessMean));
+
+		// successors laid out city by city, ui_cities stands for the end of the path
+		ui_v_successors.resize(ui_cities * ui_tours);
+		ui_v_hashes.resize(ui_tours);
+
+		for (std::size_t s = 0; s < ui_tours; s++)
+		{
+			const gene_t* genome = population.genome(s * ui_size / ui_tours);
+
+			for (std::size_t j = 0; j < ui_cities; j++)
+			{
+				ui_v_successors[(genome[j] % ui_cities) * ui_tours + s] = static_cast<std::uint32_t>(j + 1 < ui_cities ? genome[j + 1] : ui_cities);
+			} // end for j
+
+			ui_v_hashes[s] = hashGenome(genome, ui_cities);
+		} // end for s
+
+		if (ui_tours > 1)
+		{
+			const double d_maxEntropy = std::log(static_cast<double>(std::min(ui_tours, ui_cities)));
+			double d_entropy = 0;
+
+			for (std::size_t c = 0; c < ui_cities; c++)
+			{
+				std::uint32_t* successors = ui_v_successors.data() + c * ui_tours;
+				std::size_t ui_run = 1;
+
+				std::sort(successors, successors + ui_tours);
+
+				for (std::size_t s = 1; s <= ui_tours; s++)
+				{
+					if (s < ui_tours && successors[s] == successors[s - 1])
+					{
+						ui_run++;
+					} // end if
+					else
+					{
+						const double d_p = static_cast<double>(ui_run) / ui_tours;
+
+						d_entropy -= d_p * std::log(d_p);
+						ui_run = 1;
+					} // end else
+				} // end for s
+			} // end for c
+
+			metrics.d_edgeEntropy = (d_maxEntropy > 0 ? d_entropy / (ui_cities * d_maxEntropy) : 1.0);
+
+			std::sort(ui_v_hashes.begin(), ui_v_hashes.end());
+
+			std::size_t ui_duplicates = 0;
+
+			for (std::size_t s = 0; s < ui_tours; s++)
+			{
+				ui_duplicates += ((s > 0 && ui_v_hashes[s] == ui_v_hashes[s - 1]) || (s + 1 < ui_tours && ui_v_hashes[s] == ui_v_hashes[s + 1]));
+			} // end for s
+
+			metrics.d_duplicateRate = static_cast<double>(ui_duplicates) / ui_tours;
+		} // end if
+
+		const double d_spread = (metrics.d_fitnessMean > 0 ? metrics.d_fitnessStdDev / metrics.d_fitnessMean / DIVERSITY_CV_SCALE : 1.0);
+
+		metrics.d_diversity = std::min(unit(d_spread), std::min(unit(metrics.d_edgeEntropy), 1.0 - metrics.d_duplicateRate));
+
+		return metrics;
+	} // end method measureDiversity
+
+
+	/// <summary>
+	///          Creates a controller starting at <paramref name="i_baseRate"/>.
+	/// </summary>
+	/// <param name="d_target">
+	///          Diversity, 0 to 1, the adaptive schedule keeps the base rate above.
+	/// </param>
+	MutationController::MutationController(const MutationSchedule e_schedule, const int i_baseRate, const double d_target)
+		: e_schedule(e_schedule), i_baseRate(std::min(100, std::max(0, i_baseRate))), d_target(d_target), i_rate(this->i_baseRate),
+		  i_inversionShare(e_schedule == MutationSchedule::adaptive ? MAX_INVERSION_SHARE : 0), d_pressure(0)
+	{
+	} // end constructor
+
+
+	/// <summary>
+	///          Sets the rate and operator mix for the offsprings of <paramref name="i_generation"/>.
+	/// </summary>
+	/// <param name="population">
+	///          The generation, just ranked.
+	/// </param>
+	void MutationController::update(const int i_generation, const Population& population)
+	{
+		switch (e_schedule)
+		{
+			case MutationSchedule::fixed:
+				i_rate = i_baseRate;
+				break;
+
+			case MutationSchedule::ramp:
+				i_rate = std::min(20 * (i_generation / 20), 99);
+				break;
+
+			case MutationSchedule::adaptive:
+			{
+				diversity = measureDiversity(population, DIVERSITY_SAMPLE, ui_v_successors, ui_v_hashes);
+
+				const double d_shortfall = (d_target > 0 ? unit((d_target - diversity.d_diversity) / d_target) : 0.0);
+
+				d_pressure = (i_generation == 0 ? d_shortfall : d_pressure + DIVERSITY_SMOOTHING * (d_shortfall - d_pressure));
+				i_rate = i_baseRate + static_cast<int>(std::lround((100 - i_baseRate) * d_pressure));
+				i_inversionShare = static_cast<int>(std::lround(MAX_INVERSION_SHARE * (1.0 - d_pressure)));
+				break;
+			} // end case adaptive
+		} // end switch
+	} // end method update
+
+
+	/// <summary>
+	///          Continues from the state of a checkpoint, as read from <see cref="rate"/>, <see cref="inversionShare"/>
+	///          and <see cref="pressure"/> when it was taken.
+	/// </summary>
+	void MutationController::restore(const int i_rate, const int i_inversionShare, const double d_pressure) noexcept
+	{
+		this->i_rate = i_rate;
+		this->i_inversionShare = i_inversionShare;
+		this->d_pressure = d_pressure;
+	} // end method restore
+
+
+	/// <summary>
+	///          Name of <paramref name="e_schedule"/> as accepted by <see cref="parseMutationSchedule"/>.
+	/// </summary>
+	const char* mutationScheduleName(const MutationSchedule e_schedule) noexcept
+	{
+		switch (e_schedule)
+		{
+			case MutationSchedule::fixed:    return "fixed";
+			case MutationSchedule::ramp:     return "ramp";
+			case MutationSchedule::adaptive: return "adaptive";
+		} // end switch
+
+		return "unknown";
+	} // end method mutationScheduleName
+
+
+	/// <summary>
+	///          Parses a mutation schedule name.
+	/// </summary>
+	/// <param name="name">
+	///          fixed, ramp or adaptive.
+	/// </param>
+	/// <param name="e_schedule">
+	///          Output parameter for the parsed schedule.
+	/// </param>
+	/// <returns>
+	///          true if <paramref name="name"/> is a known schedule
+	/// </returns>
+	bool parseMutationSchedule(const char* name, MutationSchedule& e_schedule) noexcept
+	{
+		const MutationSchedule e_a_all[] = { MutationSchedule::fixed, MutationSchedule::ramp, MutationSchedule::adaptive };
+
+		for (const MutationSchedule e_candidate : e_a_all)
+		{
+			if (strcmp(name, mutationScheduleName(e_candidate)) == 0)
+			{
+				e_schedule = e_candidate;
+				return true;
+			} // end if
+		} // end for
+
+		return false;
+	} // end method parseMutationSchedule
+
+#pragma endregion
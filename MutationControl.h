@@ -0,0 +1,97 @@
+#ifndef _MUTATION_CONTROL_H_
+#define _MUTATION_CONTROL_H_
+
+#pragma region Includes:
+
+	#include <cstddef>      // std::size_t
+	#include <cstdint>      // std::uint64_t
+	#include <vector>       // std::vector
+	#include "Population.h" // Population, gene_t
+
+#pragma endregion
+
+
+#pragma region Defines:
+
+	#ifndef DIVERSITY_SAMPLE
+		#define DIVERSITY_SAMPLE    256   // tours the entropy and duplicate measurements look at per generation
+	#endif
+
+	#ifndef DIVERSITY_CV_SCALE
+		#define DIVERSITY_CV_SCALE    0.05  // coefficient of variation of the fitness counted as fully diverse
+	#endif
+
+	#ifndef DIVERSITY_SMOOTHING
+		#define DIVERSITY_SMOOTHING    0.3   // weight of the newest measurement in the controller's pressure
+	#endif
+
+	#ifndef MAX_INVERSION_SHARE
+		#define MAX_INVERSION_SHARE    50    // % of mutations that reverse a segment while the population is diverse
+	#endif
+
+#pragma endregion
+
+
+// How the mutation rate develops over a run.
+enum class MutationSchedule
+{
+	fixed,    // the rate given on the command line throughout
+	ramp,     // 0% at first, 20 points more every 20 generations up to 99%
+	adaptive  // the given rate while the population is diverse, raised towards 100% as it collapses
+}; // end enum MutationSchedule
+
+
+// Cheap diversity measurements of a population, see measureDiversity.
+struct DiversityMetrics
+{
+	double d_fitnessMean   = 0; // mean tour length
+	double d_fitnessStdDev = 0; // standard deviation of the tour lengths
+	double d_edgeEntropy   = 1; // mean entropy of a city's successor over the sample, 0 all alike to 1 all different
+	double d_duplicateRate = 0; // share of sampled genomes identical to another sampled genome
+	double d_diversity     = 1; // the lowest of the three signals, 0 collapsed to 1 diverse
+}; // end struct DiversityMetrics
+
+
+// Chooses the mutation rate and the share of segment inversions among mutations every generation.
+//
+// The adaptive schedule measures the ranked population, turns the distance of its diversity below the target into
+// a pressure between 0 and 1, smoothed over a few generations, and mutates at
+//     rate = base + (100 - base) * pressure,   inversions = MAX_INVERSION_SHARE * (1 - pressure).
+// A diverse population thus evolves at the command line's rate with a mix of swaps and 2-opt style inversions; a
+// collapsing one gets mutated harder and with swaps alone, which change twice as many edges.
+class MutationController
+{
+public:
+	MutationController(const MutationSchedule e_schedule, const int i_baseRate, const double d_target);
+
+	void update(const int i_generation, const Population& population);
+	void restore(const int i_rate, const int i_inversionShare, const double d_pressure) noexcept;
+
+	inline int                     rate(void) const noexcept           { return i_rate; }
+	inline int                     inversionShare(void) const noexcept { return i_inversionShare; }
+	inline double                  pressure(void) const noexcept       { return d_pressure; }
+	inline const DiversityMetrics& metrics(void) const noexcept        { return diversity; }
+
+private:
+	MutationSchedule           e_schedule;       // how the rate develops
+	int                        i_baseRate;       // rate of the command line
+	double                     d_target;         // diversity below which the pressure builds up
+	int                        i_rate;           // current mutation rate in %
+	int                        i_inversionShare; // current % of mutations that reverse a segment
+	double                     d_pressure;       // smoothed shortfall of diversity, 0 to 1
+	DiversityMetrics           diversity;        // last measurement
+	std::vector<std::uint32_t> ui_v_successors;  // scratch: successor of every city in every sampled tour
+	std::vector<std::uint64_t> ui_v_hashes;      // scratch: hash of every sampled genome
+}; // end class MutationController
+
+
+#pragma region Prototypes:
+
+	DiversityMetrics measureDiversity(const Population& population, const std::size_t ui_sample, std::vector<std::uint32_t>& ui_v_successors,
+									  std::vector<std::uint64_t>& ui_v_hashes);
+	const char* mutationScheduleName(const MutationSchedule e_schedule) noexcept;
+	bool parseMutationSchedule(const char* name, MutationSchedule& e_schedule) noexcept;
+
+#pragma endregion
+
+#endif
@@ -0,0 +1,235 @@
+#pragma region Includes:
+
+	#include "Pipeline.h"    // GenerationPipeline, PipelineMode
+	#include "RunOptions.h"  // RunOptions, DistanceMode
+	#include "Profiler.h"    // PROFILE_THREAD, Profiler::now
+	#include <omp.h>         // omp_get_max_threads
+	#include <algorithm>     // std::min, std::max
+	#include <limits>        // std::numeric_limits
+	#include <stdexcept>     // std::invalid_argument
+	#include <string>        // std::to_string
+	#include <string.h>      // strcmp
+
+#pragma endregion
+
+
+#pragma region External Function Prototypes:
+
+	extern void selectRange(const Population& population, const std::size_t ui_offset, const std::size_t ui_begin, const std::size_t ui_end,
+							std::uint32_t winners[], const std::size_t ui_winners, std::uint32_t available[], Xoshiro256& engine);
+	extern void crossoverRange(const Population& population, std::uint32_t parents[], Population& offsprings, const std::size_t ui_firstPair,
+							   const std::size_t ui_pairs, const DistanceMatrix& distances, Xoshiro256& engine);
+	extern void evaluateRange(Population& population, const std::size_t ui_first, const std::size_t ui_count, const DistanceMatrix& distances,
+							  const KernelIsa e_isa);
+	extern void mutateRange(Population& offsprings, const std::size_t ui_first, const std::size_t ui_count, const int RATE, const int INVERSIONS,
+							const DistanceMatrix* distances, Xoshiro256& engine);
+	extern void populateRange(Population& population, const Population& offsprings, const std::size_t ui_first, const std::size_t ui_count);
+
+#pragma endregion
+
+
+#pragma region Implementations:
+
+	/// <summary>
+	///          Cuts the offspring pairs and the population into chunks and builds their task chains. The buffers are the ones
+	///          the loop-parallel generations use and must outlive the pipeline.
+	/// </summary>
+	/// <exception cref="std::invalid_argument">
+	///          Thrown if the distances are not precomputed, or if a chunk's block of the population has fewer tours than the
+	///          chunk selects parents.
+	/// </exception>
+	GenerationPipeline::GenerationPipeline(const RunOptions& options, const DistanceMatrix& distances, const NeighborLists* neighbors,
+										   Population& trip, Population& offsprings, std::vector<std::uint32_t>& parents)
+		: options(options), distances(distances), neighbors(neighbors), trip(trip), offsprings(offsprings), parents(parents), ui_chunks(0),
+		  ui_v_available(trip.size()), ui_offset(0), i_rate(0), i_inversions(0), ui_deadline(std::numeric_limits<std::uint64_t>::max())
+	{
+		if (options.e_distanceMode != DistanceMode::matrix)
+		{
+			throw std::invalid_argument("The task pipeline needs the distance matrix!");
+		} // end if
+
+		const std::size_t ui_pairs = offsprings.size() / 2;
+
+		ui_chunks = pipelineChunks(options.ui_chunks, offsprings.size(), static_cast<std::size_t>(omp_get_max_threads()));
+
+		for (std::size_t c = 0; c <= ui_chunks; c++)
+		{
+			ui_v_pairs.push_back(ui_pairs * c / ui_chunks);
+			ui_v_blocks.push_back(trip.size() * c / ui_chunks);
+		} // end for c
+
+		for (std::size_t c = 0; c < ui_chunks; c++)
+		{
+			if (ui_v_blocks[c + 1] - ui_v_blocks[c] < 2 * (ui_v_pairs[c + 1] - ui_v_pairs[c]))
+			{
+				throw std::invalid_argument("A chunk of " + std::to_string(ui_v_blocks[c + 1] - ui_v_blocks[c]) + " tours cannot select "
+											+ std::to_string(2 * (ui_v_pairs[c + 1] - ui_v_pairs[c])) + " parents, use fewer offsprings or --chunks!");
+			} // end if
+		} // end for c
+
+		engines.resize(ui_chunks);
+		build();
+	} // end constructor
+
+
+	/// <summary>
+	///          Runs select to populate of one generation on the current OpenMP team and returns when trip holds the next one.
+	///          Draws the generation's seed and rotation from the calling thread's engine.
+	/// </summary>
+	/// <param name="i_rate">
+	///          Mutation rate in %.
+	/// </param>
+	/// <param name="i_inversions">
+	///          % of the mutations that reverse a segment instead of swapping two cities.
+	/// </param>
+	void GenerationPipeline::run(const int i_rate, const int i_inversions)
+	{
+		Xoshiro256& engine = localEngine();
+		const std::uint64_t ui_seed = engine();
+
+		ui_offset = static_cast<std::size_t>(randomBelow(engine, trip.size()));
+		this->i_rate = i_rate;
+		this->i_inversions = i_inversions;
+		ui_deadline = (options.i_localBudget > 0 ? Profiler::now() + static_cast<std::uint64_t>(options.i_localBudget) * 1000
+												 : std::numeric_limits<std::uint64_t>::max());
+
+		for (std::size_t c = 0; c < ui_chunks; c++)
+		{
+			engines[c].seed(ui_seed, static_cast<std::uint64_t>(c));
+		} // end for c
+
+		PROFILE_COUNT(Counter::rngDraws, 2);
+		graph.run();
+	} // end method run
+
+
+	/// <summary>
+	///          Adds the chain of every chunk to the graph, and makes every populate task wait for all crossovers.
+	/// </summary>
+	void GenerationPipeline::build(void)
+	{
+		// populate overwrites tours any chunk may still select or cross, this empty task joins all crossovers
+		const std::size_t ui_crossed = graph.add([](void) { });
+		std::vector<std::size_t> ui_v_last(ui_chunks);
+
+		for (std::size_t c = 0; c < ui_chunks; c++)
+		{
+			const std::size_t ui_firstPair = ui_v_pairs[c];
+			const std::size_t ui_pairs = ui_v_pairs[c + 1] - ui_firstPair;
+
+			const std::size_t ui_select = graph.add([this, c, ui_firstPair, ui_pairs](void)
+			{
+				PROFILE_THREAD(Stage::pipeline);
+				selectRange(trip, ui_offset, ui_v_blocks[c], ui_v_blocks[c + 1], parents.data() + 2 * ui_firstPair, 2 * ui_pairs,
+							ui_v_available.data() + ui_v_blocks[c], engines[c]);
+			});
+
+			const std::size_t ui_crossover = graph.add([this, c, ui_firstPair, ui_pairs](void)
+			{
+				PROFILE_THREAD(Stage::pipeline);
+				crossoverRange(trip, parents.data(), offsprings, ui_firstPair, ui_pairs, distances, engines[c]);
+			});
+
+			const std::size_t ui_evaluate = graph.add([this, ui_firstPair, ui_pairs](void)
+			{
+				PROFILE_THREAD(Stage::pipeline);
+				evaluateRange(offsprings, 2 * ui_firstPair, 2 * ui_pairs, distances, options.e_kernelIsa);
+			});
+
+			const std::size_t ui_mutate = graph.add([this, c, ui_firstPair, ui_pairs](void)
+			{
+				PROFILE_THREAD(Stage::pipeline);
+				mutateRange(offsprings, 2 * ui_firstPair, 2 * ui_pairs, i_rate, i_inversions, &distances, engines[c]);
+			});
+
+			graph.precede(ui_select, ui_crossover);
+			graph.precede(ui_crossover, ui_evaluate);
+			graph.precede(ui_crossover, ui_crossed);
+			graph.precede(ui_evaluate, ui_mutate);
+			ui_v_last[c] = ui_mutate;
+
+			if (neighbors != nullptr)
+			{
+				const std::size_t ui_improve = graph.add([this, ui_firstPair, ui_pairs](void)
+				{
+					PROFILE_THREAD(Stage::pipeline);
+					improveRange(offsprings, 2 * ui_firstPair, 2 * ui_pairs, distances, *neighbors, options.d_localSearch, ui_deadline);
+				});
+
+				graph.precede(ui_mutate, ui_improve);
+				ui_v_last[c] = ui_improve;
+			} // end if
+		} // end for c
+
+		for (std::size_t c = 0; c < ui_chunks; c++)
+		{
+			const std::size_t ui_firstPair = ui_v_pairs[c];
+			const std::size_t ui_pairs = ui_v_pairs[c + 1] - ui_firstPair;
+
+			const std::size_t ui_populate = graph.add([this, ui_firstPair, ui_pairs](void)
+			{
+				PROFILE_THREAD(Stage::pipeline);
+				populateRange(trip, offsprings, 2 * ui_firstPair, 2 * ui_pairs);
+			});
+
+			graph.precede(ui_v_last[c], ui_populate);
+			graph.precede(ui_crossed, ui_populate);
+		} // end for c
+	} // end method build
+
+
+	/// <summary>
+	///          Chunks the pipeline cuts <paramref name="ui_offsprings"/> offsprings into: <paramref name="ui_chunks"/>, or if
+	///          that is 0 one per PIPELINE_CHUNK_PAIRS pairs but at least PIPELINE_CHUNKS_PER_THREAD per thread; never more
+	///          than there are pairs.
+	/// </summary>
+	std::size_t pipelineChunks(const std::size_t ui_chunks, const std::size_t ui_offsprings, const std::size_t ui_threads) noexcept
+	{
+		const std::size_t ui_wanted = (ui_chunks > 0 ? ui_chunks : std::max(PIPELINE_CHUNKS_PER_THREAD * ui_threads, ui_offsprings / 2 / PIPELINE_CHUNK_PAIRS));
+
+		return std::max<std::size_t>(1, std::min(ui_wanted, ui_offsprings / 2));
+	} // end method pipelineChunks
+
+
+	/// <summary>
+	///          Name of a pipeline mode as given on the command line.
+	/// </summary>
+	const char* pipelineModeName(const PipelineMode e_mode) noexcept
+	{
+		switch (e_mode)
+		{
+			case PipelineMode::tasks: return "tasks";
+			default:                  return "loops";
+		} // end switch
+	} // end method pipelineModeName
+
+
+	/// <summary>
+	///          Parses a pipeline mode name.
+	/// </summary>
+	/// <param name="name">
+	///          One of loops or tasks.
+	/// </param>
+	/// <param name="e_mode">
+	///          Output parameter for the parsed mode.
+	/// </param>
+	/// <returns>
+	///          true if <paramref name="name"/> is a known mode
+	/// </returns>
+	bool parsePipelineMode(const char* name, PipelineMode& e_mode) noexcept
+	{
+		const PipelineMode e_a_all[] = { PipelineMode::loops, PipelineMode::tasks };
+
+		for (const PipelineMode e_candidate : e_a_all)
+		{
+			if (strcmp(name, pipelineModeName(e_candidate)) == 0)
+			{
+				e_mode = e_candidate;
+				return true;
+			} // end if
+		} // end for
+
+		return false;
+	} // end method parsePipelineMode
+
+#pragma endregion
@@ -0,0 +1,93 @@
+#ifndef _PIPELINE_H_
+#define _PIPELINE_H_
+
+#pragma region Includes:
+
+	#include <cstddef>          // std::size_t
+	#include <cstdint>          // std::uint32_t, std::uint64_t
+	#include <vector>           // std::vector
+	#include "DistanceMatrix.h" // DistanceMatrix
+	#include "LocalSearch.h"    // NeighborLists
+	#include "Population.h"     // Population
+	#include "Random.hpp"       // Xoshiro256
+	#include "TaskGraph.h"      // TaskGraph
+
+#pragma endregion
+
+
+struct RunOptions;
+
+
+#pragma region Defines:
+
+	#ifndef PIPELINE_CHUNKS_PER_THREAD
+		#define PIPELINE_CHUNKS_PER_THREAD    4     // fewest chunks per thread unless --chunks says otherwise
+	#endif
+	#ifndef PIPELINE_CHUNK_PAIRS
+		#define PIPELINE_CHUNK_PAIRS          256   // offspring pairs per chunk unless that leaves too few chunks, keeps a chunk's tours in cache
+	#endif
+
+#pragma endregion
+
+
+// How a generation's operators share the threads, from selection to populating the next generation.
+enum class PipelineMode
+{
+	loops, // one parallel loop per operator, with a barrier after each
+	tasks  // chunks of the offsprings flow through the operators as a task graph
+}; // end enum PipelineMode
+
+
+// Selection, crossover, evaluation, mutation, local search and populate of one generation as a task graph.
+//
+// The offspring pairs are cut into chunks, and every chunk is a chain of tasks: select its parents from its own block
+// of the rotated population, cross them, score the children, mutate and polish them, and copy them into trip. A chunk
+// moves on as soon as its own previous step is done, so a thread that finishes early takes up the next chunk or steals
+// one instead of waiting at a barrier. Only populate waits for every chunk to be crossed, since it overwrites tours
+// other chunks may still select or read as parents. Every chunk draws from an engine of its own, seeded from the
+// calling thread's engine once per generation, so a run repeats from its seed and chunk count whichever thread
+// happens to run a task. Ranking and the mutation controller look at the whole population and stay outside.
+class GenerationPipeline
+{
+public:
+	GenerationPipeline(const RunOptions& options, const DistanceMatrix& distances, const NeighborLists* neighbors, Population& trip,
+					   Population& offsprings, std::vector<std::uint32_t>& parents);
+
+	GenerationPipeline(const GenerationPipeline&) = delete;
+	GenerationPipeline& operator=(const GenerationPipeline&) = delete;
+
+	void run(const int i_rate, const int i_inversions);
+
+	inline std::size_t chunks(void) const noexcept { return ui_chunks; }
+
+private:
+	void build(void);
+
+	const RunOptions&          options;       // local search share and budget, kernel instruction set
+	const DistanceMatrix&      distances;     // distance table of the instance
+	const NeighborLists*       neighbors;     // candidate lists, null without local search
+	Population&                trip;          // the population
+	Population&                offsprings;    // the offspring pool
+	std::vector<std::uint32_t>& parents;      // parent slots, two per offspring pair
+	std::size_t                ui_chunks;     // chunks of the generation
+	std::vector<std::size_t>   ui_v_pairs;    // first offspring pair of every chunk, and the pair count last
+	std::vector<std::size_t>   ui_v_blocks;   // first tour of every chunk's selection block, and the population size last
+	std::vector<std::uint32_t> ui_v_available; // selection scratch space, one entry per tour
+	std::vector<Xoshiro256>    engines;       // engine of every chunk
+	std::size_t                ui_offset;     // rotation of the tour order this generation
+	int                        i_rate;        // mutation rate of this generation
+	int                        i_inversions;  // % of this generation's mutations that reverse a segment
+	std::uint64_t              ui_deadline;   // Profiler::now() after which the local search starts no tour
+	TaskGraph                  graph;         // the chains of all chunks
+}; // end class GenerationPipeline
+
+
+#pragma region Prototypes:
+
+	std::size_t pipelineChunks(const std::size_t ui_chunks, const std::size_t ui_offsprings, const std::size_t ui_threads) noexcept;
+	const char* pipelineModeName(const PipelineMode e_mode) noexcept;
+	bool parsePipelineMode(const char* name, PipelineMode& e_mode) noexcept;
+
+#pragma endregion
+
+#endif
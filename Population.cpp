@@ -0,0 +1,199 @@
+#pragma region Includes:
+
+	#include "Population.h" // Population
+	#include "Trip.h"       // translateToIndex, translateToCity
+	#include "utility.hpp"  // alignedAlloc, roundUp
+	#include <limits>       // float max
+	#include <string.h>     // memset
+
+#pragma endregion
+
+
+/// <summary>
+///          Allocates a population of <paramref name="ui_size"/> tours through <paramref name="ui_cities"/> cities.
+///          Every tour starts out with an all-zero genome and an unknown (maximal) fitness, not scored. The arrays are
+///          first touched by the current OpenMP team, each thread clearing the slots of its static share.
+/// </summary>
+/// <param name="ui_size">
+///          Number of tours.
+/// </param>
+/// <param name="ui_cities">
+///          Number of cities per tour.
+/// </param>
+/// <exception cref="std::bad_alloc">Thrown if one of the arrays cannot be allocated.</exception>
+Population::Population(const std::size_t ui_size, const std::size_t ui_cities)
+	: g_a_genomes(nullptr), f_a_fitness(nullptr), b_a_scored(nullptr), k_a_keys(nullptr), k_a_scratch(nullptr),
+	  ui_size(ui_size), ui_cities(ui_cities), ui_stride(roundUp(ui_cities * sizeof(gene_t), GENOME_ROW_ALIGN) / sizeof(gene_t))
+{
+	// one extra line of padding keeps the 4-byte gene gathers of the batch kernel inside the block
+	const std::size_t ui_genomeBytes = ui_size * ui_stride * sizeof(gene_t) + CACHE_LINE_SIZE;
+
+	try
+	{
+		g_a_genomes = static_cast<gene_t*>(alignedAlloc(ui_genomeBytes));
+		f_a_fitness = static_cast<float*>(alignedAlloc(ui_size * sizeof(float)));
+		b_a_scored = static_cast<std::uint8_t*>(alignedAlloc(ui_size));
+		k_a_keys = static_cast<Key*>(alignedAlloc(ui_size * sizeof(Key)));
+		k_a_scratch = static_cast<Key*>(alignedAlloc(ui_size * sizeof(Key)));
+	} // end try
+	catch (...)
+	{
+		alignedFree(g_a_genomes);
+		alignedFree(f_a_fitness);
+		alignedFree(b_a_scored);
+		alignedFree(k_a_keys);
+		throw;
+	} // end catch
+
+	const long long i_size = static_cast<long long>(ui_size);
+	const std::size_t ui_rowBytes = ui_stride * sizeof(gene_t);
+
+	// pages are placed on the node of the thread that touches them first: every thread clears the slots the
+	// operators' static schedules give it, so a pinned team mostly reads memory of its own node
+	#pragma omp parallel for schedule(static)
+	for (long long i = 0; i < i_size; i++)
+	{
+		memset(g_a_genomes + i * ui_stride, 0, ui_rowBytes);
+		b_a_scored[i] = 0;
+		f_a_fitness[i] = std::numeric_limits<float>::max();
+		k_a_keys[i].fitness = f_a_fitness[i];
+		k_a_keys[i].ui_slot = static_cast<std::uint32_t>(i);
+		k_a_scratch[i] = k_a_keys[i];
+	} // end for i
+
+	memset(g_a_genomes + ui_size * ui_stride, 0, CACHE_LINE_SIZE);
+} // end constructor
+
+
+Population::~Population(void)
+{
+	alignedFree(g_a_genomes);
+	alignedFree(f_a_fitness);
+	alignedFree(b_a_scored);
+	alignedFree(k_a_keys);
+	alignedFree(k_a_scratch);
+} // end destructor
+
+
+/// <summary>
+///          View of <paramref name="ui_count"/> consecutive slots for the batch fitness kernel.
+/// </summary>
+/// <param name="ui_firstSlot">
+///          First slot of the batch.
+/// </param>
+/// <param name="ui_count">
+///          Number of slots in the batch.
+/// </param>
+/// <returns>
+///          The batch, writing fitness values straight into this population.
+/// </returns>
+TourBatch Population::batch(const std::size_t ui_firstSlot, const std::size_t ui_count) noexcept
+{
+	const TourBatch batch = { reinterpret_cast<const char*>(genome(ui_firstSlot)), ui_stride * sizeof(gene_t),
+							  f_a_fitness + ui_firstSlot, sizeof(float), ui_count, ui_cities,
+							  (sizeof(gene_t) == 2 ? GenomeEncoding::index16 : GenomeEncoding::index) };
+
+	return batch;
+} // end method batch
+
+
+/// <summary>
+///          Whether any of <paramref name="ui_count"/> slots from <paramref name="ui_firstSlot"/> needs evaluating.
+/// </summary>
+bool Population::anyUnscored(const std::size_t ui_firstSlot, const std::size_t ui_count) const noexcept
+{
+	for (std::size_t i = ui_firstSlot; i < ui_firstSlot + ui_count; i++)
+	{
+		if (!b_a_scored[i])
+		{
+			return true;
+		} // end if
+	} // end for i
+
+	return false;
+} // end method anyUnscored
+
+
+/// <summary>
+///          Number of slots whose fitness is not that of their genome, the tours the next evaluation walks.
+/// </summary>
+std::size_t Population::unscored(void) const noexcept
+{
+	std::size_t ui_scored = 0;
+
+	for (std::size_t i = 0; i < ui_size; i++)
+	{
+		ui_scored += b_a_scored[i];
+	} // end for i
+
+	return ui_size - ui_scored;
+} // end method unscored
+
+
+/// <summary>
+///          Flags <paramref name="ui_count"/> slots from <paramref name="ui_firstSlot"/> as scored, after a batch evaluation.
+/// </summary>
+void Population::markScored(const std::size_t ui_firstSlot, const std::size_t ui_count) noexcept
+{
+	memset(b_a_scored + ui_firstSlot, 1, ui_count);
+} // end method markScored
+
+
+/// <summary>
+///          Rebuilds the key array from the current fitness values, in slot order. Genomes are not moved.
+/// </summary>
+void Population::refreshKeys(void)
+{
+	const long long i_size = static_cast<long long>(ui_size);
+
+	#pragma omp parallel for schedule(static)
+	for (long long i = 0; i < i_size; i++)
+	{
+		k_a_keys[i].fitness = f_a_fitness[i];
+		k_a_keys[i].ui_slot = static_cast<std::uint32_t>(i);
+	} // end for i
+} // end method refreshKeys
+
+
+/// <summary>
+///          Writes the genome in <paramref name="ui_slot"/> as alpha-numeric city names (ABC...012...).
+/// </summary>
+/// <param name="ui_slot">
+///          Slot of the tour.
+/// </param>
+/// <param name="c_a_names">
+///          Output buffer of at least cities() + 1 characters, null terminated on return.
+/// </param>
+void Population::toNames(const std::size_t ui_slot, char* c_a_names) const noexcept
+{
+	const gene_t* g_a_genome = genome(ui_slot);
+
+	for (std::size_t j = 0; j < ui_cities; j++)
+	{
+		c_a_names[j] = translateToCity(g_a_genome[j]);
+	} // end for j
+
+	c_a_names[ui_cities] = 0;
+} // end method toNames
+
+
+/// <summary>
+///          Stores the tour given as alpha-numeric city names (ABC...012...) in <paramref name="ui_slot"/>.
+/// </summary>
+/// <param name="ui_slot">
+///          Slot to overwrite.
+/// </param>
+/// <param name="c_a_names">
+///          At least cities() city names.
+/// </param>
+void Population::fromNames(const std::size_t ui_slot, const char* c_a_names) noexcept
+{
+	gene_t* g_a_genome = genome(ui_slot);
+
+	for (std::size_t j = 0; j < ui_cities; j++)
+	{
+		g_a_genome[j] = static_cast<gene_t>(translateToIndex(c_a_names[j]));
+	} // end for j
+
+	invalidate(ui_slot);
+} // end method fromNames
@@ -0,0 +1,104 @@
+#ifndef _POPULATION_H_
+#define _POPULATION_H_
+
+#pragma region Includes:
+
+	#include <cstddef>         // std::size_t
+	#include <cstdint>         // std::uint16_t, std::uint32_t
+	#include <utility>         // std::swap
+	#include "FitnessKernel.h" // TourBatch
+
+#pragma endregion
+
+
+#pragma region Defines:
+
+	#ifndef GENOME_ROW_ALIGN
+		#define GENOME_ROW_ALIGN    32    // bytes a genome row is padded to, one AVX2 load keeps to one row
+	#endif
+
+#pragma endregion
+
+
+typedef std::uint16_t gene_t; // one city index of a genome, instances of up to 65536 cities
+
+
+// Structure-of-arrays store of a population of tours.
+//
+// Genomes, fitness values and the ranking keys live in three separate cache-line aligned arrays.
+// A tour is addressed by its slot, the fixed position of its genome; genomes never move. Fitness values are carried
+// from generation to generation and only recomputed for slots flagged as not scored. The key
+// array holds (fitness, slot) pairs and is what gets sorted and selected on, so ranking a
+// generation only moves 8-byte keys around. Genomes store city indices, not names, and every
+// genome row is padded to GENOME_ROW_ALIGN bytes; 36 16-bit genes take three 32-byte blocks rather
+// than two full cache lines.
+class Population
+{
+public:
+	// Ranking entry, keys()[rank] names the slot holding the tour of that rank.
+	struct Key
+	{
+		float         fitness; // length of the tour in ui_slot
+		std::uint32_t ui_slot; // slot of the tour
+
+		inline bool operator<(const Key& OTHER) const noexcept { return fitness < OTHER.fitness; }
+	}; // end struct Key
+
+	Population(const std::size_t ui_size, const std::size_t ui_cities);
+	~Population(void);
+
+	Population(const Population&) = delete;
+	Population& operator=(const Population&) = delete;
+
+	inline gene_t*       genome(const std::size_t ui_slot) noexcept       { return g_a_genomes + ui_slot * ui_stride; }
+	inline const gene_t* genome(const std::size_t ui_slot) const noexcept { return g_a_genomes + ui_slot * ui_stride; }
+
+	inline float& fitness(const std::size_t ui_slot) noexcept       { return f_a_fitness[ui_slot]; }
+	inline float  fitness(const std::size_t ui_slot) const noexcept { return f_a_fitness[ui_slot]; }
+
+	/// <summary>
+	///          Whether the fitness of <paramref name="ui_slot"/> matches its genome. Whoever writes a genome either keeps
+	///          the fitness up to date or calls <see cref="invalidate"/>; evaluate only walks tours that are not scored.
+	/// </summary>
+	inline bool scored(const std::size_t ui_slot) const noexcept         { return b_a_scored[ui_slot] != 0; }
+	inline void score(const std::size_t ui_slot, const float f) noexcept { f_a_fitness[ui_slot] = f; b_a_scored[ui_slot] = 1; }
+	inline void invalidate(const std::size_t ui_slot) noexcept           { b_a_scored[ui_slot] = 0; }
+
+	inline Key*       keys(void) noexcept       { return k_a_keys; }
+	inline const Key* keys(void) const noexcept { return k_a_keys; }
+
+	/// <summary>
+	///          Second key array of the same size, scratch space for ranking algorithms that do not work in place.
+	/// </summary>
+	inline Key* scratchKeys(void) noexcept { return k_a_scratch; }
+	inline void swapKeys(void) noexcept    { std::swap(k_a_keys, k_a_scratch); }
+
+	/// <summary>
+	///          Slot of the tour ranked <paramref name="ui_rank"/> by the last ranking stage.
+	/// </summary>
+	inline std::size_t slotOfRank(const std::size_t ui_rank) const noexcept { return k_a_keys[ui_rank].ui_slot; }
+
+	inline std::size_t size(void)   const noexcept { return ui_size; }
+	inline std::size_t cities(void) const noexcept { return ui_cities; }
+	inline std::size_t stride(void) const noexcept { return ui_stride; }
+
+	TourBatch batch(const std::size_t ui_firstSlot, const std::size_t ui_count) noexcept;
+	bool anyUnscored(const std::size_t ui_firstSlot, const std::size_t ui_count) const noexcept;
+	std::size_t unscored(void) const noexcept;
+	void markScored(const std::size_t ui_firstSlot, const std::size_t ui_count) noexcept;
+	void refreshKeys(void);
+	void toNames(const std::size_t ui_slot, char* c_a_names) const noexcept;
+	void fromNames(const std::size_t ui_slot, const char* c_a_names) noexcept;
+
+private:
+	gene_t*       g_a_genomes; // ui_size rows of ui_stride genes
+	float*        f_a_fitness; // fitness by slot
+	std::uint8_t* b_a_scored;  // by slot, 1 where the fitness is that of the current genome
+	Key*          k_a_keys;    // (fitness, slot) by rank
+	Key*          k_a_scratch; // scratch keys, see scratchKeys()
+	std::size_t   ui_size;     // number of tours
+	std::size_t   ui_cities;   // genes per tour
+	std::size_t   ui_stride;   // genes per row, multiple of GENOME_ROW_ALIGN bytes
+}; // end class Population
+
+#endif
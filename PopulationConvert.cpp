@@ -0,0 +1,115 @@
+// Converts the text population (chromosome.txt, cities.txt) to the binary population file format.
+// usage: convert <output.bin> [chromosome file] [cities file]
+//
+// The city count is taken from the cities file, every chromosome line must name each city once.
+// Records are streamed to disk, so the chromosome file may be larger than memory.
+
+#pragma region Includes:
+
+	#include <iostream>         // cout
+	#include <fstream>          // ifstream
+	#include <string>           // std::string, getline
+	#include <vector>           // std::vector
+	#include <stdexcept>        // std::exception
+	#include "utility.hpp"      // Point, highRes_Clock
+	#include "Trip.h"           // translateToIndex
+	#include "PopulationFile.h" // PopulationFileWriter
+
+#pragma endregion
+
+
+int main(int argc, char* argv[])
+{
+	if (argc < 2 || argc > 4)
+	{
+		std::cout << "usage: convert <output.bin> [chromosome file] [cities file]" << std::endl;
+		return EXIT_FAILURE;
+	} // end if
+
+	const char* c_chromosomePath = (argc > 2 ? argv[2] : "chromosome.txt");
+	const char* c_citiesPath = (argc > 3 ? argv[3] : "cities.txt");
+
+	std::ifstream chromosome_file(c_chromosomePath);
+	std::ifstream cities_file(c_citiesPath);
+
+	if (!chromosome_file.is_open() || !cities_file.is_open())
+	{
+		std::cout << "Opening " << c_chromosomePath << " or " << c_citiesPath << " failed! Exiting ..." << std::endl;
+		return EXIT_FAILURE;
+	} // end if
+
+	timePoint start = highRes_Clock::now();
+
+	// cities.txt: one "name x y" line per city, in any order
+	std::vector<Point> coordinates;
+	char city;
+	int x, y;
+
+	while (cities_file >> city >> x >> y)
+	{
+		const std::size_t ui_index = translateToIndex(city);
+
+		if (ui_index >= coordinates.size())
+		{
+			coordinates.resize(ui_index + 1);
+		} // end if
+
+		coordinates[ui_index] = Point(x, y);
+	} // end while
+
+	const std::size_t ui_cities = coordinates.size();
+	std::vector<gene_t> g_v_genome(ui_cities);
+	std::vector<bool> b_v_seen(ui_cities);
+	std::string itinerary;
+	std::size_t ui_line = 0;
+
+	try
+	{
+		PopulationFileWriter writer(argv[1], coordinates.data(), ui_cities);
+
+		while (chromosome_file >> itinerary)
+		{
+			ui_line++;
+
+			bool b_valid = (itinerary.size() == ui_cities);
+
+			std::fill(b_v_seen.begin(), b_v_seen.end(), false);
+
+			for (std::size_t j = 0; j < ui_cities && b_valid; j++)
+			{
+				const std::size_t ui_index = translateToIndex(itinerary[j]);
+
+				b_valid = (ui_index < ui_cities && !b_v_seen[ui_index]);
+
+				if (b_valid)
+				{
+					b_v_seen[ui_index] = true;
+					g_v_genome[j] = static_cast<gene_t>(ui_index);
+				} // end if
+			} // end for j
+
+			if (!b_valid)
+			{
+				std::cout << c_chromosomePath << ":" << ui_line << ": not a tour through all " << ui_cities << " cities! Exiting ..." << std::endl;
+				return EXIT_FAILURE;
+			} // end if
+
+			writer.append(g_v_genome.data());
+		} // end while
+
+		writer.close();
+	} // end try
+	catch (const std::exception& e)
+	{
+		std::cout << "Conversion failed!" << std::endl;
+		std::cout << "Reason: " << e.what() << std::endl;
+		return EXIT_FAILURE;
+	} // end catch
+
+	timePoint end = highRes_Clock::now();
+
+	std::cout << "wrote " << ui_line << " tours through " << ui_cities << " cities to " << argv[1] << " in "
+			  << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() << " us" << std::endl;
+
+	return EXIT_SUCCESS;
+} // end Main
@@ -0,0 +1,351 @@
+#pragma region Includes:
+
+	#include "PopulationFile.h" // PopulationFile
+	#include <stdexcept>        // std::runtime_error
+	#include <fstream>          // ifstream
+	#include <string>           // std::string
+	#include <string.h>         // memcpy, memcmp
+	#if !defined(_WIN32) && !defined(_WIN64)
+		#include <fcntl.h>      // open
+		#include <sys/mman.h>   // mmap, munmap, madvise
+		#include <sys/stat.h>   // fstat
+		#include <unistd.h>     // close
+	#endif
+
+#pragma endregion
+
+
+#pragma region Defines:
+
+	#define POPULATION_FILE_MAGIC "TSPP"
+	#define FNV_OFFSET_BASIS      0xCBF29CE484222325ull
+	#define FNV_PRIME             0x100000001B3ull
+
+#pragma endregion
+
+
+static_assert(sizeof(PopulationFileHeader) == 48, "PopulationFileHeader must not contain padding");
+
+
+#pragma region Helpers:
+
+	/// <summary>
+	///          Offset of the first record for <paramref name="ui_cities"/> cities, the header and the coordinates rounded
+	///          up to a whole cache line.
+	/// </summary>
+	static inline std::uint64_t recordOffset(const std::size_t ui_cities) noexcept
+	{
+		return roundUp(sizeof(PopulationFileHeader) + ui_cities * 2 * sizeof(std::int32_t), CACHE_LINE_SIZE);
+	} // end method recordOffset
+
+#pragma endregion
+
+
+#pragma region Implementations:
+
+	/// <summary>
+	///          64-bit FNV-1a hash of <paramref name="ui_bytes"/> bytes, continuing from <paramref name="ui_hash"/> so that
+	///          a stream can be hashed in pieces. Start with <see cref="FNV_OFFSET_BASIS"/>.
+	/// </summary>
+	std::uint64_t fnv1a(const void* p_data, const std::size_t ui_bytes, std::uint64_t ui_hash) noexcept
+	{
+		const unsigned char* c_a_bytes = static_cast<const unsigned char*>(p_data);
+
+		for (std::size_t i = 0; i < ui_bytes; i++)
+		{
+			ui_hash = (ui_hash ^ c_a_bytes[i]) * FNV_PRIME;
+		} // end for i
+
+		return ui_hash;
+	} // end method fnv1a
+
+
+	/// <summary>
+	///          Creates <paramref name="path"/> and writes the header and the city coordinates.
+	/// </summary>
+	/// <param name="path">
+	///          File to create, truncated if it exists.
+	/// </param>
+	/// <param name="coordinates">
+	///          The (x, y) coordinates of all cities, indexed by city index.
+	/// </param>
+	/// <param name="ui_cities">
+	///          Number of cities, genes per record.
+	/// </param>
+	/// <exception cref="std::runtime_error">Thrown if the file cannot be written.</exception>
+	PopulationFileWriter::PopulationFileWriter(const char* path, const Point* coordinates, const std::size_t ui_cities)
+		: p_file(fopen(path, "wb")), header(), ui_checksum(FNV_OFFSET_BASIS)
+	{
+		if (p_file == nullptr)
+		{
+			throw std::runtime_error(std::string("cannot create ") + path);
+		} // end if
+
+		memcpy(header.c_a_magic, POPULATION_FILE_MAGIC, sizeof(header.c_a_magic));
+		header.ui_version = POPULATION_FILE_VERSION;
+		header.ui_cities = static_cast<std::uint32_t>(ui_cities);
+		header.ui_geneBytes = sizeof(gene_t);
+		header.ui_recordBytes = ui_cities * sizeof(gene_t);
+		header.ui_recordOffset = recordOffset(ui_cities);
+
+		bool b_ok = (fwrite(&header, sizeof(header), 1, p_file) == 1);
+
+		for (std::size_t i = 0; i < ui_cities && b_ok; i++)
+		{
+			const std::int32_t i_a_xy[2] = { coordinates[i].x, coordinates[i].y };
+
+			ui_checksum = fnv1a(i_a_xy, sizeof(i_a_xy), ui_checksum);
+			b_ok = (fwrite(i_a_xy, sizeof(i_a_xy), 1, p_file) == 1);
+		} // end for i
+
+		const char c_a_padding[CACHE_LINE_SIZE] = { 0 };
+		const std::size_t ui_padding = static_cast<std::size_t>(header.ui_recordOffset) - sizeof(header) - ui_cities * 2 * sizeof(std::int32_t);
+
+		if (!b_ok || fwrite(c_a_padding, 1, ui_padding, p_file) != ui_padding)
+		{
+			fclose(p_file);
+			throw std::runtime_error(std::string("cannot write ") + path);
+		} // end if
+	} // end constructor
+
+
+	PopulationFileWriter::~PopulationFileWriter(void)
+	{
+		if (p_file != nullptr)
+		{
+			fclose(p_file);
+		} // end if
+	} // end destructor
+
+
+	/// <summary>
+	///          Appends one record.
+	/// </summary>
+	/// <param name="genome">
+	///          The tour as cities() city indices.
+	/// </param>
+	/// <exception cref="std::runtime_error">Thrown if the record cannot be written.</exception>
+	void PopulationFileWriter::append(const gene_t* genome)
+	{
+		const std::size_t ui_bytes = static_cast<std::size_t>(header.ui_recordBytes);
+
+		if (p_file == nullptr || fwrite(genome, 1, ui_bytes, p_file) != ui_bytes)
+		{
+			throw std::runtime_error("cannot append to population file");
+		} // end if
+
+		ui_checksum = fnv1a(genome, ui_bytes, ui_checksum);
+		header.ui_population++;
+	} // end method append
+
+
+	/// <summary>
+	///          Appends <paramref name="ui_count"/> records stored <paramref name="ui_stride"/> genes apart, e.g. the rows of a
+	///          <see cref="Population"/>.
+	/// </summary>
+	void PopulationFileWriter::append(const gene_t* genomes, const std::size_t ui_count, const std::size_t ui_stride)
+	{
+		for (std::size_t i = 0; i < ui_count; i++)
+		{
+			append(genomes + i * ui_stride);
+		} // end for i
+	} // end method append
+
+
+	/// <summary>
+	///          Rewrites the header with the final record count and checksum, then closes the file.
+	/// </summary>
+	/// <exception cref="std::runtime_error">Thrown if the header cannot be written.</exception>
+	void PopulationFileWriter::close(void)
+	{
+		if (p_file == nullptr)
+		{
+			return;
+		} // end if
+
+		header.ui_checksum = ui_checksum;
+
+		const bool b_ok = (fseek(p_file, 0, SEEK_SET) == 0 && fwrite(&header, sizeof(header), 1, p_file) == 1);
+
+		fclose(p_file);
+		p_file = nullptr;
+
+		if (!b_ok)
+		{
+			throw std::runtime_error("cannot finish population file");
+		} // end if
+	} // end method close
+
+
+	/// <summary>
+	///          Maps <paramref name="path"/> read-only and validates its header. The checksum is not verified here,
+	///          see <see cref="verify"/>.
+	/// </summary>
+	/// <param name="path">
+	///          The population file.
+	/// </param>
+	/// <exception cref="std::runtime_error">Thrown if the file cannot be mapped or is not a valid population file.</exception>
+	MappedPopulationFile::MappedPopulationFile(const char* path)
+		: c_a_data(nullptr), ui_bytes(0), c_v_buffer()
+	{
+		#if defined(_WIN32) || defined(_WIN64)
+			std::ifstream in_file(path, std::ios::in | std::ios::binary);
+
+			if (!in_file.is_open())
+			{
+				throw std::runtime_error(std::string("cannot open ") + path);
+			} // end if
+
+			c_v_buffer.assign(std::istreambuf_iterator<char>(in_file), std::istreambuf_iterator<char>());
+			c_a_data = c_v_buffer.data();
+			ui_bytes = c_v_buffer.size();
+		#else
+			const int fd = open(path, O_RDONLY);
+			struct stat status;
+
+			if (fd < 0 || fstat(fd, &status) != 0)
+			{
+				if (fd >= 0)
+				{
+					::close(fd);
+				} // end if
+
+				throw std::runtime_error(std::string("cannot open ") + path);
+			} // end if
+
+			ui_bytes = static_cast<std::size_t>(status.st_size);
+
+			void* p_map = (ui_bytes > 0 ? mmap(nullptr, ui_bytes, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED);
+
+			::close(fd);
+
+			if (p_map == MAP_FAILED)
+			{
+				throw std::runtime_error(std::string("cannot map ") + path);
+			} // end if
+
+			// records are consumed front to back, let the kernel read ahead aggressively
+			madvise(p_map, ui_bytes, MADV_SEQUENTIAL);
+			c_a_data = static_cast<const unsigned char*>(p_map);
+		#endif
+
+		const char* c_a_error = nullptr;
+
+		if (ui_bytes < sizeof(PopulationFileHeader) || memcmp(header().c_a_magic, POPULATION_FILE_MAGIC, sizeof(header().c_a_magic)) != 0)
+		{
+			c_a_error = " is not a population file";
+		} // end if
+		else if (header().ui_version != POPULATION_FILE_VERSION || header().ui_geneBytes == 0 || header().ui_geneBytes > sizeof(gene_t))
+		{
+			c_a_error = " has an unsupported version or gene width";
+		} // end elif
+		else if (header().ui_recordBytes != header().ui_cities * static_cast<std::uint64_t>(header().ui_geneBytes)
+				 || header().ui_recordOffset < recordOffset(header().ui_cities)
+				 || header().ui_recordOffset + header().ui_population * header().ui_recordBytes > ui_bytes)
+		{
+			c_a_error = " is truncated or has an inconsistent header";
+		} // end elif
+
+		if (c_a_error != nullptr)
+		{
+			#if !defined(_WIN32) && !defined(_WIN64)
+				munmap(const_cast<unsigned char*>(c_a_data), ui_bytes);
+			#endif
+
+			throw std::runtime_error(std::string(path) + c_a_error);
+		} // end if
+	} // end constructor
+
+
+	MappedPopulationFile::~MappedPopulationFile(void)
+	{
+		#if !defined(_WIN32) && !defined(_WIN64)
+			if (c_a_data != nullptr)
+			{
+				munmap(const_cast<unsigned char*>(c_a_data), ui_bytes);
+			} // end if
+		#endif
+
+		c_a_data = nullptr;
+	} // end destructor
+
+
+	/// <summary>
+	///          Copies the city coordinates stored in the file.
+	/// </summary>
+	/// <param name="coordinates">
+	///          Output array of at least cities() points.
+	/// </param>
+	void MappedPopulationFile::coordinates(Point* coordinates) const noexcept
+	{
+		const unsigned char* c_a_xy = c_a_data + sizeof(PopulationFileHeader);
+
+		for (std::size_t i = 0; i < cities(); i++)
+		{
+			std::int32_t i_a_xy[2];
+
+			memcpy(i_a_xy, c_a_xy + i * sizeof(i_a_xy), sizeof(i_a_xy));
+			coordinates[i] = Point(i_a_xy[0], i_a_xy[1]);
+		} // end for i
+	} // end method coordinates
+
+
+	/// <summary>
+	///          Recomputes the checksum over the coordinates and all records.
+	/// </summary>
+	/// <returns>
+	///          true if it matches the header
+	/// </returns>
+	bool MappedPopulationFile::verify(void) const noexcept
+	{
+		std::uint64_t ui_hash = fnv1a(c_a_data + sizeof(PopulationFileHeader), cities() * 2 * sizeof(std::int32_t), FNV_OFFSET_BASIS);
+
+		ui_hash = fnv1a(record(0), static_cast<std::size_t>(header().ui_population * header().ui_recordBytes), ui_hash);
+
+		return ui_hash == header().ui_checksum;
+	} // end method verify
+
+
+	/// <summary>
+	///          Fills every slot of <paramref name="population"/> with the record of the same index, straight from the
+	///          mapping. The copy runs in parallel, so each thread also first-touches the rows it writes. Files written
+	///          with narrower genes are widened on the fly.
+	/// </summary>
+	/// <param name="population">
+	///          The population to fill, the file must hold at least population.size() records of population.cities() genes.
+	/// </param>
+	/// <exception cref="std::runtime_error">Thrown if the file does not fit <paramref name="population"/>.</exception>
+	void MappedPopulationFile::load(Population& population) const
+	{
+		if (cities() != population.cities() || this->population() < population.size())
+		{
+			throw std::runtime_error("population file does not match the population size or city count");
+		} // end if
+
+		const long long i_size = static_cast<long long>(population.size());
+		const std::size_t ui_recordBytes = static_cast<std::size_t>(header().ui_recordBytes);
+
+		const std::size_t ui_cities = cities();
+		const bool b_sameWidth = (header().ui_geneBytes == sizeof(gene_t));
+
+		#pragma omp parallel for schedule(static)
+		for (long long i = 0; i < i_size; i++)
+		{
+			if (b_sameWidth)
+			{
+				memcpy(population.genome(i), record(i), ui_recordBytes);
+			} // end if
+			else
+			{
+				const unsigned char* c_a_record = record(i);
+				gene_t* genome = population.genome(i);
+
+				for (std::size_t j = 0; j < ui_cities; j++)
+				{
+					genome[j] = c_a_record[j];
+				} // end for j
+			} // end else
+		} // end for i
+	} // end method load
+
+#pragma endregion
@@ -0,0 +1,101 @@
+#ifndef _POPULATION_FILE_H_
+#define _POPULATION_FILE_H_
+
+#pragma region Includes:
+
+	#include <cstddef>      // std::size_t
+	#include <cstdint>      // fixed width integers
+	#include <cstdio>       // FILE
+	#include <vector>       // std::vector
+	#include "utility.hpp"  // Point
+	#include "Population.h" // Population, gene_t
+
+#pragma endregion
+
+
+// Binary population file, native (little-endian) byte order:
+//
+//   PopulationFileHeader                 48 bytes
+//   coordinates       ui_cities * 2 x int32, (x, y) of every city by index
+//   padding           up to ui_recordOffset, a multiple of a cache line
+//   records           ui_population * ui_recordBytes, genes as city indices of ui_geneBytes each
+//
+// ui_checksum is the 64-bit FNV-1a hash of the coordinates followed by all records.
+struct PopulationFileHeader
+{
+	char          c_a_magic[4];    // "TSPP"
+	std::uint32_t ui_version;      // POPULATION_FILE_VERSION
+	std::uint32_t ui_cities;       // genes per record
+	std::uint32_t ui_geneBytes;    // bytes per gene, 1 or 2
+	std::uint64_t ui_population;   // number of records
+	std::uint64_t ui_recordBytes;  // bytes per record, ui_cities * ui_geneBytes
+	std::uint64_t ui_recordOffset; // file offset of the first record
+	std::uint64_t ui_checksum;     // FNV-1a over coordinates and records
+}; // end struct PopulationFileHeader
+
+
+#define POPULATION_FILE_VERSION 1
+
+
+// Streams a population file to disk one record at a time, so populations larger than memory can be
+// written. The header is rewritten with the final count and checksum by close().
+class PopulationFileWriter
+{
+public:
+	PopulationFileWriter(const char* path, const Point* coordinates, const std::size_t ui_cities);
+	~PopulationFileWriter(void);
+
+	PopulationFileWriter(const PopulationFileWriter&) = delete;
+	PopulationFileWriter& operator=(const PopulationFileWriter&) = delete;
+
+	void append(const gene_t* genome);
+	void append(const gene_t* genomes, const std::size_t ui_count, const std::size_t ui_stride);
+	void close(void);
+
+private:
+	FILE*                p_file;       // open output file, null once closed
+	PopulationFileHeader header;       // header, completed by close()
+	std::uint64_t        ui_checksum;  // running FNV-1a state
+}; // end class PopulationFileWriter
+
+
+// Read-only memory mapping of a population file. Records are read in place, nothing is parsed.
+class MappedPopulationFile
+{
+public:
+	explicit MappedPopulationFile(const char* path);
+	~MappedPopulationFile(void);
+
+	MappedPopulationFile(const MappedPopulationFile&) = delete;
+	MappedPopulationFile& operator=(const MappedPopulationFile&) = delete;
+
+	inline const PopulationFileHeader& header(void) const noexcept { return *reinterpret_cast<const PopulationFileHeader*>(c_a_data); }
+	inline std::size_t cities(void) const noexcept     { return header().ui_cities; }
+	inline std::size_t population(void) const noexcept { return static_cast<std::size_t>(header().ui_population); }
+
+	/// <summary>
+	///          Raw bytes of record <paramref name="ui_index"/>, header().ui_geneBytes per gene.
+	/// </summary>
+	inline const unsigned char* record(const std::size_t ui_index) const noexcept
+	{
+		return c_a_data + header().ui_recordOffset + ui_index * header().ui_recordBytes;
+	} // end method record
+
+	void coordinates(Point* coordinates) const noexcept;
+	bool verify(void) const noexcept;
+	void load(Population& population) const;
+
+private:
+	const unsigned char*       c_a_data;   // start of the mapping
+	std::size_t                ui_bytes;   // length of the mapping
+	std::vector<unsigned char> c_v_buffer; // file contents where mmap is unavailable
+}; // end class MappedPopulationFile
+
+
+#pragma region Prototypes:
+
+	std::uint64_t fnv1a(const void* p_data, const std::size_t ui_bytes, std::uint64_t ui_hash) noexcept;
+
+#pragma endregion
+
+#endif
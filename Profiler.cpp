@@ -0,0 +1,367 @@
+#pragma region Includes:
+
+	#include "Profiler.h"  // Profiler
+	#include "utility.hpp" // alignedAlloc, alignedFree
+	#include <algorithm>   // std::max
+	#include <omp.h>       // omp_get_level, omp_get_team_size, omp_get_ancestor_thread_num
+	#include <iomanip>     // std::fixed, std::setprecision
+	#include <string.h>    // memset
+
+#pragma endregion
+
+
+#pragma region Helpers:
+
+	/// <summary>
+	///          Nanoseconds as microseconds, the unit of every reported time.
+	/// </summary>
+	static inline double toMicroseconds(const std::uint64_t ui_ns) noexcept
+	{
+		return static_cast<double>(ui_ns) / 1000.0;
+	} // end method toMicroseconds
+
+#pragma endregion
+
+
+#pragma region Implementations:
+
+	Profiler::Profiler(void) noexcept
+		: t_a_threads(nullptr), ui_threads(0), ui_start(0), ui_end(0), b_active(false)
+	{
+	} // end default constructor
+
+
+	Profiler::~Profiler(void)
+	{
+		alignedFree(t_a_threads);
+	} // end destructor
+
+
+	/// <summary>
+	///          Clears all records and starts profiling a run.
+	/// </summary>
+	/// <param name="ui_threads">
+	///          Number of threads of the team running the GA.
+	/// </param>
+	/// <param name="i_generations">
+	///          Expected number of generations, reserved up front so the GA loop does not allocate.
+	/// </param>
+	/// <exception cref="std::bad_alloc">Thrown if the records cannot be allocated.</exception>
+	void Profiler::begin(const std::size_t ui_threads, const int i_generations)
+	{
+		b_active = false;
+
+		if (ui_threads != this->ui_threads)
+		{
+			alignedFree(t_a_threads);
+			t_a_threads = nullptr;
+			this->ui_threads = 0;
+			t_a_threads = static_cast<ThreadProfile*>(alignedAlloc(ui_threads * sizeof(ThreadProfile)));
+			this->ui_threads = ui_threads;
+		} // end if
+
+		memset(static_cast<void*>(t_a_threads), 0, ui_threads * sizeof(ThreadProfile));
+
+		ui_v_generations.clear();
+		ui_v_generations.reserve(static_cast<std::size_t>(std::max(i_generations, 0)) * PROFILE_STAGES);
+
+		localRejections() = 0;
+		ui_start = now();
+		ui_end = ui_start;
+		b_active = true;
+	} // end method begin
+
+
+	/// <summary>
+	///          Id of the calling thread in the innermost OpenMP team of more than one thread, the index of its record. An
+	///          island thread running an operator's region as a team of one keeps its island's record.
+	/// </summary>
+	std::size_t Profiler::threadId(void) noexcept
+	{
+		for (int i_level = omp_get_level(); i_level > 0; i_level--)
+		{
+			if (omp_get_team_size(i_level) > 1)
+			{
+				return static_cast<std::size_t>(omp_get_ancestor_thread_num(i_level));
+			} // end if
+		} // end for i_level
+
+		return 0;
+	} // end method threadId
+
+
+	/// <summary>
+	///          Opens the record of the next generation; stage times go to the latest one. Only thread 0 keeps the
+	///          generation records, so on islands they are island 0's.
+	/// </summary>
+	void Profiler::nextGeneration(void)
+	{
+		if (b_active && threadId() == 0)
+		{
+			ui_v_generations.resize(ui_v_generations.size() + PROFILE_STAGES, 0);
+		} // end if
+	} // end method nextGeneration
+
+
+	/// <summary>
+	///          Stops profiling, the records stay available for the reports.
+	/// </summary>
+	void Profiler::end(void) noexcept
+	{
+		if (b_active)
+		{
+			ui_end = now();
+			b_active = false;
+		} // end if
+	} // end method end
+
+
+	/// <summary>
+	///          Wall time of <paramref name="e_stage"/> summed over all generations, in ns.
+	/// </summary>
+	std::uint64_t Profiler::stageTotal(const Stage e_stage) const noexcept
+	{
+		std::uint64_t ui_total = 0;
+
+		for (std::size_t i = static_cast<std::size_t>(e_stage); i < ui_v_generations.size(); i += PROFILE_STAGES)
+		{
+			ui_total += ui_v_generations[i];
+		} // end for i
+
+		return ui_total;
+	} // end method stageTotal
+
+
+	/// <summary>
+	///          <paramref name="e_counter"/> summed over all threads.
+	/// </summary>
+	std::uint64_t Profiler::counterTotal(const Counter e_counter) const noexcept
+	{
+		std::uint64_t ui_total = 0;
+
+		for (std::size_t t = 0; t < ui_threads; t++)
+		{
+			ui_total += t_a_threads[t].ui_a_counters[static_cast<std::size_t>(e_counter)];
+		} // end for t
+
+		return ui_total;
+	} // end method counterTotal
+
+
+	/// <summary>
+	///          Time <paramref name="ui_thread"/> did not spend working while <paramref name="ui_stage"/> ran, in us.
+	/// </summary>
+	double Profiler::idleMicroseconds(const std::size_t ui_thread, const std::size_t ui_stage) const noexcept
+	{
+		const std::uint64_t ui_wall = stageTotal(static_cast<Stage>(ui_stage));
+		const std::uint64_t ui_busy = t_a_threads[ui_thread].ui_a_busy[ui_stage];
+
+		return toMicroseconds(ui_wall > ui_busy ? ui_wall - ui_busy : 0);
+	} // end method idleMicroseconds
+
+
+	/// <summary>
+	///          Writes the full report as one JSON object: run totals, per-stage statistics, per-thread busy and idle time of
+	///          every stage with a per-thread probe, counters and the stage times of every generation. Times are in us.
+	/// </summary>
+	/// <param name="out">
+	///          Stream to write to.
+	/// </param>
+	void Profiler::writeJson(std::ostream& out) const
+	{
+		const std::size_t ui_generations = ui_v_generations.size() / PROFILE_STAGES;
+
+		out << std::fixed << std::setprecision(3);
+		out << "{\n";
+		out << "  \"threads\": " << ui_threads << ",\n";
+		out << "  \"generations\": " << ui_generations << ",\n";
+		out << "  \"wall_us\": " << toMicroseconds(ui_end - ui_start) << ",\n";
+
+		out << "  \"stages\": {\n";
+		for (std::size_t s = 0; s < PROFILE_STAGES; s++)
+		{
+			std::uint64_t ui_max = 0;
+
+			for (std::size_t g = 0; g < ui_generations; g++)
+			{
+				ui_max = std::max(ui_max, ui_v_generations[g * PROFILE_STAGES + s]);
+			} // end for g
+
+			const std::uint64_t ui_total = stageTotal(static_cast<Stage>(s));
+
+			out << "    \"" << stageName(static_cast<Stage>(s)) << "\": { \"total_us\": " << toMicroseconds(ui_total)
+				<< ", \"mean_us\": " << (ui_generations > 0 ? toMicroseconds(ui_total) / ui_generations : 0.0)
+				<< ", \"max_us\": " << toMicroseconds(ui_max) << " }" << (s + 1 < PROFILE_STAGES ? "," : "") << "\n";
+		} // end for s
+		out << "  },\n";
+
+		out << "  \"thread_times\": [\n";
+		for (std::size_t t = 0; t < ui_threads; t++)
+		{
+			bool b_first = true;
+
+			out << "    { \"thread\": " << t << ", \"busy_us\": {";
+			for (std::size_t s = 0; s < PROFILE_STAGES; s++)
+			{
+				if (t_a_threads[t].b_a_timed[s] || t_a_threads[0].b_a_timed[s])
+				{
+					out << (b_first ? " " : ", ") << "\"" << stageName(static_cast<Stage>(s)) << "\": " << toMicroseconds(t_a_threads[t].ui_a_busy[s]);
+					b_first = false;
+				} // end if
+			} // end for s
+
+			b_first = true;
+			out << " }, \"idle_us\": {";
+			for (std::size_t s = 0; s < PROFILE_STAGES; s++)
+			{
+				if (t_a_threads[t].b_a_timed[s] || t_a_threads[0].b_a_timed[s])
+				{
+					out << (b_first ? " " : ", ") << "\"" << stageName(static_cast<Stage>(s)) << "\": " << idleMicroseconds(t, s);
+					b_first = false;
+				} // end if
+			} // end for s
+			out << " } }" << (t + 1 < ui_threads ? "," : "") << "\n";
+		} // end for t
+		out << "  ],\n";
+
+		out << "  \"counters\": {";
+		for (std::size_t c = 0; c < PROFILE_COUNTERS; c++)
+		{
+			out << (c == 0 ? " " : ", ") << "\"" << counterName(static_cast<Counter>(c)) << "\": " << counterTotal(static_cast<Counter>(c));
+		} // end for c
+		out << " },\n";
+
+		out << "  \"stage_order\": [";
+		for (std::size_t s = 0; s < PROFILE_STAGES; s++)
+		{
+			out << (s == 0 ? "" : ", ") << "\"" << stageName(static_cast<Stage>(s)) << "\"";
+		} // end for s
+		out << "],\n";
+
+		out << "  \"generation_us\": [\n";
+		for (std::size_t g = 0; g < ui_generations; g++)
+		{
+			out << "    [";
+			for (std::size_t s = 0; s < PROFILE_STAGES; s++)
+			{
+				out << (s == 0 ? "" : ", ") << toMicroseconds(ui_v_generations[g * PROFILE_STAGES + s]);
+			} // end for s
+			out << "]" << (g + 1 < ui_generations ? "," : "") << "\n";
+		} // end for g
+		out << "  ]\n";
+		out << "}\n";
+	} // end method writeJson
+
+
+	/// <summary>
+	///          Writes the report as "kind,index,name,value" rows: stage wall times by generation, busy and idle time by thread,
+	///          and the counters. Times are in us.
+	/// </summary>
+	/// <param name="out">
+	///          Stream to write to.
+	/// </param>
+	void Profiler::writeCsv(std::ostream& out) const
+	{
+		const std::size_t ui_generations = ui_v_generations.size() / PROFILE_STAGES;
+
+		out << std::fixed << std::setprecision(3);
+		out << "kind,index,name,value\n";
+		out << "wall,0,run," << toMicroseconds(ui_end - ui_start) << "\n";
+
+		for (std::size_t g = 0; g < ui_generations; g++)
+		{
+			for (std::size_t s = 0; s < PROFILE_STAGES; s++)
+			{
+				out << "stage," << g << "," << stageName(static_cast<Stage>(s)) << "," << toMicroseconds(ui_v_generations[g * PROFILE_STAGES + s]) << "\n";
+			} // end for s
+		} // end for g
+
+		for (std::size_t t = 0; t < ui_threads; t++)
+		{
+			for (std::size_t s = 0; s < PROFILE_STAGES; s++)
+			{
+				if (t_a_threads[t].b_a_timed[s] || t_a_threads[0].b_a_timed[s])
+				{
+					out << "busy," << t << "," << stageName(static_cast<Stage>(s)) << "," << toMicroseconds(t_a_threads[t].ui_a_busy[s]) << "\n";
+					out << "idle," << t << "," << stageName(static_cast<Stage>(s)) << "," << idleMicroseconds(t, s) << "\n";
+				} // end if
+			} // end for s
+		} // end for t
+
+		for (std::size_t c = 0; c < PROFILE_COUNTERS; c++)
+		{
+			out << "counter,0," << counterName(static_cast<Counter>(c)) << "," << counterTotal(static_cast<Counter>(c)) << "\n";
+		} // end for c
+	} // end method writeCsv
+
+
+	/// <summary>
+	///          Writes one line of total stage times in us, for the run log.
+	/// </summary>
+	/// <param name="out">
+	///          Stream to write to.
+	/// </param>
+	void Profiler::writeSummary(std::ostream& out) const
+	{
+		out << "stage times (us):";
+
+		for (std::size_t s = 0; s < PROFILE_STAGES; s++)
+		{
+			out << " " << stageName(static_cast<Stage>(s)) << " = " << stageTotal(static_cast<Stage>(s)) / 1000;
+		} // end for s
+
+		out << std::endl;
+	} // end method writeSummary
+
+
+	/// <summary>
+	///          The process-wide profiler all probes report to.
+	/// </summary>
+	Profiler& profiler(void) noexcept
+	{
+		static Profiler instance;
+
+		return instance;
+	} // end method profiler
+
+
+	/// <summary>
+	///          Name of <paramref name="e_stage"/> as used in the reports.
+	/// </summary>
+	const char* stageName(const Stage e_stage) noexcept
+	{
+		switch (e_stage)
+		{
+			case Stage::validate:  return "validate";
+			case Stage::evaluate:  return "evaluate";
+			case Stage::rank:      return "rank";
+			case Stage::adapt:     return "adapt";
+			case Stage::select:    return "select";
+			case Stage::crossover: return "crossover";
+			case Stage::mutate:    return "mutate";
+			case Stage::localSearch: return "local_search";
+			case Stage::populate:  return "populate";
+			case Stage::pipeline:  return "pipeline";
+		} // end switch
+
+		return "unknown";
+	} // end method stageName
+
+
+	/// <summary>
+	///          Name of <paramref name="e_counter"/> as used in the reports.
+	/// </summary>
+	const char* counterName(const Counter e_counter) noexcept
+	{
+		switch (e_counter)
+		{
+			case Counter::distanceLookups:  return "distance_lookups";
+			case Counter::rngDraws:         return "rng_draws";
+			case Counter::rejectionRetries: return "rejection_retries";
+			case Counter::allocations:      return "allocations";
+		} // end switch
+
+		return "unknown";
+	} // end method counterName
+
+#pragma endregion
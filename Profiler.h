@@ -0,0 +1,233 @@
+#ifndef _PROFILER_H_
+#define _PROFILER_H_
+
+#pragma region Includes:
+
+	#include <cstddef>      // std::size_t
+	#include <cstdint>      // std::uint64_t
+	#include <chrono>       // steady clock
+	#include <ostream>      // std::ostream
+	#include <vector>       // std::vector
+
+#pragma endregion
+
+
+#pragma region Defines:
+
+	#ifndef ENABLE_PROFILING
+		#define ENABLE_PROFILING    1     // 0 compiles every probe below out of the GA
+	#endif
+
+	#define PROFILE_STAGES      10    // number of Stage values
+	#define PROFILE_COUNTERS    4     // number of Counter values
+
+	#if ENABLE_PROFILING
+		#define PROFILE_STAGE(e_stage)            const ScopedStage profile_stage_(e_stage)
+		#define PROFILE_THREAD(e_stage)           const ScopedThreadWork profile_thread_(e_stage)
+		#define PROFILE_COUNT(e_counter, ui_n)    profiler().count(e_counter, ui_n)
+		#define PROFILE_LOCAL(name)               std::uint64_t name = 0
+		#define PROFILE_TALLY(name, ui_n)         (name += (ui_n))
+		#define PROFILE_REJECTION()               (++localRejections())
+	#else
+		#define PROFILE_STAGE(e_stage)            ((void)0)
+		#define PROFILE_THREAD(e_stage)           ((void)0)
+		#define PROFILE_COUNT(e_counter, ui_n)    ((void)0)
+		#define PROFILE_LOCAL(name)               ((void)0)
+		#define PROFILE_TALLY(name, ui_n)         ((void)0)
+		#define PROFILE_REJECTION()               ((void)0)
+	#endif
+
+#pragma endregion
+
+
+// Stages of a generation, in the order run() executes them.
+enum class Stage
+{
+	validate,    // only timed when the validation stage is on
+	evaluate,
+	rank,
+	adapt,       // mutation controller, measures diversity under the adaptive schedule
+	select,
+	crossover,
+	mutate,
+	localSearch, // only timed when the local search stage is on
+	populate,
+	pipeline     // select to populate as one task graph, replaces those five stages under --pipeline=tasks
+}; // end enum Stage
+
+
+// Hot operations counted by the probes.
+enum class Counter
+{
+	distanceLookups,  // city-to-city distances read by evaluate and crossover
+	rngDraws,         // bounded random draws requested by the operators
+	rejectionRetries, // draws thrown away: randomBelow rejections and mutate's i == j retries
+	allocations       // heap blocks allocated while the profiler was active
+}; // end enum Counter
+
+
+/// <summary>
+///          The calling thread's tally of rejected random draws. Bumping a thread-local keeps the slow path of
+///          randomBelow free of calls; the tally is moved to the profiler whenever the thread closes a ScopedThreadWork.
+/// </summary>
+inline std::uint64_t& localRejections(void) noexcept
+{
+	thread_local std::uint64_t ui_rejections = 0;
+
+	return ui_rejections;
+} // end method localRejections
+
+
+// Per-run instrumentation of the GA loop.
+//
+// Stage wall times are taken by the calling thread per generation (ScopedStage around each operator call); in an
+// island run every island is such a thread and island 0's times are kept.
+// Inside the parallel regions every thread times its own share of the work (ScopedThreadWork placed before a
+// nowait loop), so the rest of the stage's wall time is what the thread spent idle at barriers or waiting for
+// serial sections. Counters are per thread and only summed for the report; each thread's slot is a cache line
+// of its own. Probes do nothing unless a run is active, so benchmarks linking the operators pay one branch.
+class Profiler
+{
+public:
+	Profiler(void) noexcept;
+	~Profiler(void);
+
+	Profiler(const Profiler&) = delete;
+	Profiler& operator=(const Profiler&) = delete;
+
+	void begin(const std::size_t ui_threads, const int i_generations);
+	void nextGeneration(void);
+	void end(void) noexcept;
+
+	void writeJson(std::ostream& out) const;
+	void writeCsv(std::ostream& out) const;
+	void writeSummary(std::ostream& out) const;
+
+	std::uint64_t stageTotal(const Stage e_stage) const noexcept;
+	std::uint64_t counterTotal(const Counter e_counter) const noexcept;
+
+	inline bool active(void) const noexcept { return b_active; }
+
+	/// <summary>
+	///          Adds <paramref name="ui_n"/> to the calling thread's <paramref name="e_counter"/>.
+	/// </summary>
+	inline void count(const Counter e_counter, const std::uint64_t ui_n) noexcept
+	{
+		if (!b_active)
+		{
+			return;
+		} // end if
+
+		const std::size_t ui_thread = threadId();
+
+		if (ui_thread < ui_threads)
+		{
+			t_a_threads[ui_thread].ui_a_counters[static_cast<std::size_t>(e_counter)] += ui_n;
+		} // end if
+	} // end method count
+
+	/// <summary>
+	///          Adds <paramref name="ui_ns"/> nanoseconds of work in <paramref name="e_stage"/> to the calling thread.
+	/// </summary>
+	inline void addBusy(const Stage e_stage, const std::uint64_t ui_ns) noexcept
+	{
+		if (!b_active)
+		{
+			return;
+		} // end if
+
+		const std::size_t ui_thread = threadId();
+
+		if (ui_thread < ui_threads)
+		{
+			t_a_threads[ui_thread].ui_a_busy[static_cast<std::size_t>(e_stage)] += ui_ns;
+			t_a_threads[ui_thread].b_a_timed[static_cast<std::size_t>(e_stage)] = true;
+			t_a_threads[ui_thread].ui_a_counters[static_cast<std::size_t>(Counter::rejectionRetries)] += localRejections();
+		} // end if
+
+		localRejections() = 0;
+	} // end method addBusy
+
+	/// <summary>
+	///          Adds <paramref name="ui_ns"/> nanoseconds of wall time to <paramref name="e_stage"/> of the current generation,
+	///          if the caller is thread 0.
+	/// </summary>
+	inline void addStage(const Stage e_stage, const std::uint64_t ui_ns) noexcept
+	{
+		if (b_active && !ui_v_generations.empty() && threadId() == 0)
+		{
+			ui_v_generations[ui_v_generations.size() - PROFILE_STAGES + static_cast<std::size_t>(e_stage)] += ui_ns;
+		} // end if
+	} // end method addStage
+
+	static inline std::uint64_t now(void) noexcept
+	{
+		return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+	} // end method now
+
+private:
+	// Everything one thread records, padded to whole cache lines (64 bytes, see CACHE_LINE_SIZE) so threads
+	// never share a line.
+	struct alignas(64) ThreadProfile
+	{
+		std::uint64_t ui_a_busy[PROFILE_STAGES];       // ns spent working in each stage
+		std::uint64_t ui_a_counters[PROFILE_COUNTERS]; // counter values
+		bool          b_a_timed[PROFILE_STAGES];       // whether the stage has a per-thread probe at all
+	}; // end struct ThreadProfile
+
+	// out of line so every translation unit agrees on it, with or without -fopenmp
+	static std::size_t threadId(void) noexcept;
+
+	double idleMicroseconds(const std::size_t ui_thread, const std::size_t ui_stage) const noexcept;
+
+	ThreadProfile*             t_a_threads;      // ui_threads slots, cache-line aligned
+	std::size_t                ui_threads;       // number of slots
+	std::vector<std::uint64_t> ui_v_generations; // PROFILE_STAGES wall times in ns per generation
+	std::uint64_t              ui_start;         // begin() time in ns
+	std::uint64_t              ui_end;           // end() time in ns
+	bool                       b_active;         // between begin() and end()
+}; // end class Profiler
+
+
+#pragma region Prototypes:
+
+	Profiler& profiler(void) noexcept;
+	const char* stageName(const Stage e_stage) noexcept;
+	const char* counterName(const Counter e_counter) noexcept;
+
+#pragma endregion
+
+
+// Times the enclosing scope as wall time of a stage of the current generation.
+class ScopedStage
+{
+public:
+	explicit ScopedStage(const Stage e_stage) noexcept : e_stage(e_stage), ui_start(Profiler::now()) {}
+	~ScopedStage(void) { profiler().addStage(e_stage, Profiler::now() - ui_start); }
+
+	ScopedStage(const ScopedStage&) = delete;
+	ScopedStage& operator=(const ScopedStage&) = delete;
+
+private:
+	const Stage         e_stage;  // stage being timed
+	const std::uint64_t ui_start; // construction time in ns
+}; // end class ScopedStage
+
+
+// Times the enclosing scope as the calling thread's work in a stage. Put it at the top of a parallel region whose
+// loops are nowait, so the scope closes before the thread reaches the region's closing barrier.
+class ScopedThreadWork
+{
+public:
+	explicit ScopedThreadWork(const Stage e_stage) noexcept : e_stage(e_stage), ui_start(Profiler::now()) {}
+	~ScopedThreadWork(void) { profiler().addBusy(e_stage, Profiler::now() - ui_start); }
+
+	ScopedThreadWork(const ScopedThreadWork&) = delete;
+	ScopedThreadWork& operator=(const ScopedThreadWork&) = delete;
+
+private:
+	const Stage         e_stage;  // stage being timed
+	const std::uint64_t ui_start; // construction time in ns
+}; // end class ScopedThreadWork
+
+#endif
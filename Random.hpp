@@ -0,0 +1,256 @@
+#ifndef __RANDOM_H__
+#define __RANDOM_H__
+
+#pragma region Includes:
+
+	#include <algorithm>     // std::copy
+	#include <cstdint>       // std::uint32_t, std::uint64_t
+	#include <limits>        // numeric limits
+	#include <random>        // random device
+	#include <type_traits>   // std::make_unsigned
+	#include <vector>        // std::vector
+	#include "Profiler.h"    // PROFILE_REJECTION
+	#ifdef _OPENMP
+		#include <omp.h>     // omp_get_thread_num
+	#endif
+
+#pragma endregion
+
+
+#pragma region Classes:
+
+	// xoshiro256** pseudo-random generator (Blackman and Vigna).
+	//
+	// 32 bytes of state, a handful of shifts and rotates per draw and no shared data, so every thread can own
+	// one. Meets the UniformRandomBitGenerator requirements and can be passed to std::shuffle and friends.
+	class Xoshiro256
+	{
+	public:
+		typedef std::uint64_t result_type;
+
+		static constexpr result_type min(void) noexcept { return 0; }
+		static constexpr result_type max(void) noexcept { return std::numeric_limits<result_type>::max(); }
+
+		Xoshiro256(void)
+		{
+			std::random_device rd{};
+			seed((static_cast<std::uint64_t>(rd()) << 32) ^ rd(), 0);
+		} // end default constructor
+
+		Xoshiro256(const std::uint64_t ui_seed, const std::uint64_t ui_stream) noexcept
+		{
+			seed(ui_seed, ui_stream);
+		} // end constructor
+
+		/// <summary>
+		///          Derives the state from <paramref name="ui_seed"/> and <paramref name="ui_stream"/> through splitmix64,
+		///          so neighbouring seeds and streams still start far apart.
+		/// </summary>
+		/// <param name="ui_seed">
+		///                    The master seed.
+		/// </param>
+		/// <param name="ui_stream">
+		///                    Stream number, e.g. the id of the thread owning this engine.
+		/// </param>
+		void seed(const std::uint64_t ui_seed, const std::uint64_t ui_stream) noexcept
+		{
+			std::uint64_t ui_mix = ui_seed ^ (ui_stream * 0xD1B54A32D192ED03ull);
+
+			for (int i = 0; i < 4; i++)
+			{
+				ui_mix += 0x9E3779B97F4A7C15ull;
+
+				std::uint64_t z = ui_mix;
+				z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+				z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+				ui_a_state[i] = z ^ (z >> 31);
+			} // end for i
+		} // end method seed
+
+		inline result_type operator()(void) noexcept
+		{
+			const std::uint64_t ui_result = rotl(ui_a_state[1] * 5, 7) * 9;
+			const std::uint64_t ui_t = ui_a_state[1] << 17;
+
+			ui_a_state[2] ^= ui_a_state[0];
+			ui_a_state[3] ^= ui_a_state[1];
+			ui_a_state[1] ^= ui_a_state[2];
+			ui_a_state[0] ^= ui_a_state[3];
+			ui_a_state[2] ^= ui_t;
+			ui_a_state[3] = rotl(ui_a_state[3], 45);
+
+			return ui_result;
+		} // end operator ()
+
+		inline const std::uint64_t* state(void) const noexcept { return ui_a_state; }
+
+		inline void setState(const std::uint64_t ui_a_newState[4]) noexcept
+		{
+			for (int i = 0; i < 4; i++)
+			{
+				ui_a_state[i] = ui_a_newState[i];
+			} // end for i
+		} // end method setState
+
+	private:
+		static inline std::uint64_t rotl(const std::uint64_t x, const int k) noexcept { return (x << k) | (x >> (64 - k)); }
+
+		std::uint64_t ui_a_state[4];
+	}; // end class Xoshiro256
+
+#pragma endregion
+
+
+#pragma region Functions:
+
+	/// <summary>
+	///          The calling thread's random engine. Engines are never shared, so drawing needs no synchronization.
+	///          Until <see cref="seedThreads"/> runs, each engine is seeded from the random device.
+	/// </summary>
+	/// <returns>
+	///          The engine owned by the calling thread.
+	/// </returns>
+	inline Xoshiro256& localEngine(void) noexcept
+	{
+		thread_local Xoshiro256 engine;
+
+		return engine;
+	} // end method localEngine
+
+
+	/// <summary>
+	///          Seeds the engine of every thread of the next OpenMP team from <paramref name="ui_seed"/> and the thread id.
+	///          Call after omp_set_num_threads so the team matches the one running the GA; together with static loop
+	///          schedules this makes a run reproducible from its seed and thread count.
+	/// </summary>
+	/// <param name="ui_seed">
+	///                    The master seed.
+	/// </param>
+	inline void seedThreads(const std::uint64_t ui_seed) noexcept
+	{
+		#ifdef _OPENMP
+			#pragma omp parallel
+			{
+				localEngine().seed(ui_seed, static_cast<std::uint64_t>(omp_get_thread_num()));
+			} // end parallel
+		#else
+			localEngine().seed(ui_seed, 0);
+		#endif
+	} // end method seedThreads
+
+
+	/// <summary>
+	///          Copies the engine state of every thread of the next OpenMP team into <paramref name="ui_v_states"/>, four
+	///          words per thread in thread id order, so a checkpoint can resume the exact same draws.
+	/// </summary>
+	inline void captureEngines(std::vector<std::uint64_t>& ui_v_states)
+	{
+		#ifdef _OPENMP
+			ui_v_states.resize(4 * static_cast<std::size_t>(omp_get_max_threads()));
+
+			#pragma omp parallel
+			{
+				const std::uint64_t* ui_a_state = localEngine().state();
+				const std::size_t ui_thread = static_cast<std::size_t>(omp_get_thread_num());
+
+				std::copy(ui_a_state, ui_a_state + 4, ui_v_states.begin() + 4 * ui_thread);
+			} // end parallel
+		#else
+			ui_v_states.assign(localEngine().state(), localEngine().state() + 4);
+		#endif
+	} // end method captureEngines
+
+
+	/// <summary>
+	///          Sets the engine of every thread of the next OpenMP team to the states <see cref="captureEngines"/> saved;
+	///          the team must have as many threads as the one captured.
+	/// </summary>
+	inline void restoreEngines(const std::uint64_t* ui_a_states) noexcept
+	{
+		#ifdef _OPENMP
+			#pragma omp parallel
+			{
+				localEngine().setState(ui_a_states + 4 * omp_get_thread_num());
+			} // end parallel
+		#else
+			localEngine().setState(ui_a_states);
+		#endif
+	} // end method restoreEngines
+
+
+	/// <summary>
+	///          Draws a uniformly distributed value in [0, <paramref name="ui_range"/>) without division bias, using Lemire's
+	///          multiply-and-reject method; the modulo is only computed on the rare slow path.
+	/// </summary>
+	/// <param name="engine">
+	///                    The engine to draw from.
+	/// </param>
+	/// <param name="ui_range">
+	///                    Number of possible values, must be non-zero.
+	/// </param>
+	/// <returns>
+	///          A value in [0, <paramref name="ui_range"/>).
+	/// </returns>
+	inline std::uint64_t randomBelow(Xoshiro256& engine, const std::uint64_t ui_range) noexcept
+	{
+		if (ui_range <= 0xFFFFFFFFull)
+		{
+			const std::uint32_t ui_range32 = static_cast<std::uint32_t>(ui_range);
+			std::uint64_t ui_product = (engine() >> 32) * ui_range32;
+			std::uint32_t ui_low = static_cast<std::uint32_t>(ui_product);
+
+			if (ui_low < ui_range32)
+			{
+				const std::uint32_t ui_threshold = static_cast<std::uint32_t>(-ui_range32) % ui_range32;
+
+				while (ui_low < ui_threshold)
+				{
+					PROFILE_REJECTION();
+					ui_product = (engine() >> 32) * ui_range32;
+					ui_low = static_cast<std::uint32_t>(ui_product);
+				} // end while
+			} // end if
+
+			return ui_product >> 32;
+		} // end if
+
+		// wide ranges are rare, plain rejection of the incomplete last block
+		const std::uint64_t ui_threshold = (0 - ui_range) % ui_range;
+		std::uint64_t ui_draw = engine();
+
+		while (ui_draw < ui_threshold)
+		{
+			PROFILE_REJECTION();
+			ui_draw = engine();
+		} // end while
+
+		return ui_draw % ui_range;
+	} // end method randomBelow
+
+
+	/// <summary>
+	///          Draws a uniformly distributed integer in [<paramref name="t_MIN"/>, <paramref name="t_MAX"/>] from the calling
+	///          thread's engine.
+	/// </summary>
+	/// <typeparam name="T">
+	///                     Some <see cref="std::IntType"/>.
+	/// </typeparam>
+	template<typename T>
+	inline T randomInRange(const T t_MIN, const T t_MAX) noexcept
+	{
+		typedef typename std::make_unsigned<T>::type U;
+
+		const std::uint64_t ui_range = static_cast<std::uint64_t>(static_cast<U>(t_MAX) - static_cast<U>(t_MIN)) + 1;
+
+		// the full 64-bit range wraps to 0
+		if (ui_range == 0)
+		{
+			return static_cast<T>(localEngine()());
+		} // end if
+
+		return static_cast<T>(static_cast<U>(t_MIN) + static_cast<U>(randomBelow(localEngine(), ui_range)));
+	} // end template randomInRange
+
+#pragma endregion
+
+#endif
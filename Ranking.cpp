@@ -0,0 +1,336 @@
+#pragma region Includes:
+
+	#include "Ranking.h"   // RankingMode
+	#include <omp.h>       // omp directives
+	#include <algorithm>   // std::sort, std::nth_element
+	#include <vector>      // std::vector
+	#include <string.h>    // memcpy, strcmp
+
+#pragma endregion
+
+
+#pragma region Defines:
+
+	#define RADIX_BITS     11                    // widest digit of the radix selection
+	#define RADIX_BUCKETS  (1 << RADIX_BITS)     // histogram buckets per pass
+
+#pragma endregion
+
+
+#pragma region Helpers:
+
+	/// <summary>
+	///          Maps a float onto an unsigned integer with the same ordering, so keys can be selected digit by digit.
+	/// </summary>
+	static inline std::uint32_t orderedBits(const float f_value) noexcept
+	{
+		std::uint32_t ui_bits;
+
+		memcpy(&ui_bits, &f_value, sizeof(ui_bits));
+
+		return (ui_bits & 0x80000000u) ? ~ui_bits : (ui_bits | 0x80000000u);
+	} // end method orderedBits
+
+
+	/// <summary>
+	///          Swaps the smallest of the first <paramref name="i_count"/> keys to the front, ties go to the lowest index.
+	/// </summary>
+	/// <param name="keys">
+	///          The keys to scan.
+	/// </param>
+	/// <param name="i_count">
+	///          Number of keys to scan.
+	/// </param>
+	/// <param name="b_parallel">
+	///          Whether to scan with all threads.
+	/// </param>
+	static void moveBestToFront(Population::Key* keys, const long long i_count, const bool b_parallel)
+	{
+		long long i_best = 0;
+
+		#pragma omp parallel if(b_parallel)
+		{
+			long long i_localBest = -1;
+
+			#pragma omp for schedule(static) nowait
+			for (long long i = 0; i < i_count; i++)
+			{
+				if (i_localBest < 0 || keys[i].fitness < keys[i_localBest].fitness)
+				{
+					i_localBest = i;
+				} // end if
+			} // end for i
+
+			#pragma omp critical(ranking_best)
+			{
+				if (i_localBest >= 0 && (keys[i_localBest].fitness < keys[i_best].fitness || (keys[i_localBest].fitness == keys[i_best].fitness && i_localBest < i_best)))
+				{
+					i_best = i_localBest;
+				} // end if
+			} // end critical
+		} // end parallel
+
+		std::swap(keys[0], keys[i_best]);
+	} // end method moveBestToFront
+
+
+	/// <summary>
+	///          Finds the key value of rank <paramref name="ui_boundary"/> - 1 by a three pass radix selection, every pass a
+	///          parallel histogram over the keys still matching the digits found so far.
+	/// </summary>
+	/// <param name="keys">
+	///          The keys to select from.
+	/// </param>
+	/// <param name="i_size">
+	///          Number of keys.
+	/// </param>
+	/// <param name="ui_boundary">
+	///          Number of keys that must end up in front of the boundary, 0 &lt; ui_boundary &lt; size.
+	/// </param>
+	/// <param name="ui_below">
+	///          Output parameter for the number of keys strictly smaller than the returned value.
+	/// </param>
+	/// <returns>
+	///          The ordered bits of the last key in front of the boundary.
+	/// </returns>
+	static std::uint32_t selectThreshold(const Population::Key* keys, const long long i_size, const std::size_t ui_boundary, std::size_t& ui_below)
+	{
+		const int i_a_shifts[] = { 32 - RADIX_BITS, 32 - 2 * RADIX_BITS, 0 };
+		const std::uint32_t ui_a_masks[] = { RADIX_BUCKETS - 1, RADIX_BUCKETS - 1, (1u << (32 - 2 * RADIX_BITS)) - 1 };
+		const int nThreads = omp_get_max_threads();
+
+		std::vector<std::size_t> ui_v_histograms(static_cast<std::size_t>(nThreads) * RADIX_BUCKETS);
+		std::uint32_t ui_prefix = 0, ui_prefixMask = 0;
+		std::size_t ui_rank = ui_boundary - 1;
+
+		ui_below = 0;
+
+		for (int pass = 0; pass < 3; pass++)
+		{
+			const int i_shift = i_a_shifts[pass];
+			const std::uint32_t ui_digitMask = ui_a_masks[pass];
+
+			std::fill(ui_v_histograms.begin(), ui_v_histograms.end(), 0);
+
+			#pragma omp parallel
+			{
+				std::size_t* ui_a_histogram = ui_v_histograms.data() + static_cast<std::size_t>(omp_get_thread_num()) * RADIX_BUCKETS;
+
+				#pragma omp for schedule(static)
+				for (long long i = 0; i < i_size; i++)
+				{
+					const std::uint32_t ui_bits = orderedBits(keys[i].fitness);
+
+					if ((ui_bits & ui_prefixMask) == ui_prefix)
+					{
+						ui_a_histogram[(ui_bits >> i_shift) & ui_digitMask]++;
+					} // end if
+				} // end for i
+			} // end parallel
+
+			// find the digit whose bucket holds the key of the wanted rank
+			std::size_t ui_digit = 0, ui_cumulative = 0;
+
+			for (; ui_digit <= ui_digitMask; ui_digit++)
+			{
+				std::size_t ui_bucket = 0;
+
+				for (int t = 0; t < nThreads; t++)
+				{
+					ui_bucket += ui_v_histograms[static_cast<std::size_t>(t) * RADIX_BUCKETS + ui_digit];
+				} // end for t
+
+				if (ui_rank < ui_cumulative + ui_bucket)
+				{
+					break;
+				} // end if
+
+				ui_cumulative += ui_bucket;
+			} // end for ui_digit
+
+			ui_rank -= ui_cumulative;
+			ui_below += ui_cumulative;
+			ui_prefix |= static_cast<std::uint32_t>(ui_digit) << i_shift;
+			ui_prefixMask |= ui_digitMask << i_shift;
+		} // end for pass
+
+		return ui_prefix;
+	} // end method selectThreshold
+
+
+	/// <summary>
+	///          Parallel partition: the ui_boundary smallest keys go in front of the boundary, the rest behind it.
+	///          Every thread counts its chunk, the chunk offsets are prefix sums, then every thread scatters its chunk
+	///          into the scratch key array, which becomes the key array.
+	/// </summary>
+	static void rankParallel(Population& population, const std::size_t ui_boundary)
+	{
+		const long long i_size = static_cast<long long>(population.size());
+		const int nMaxThreads = omp_get_max_threads();
+
+		std::size_t ui_below = 0;
+		const std::uint32_t ui_threshold = selectThreshold(population.keys(), i_size, ui_boundary, ui_below);
+
+		std::vector<std::size_t> ui_v_less(nMaxThreads), ui_v_equal(nMaxThreads), ui_v_front(nMaxThreads), ui_v_back(nMaxThreads), ui_v_ties(nMaxThreads);
+		const Population::Key* keys = population.keys();
+		Population::Key* out = population.scratchKeys();
+
+		#pragma omp parallel
+		{
+			const int tid = omp_get_thread_num();
+			const int nThreads = omp_get_num_threads();
+			const long long i_begin = i_size * tid / nThreads;
+			const long long i_end = i_size * (tid + 1) / nThreads;
+
+			std::size_t ui_less = 0, ui_equal = 0;
+
+			for (long long i = i_begin; i < i_end; i++)
+			{
+				const std::uint32_t ui_bits = orderedBits(keys[i].fitness);
+
+				ui_less += (ui_bits < ui_threshold);
+				ui_equal += (ui_bits == ui_threshold);
+			} // end for i
+
+			ui_v_less[tid] = ui_less;
+			ui_v_equal[tid] = ui_equal;
+
+			#pragma omp barrier
+
+			#pragma omp single
+			{
+				// ties are handed out to the chunks in order until the front is full
+				std::size_t ui_tiesLeft = ui_boundary - ui_below;
+				std::size_t ui_front = 0, ui_back = ui_boundary;
+
+				for (int t = 0; t < nThreads; t++)
+				{
+					ui_v_ties[t] = std::min(ui_tiesLeft, ui_v_equal[t]);
+					ui_tiesLeft -= ui_v_ties[t];
+
+					ui_v_front[t] = ui_front;
+					ui_v_back[t] = ui_back;
+
+					const std::size_t ui_chunk = static_cast<std::size_t>(i_size * (t + 1) / nThreads - i_size * t / nThreads);
+					ui_front += ui_v_less[t] + ui_v_ties[t];
+					ui_back += ui_chunk - ui_v_less[t] - ui_v_ties[t];
+				} // end for t
+			} // end single
+
+			std::size_t ui_front = ui_v_front[tid], ui_back = ui_v_back[tid], ui_ties = ui_v_ties[tid];
+
+			for (long long i = i_begin; i < i_end; i++)
+			{
+				const std::uint32_t ui_bits = orderedBits(keys[i].fitness);
+
+				if (ui_bits < ui_threshold || (ui_bits == ui_threshold && ui_ties > 0))
+				{
+					ui_ties -= (ui_bits == ui_threshold);
+					out[ui_front++] = keys[i];
+				} // end if
+				else
+				{
+					out[ui_back++] = keys[i];
+				} // end else
+			} // end for i
+		} // end parallel
+
+		population.swapKeys();
+		moveBestToFront(population.keys(), static_cast<long long>(ui_boundary), true);
+	} // end method rankParallel
+
+#pragma endregion
+
+
+#pragma region Implementations:
+
+	/// <summary>
+	///          Ranking stage: rebuilds the keys of <paramref name="population"/> from its fitness values and orders them so
+	///          that keys()[0] is the best tour and the last <paramref name="ui_replaced"/> keys are the worst tours.
+	///          Beyond that the order depends on <paramref name="e_mode"/>.
+	/// </summary>
+	/// <param name="population">
+	///          The evaluated population.
+	/// </param>
+	/// <param name="ui_replaced">
+	///          Number of tours populate will overwrite.
+	/// </param>
+	/// <param name="e_mode">
+	///          Ranking algorithm to use.
+	/// </param>
+	void rank(Population& population, const std::size_t ui_replaced, const RankingMode e_mode)
+	{
+		const std::size_t ui_size = population.size();
+		const std::size_t ui_boundary = (ui_replaced < ui_size ? ui_size - ui_replaced : 0);
+		Population::Key* keys = population.keys();
+
+		population.refreshKeys();
+
+		if (ui_size == 0)
+		{
+			return;
+		} // end if
+
+		if (e_mode == RankingMode::sort)
+		{
+			std::sort(keys, keys + ui_size);
+		} // end if
+		else if (ui_boundary == 0 || ui_boundary == ui_size)
+		{
+			moveBestToFront(keys, static_cast<long long>(ui_size), e_mode == RankingMode::parallel);
+		} // end elif
+		else if (e_mode == RankingMode::partition)
+		{
+			std::nth_element(keys, keys + ui_boundary, keys + ui_size);
+			moveBestToFront(keys, static_cast<long long>(ui_boundary), false);
+		} // end elif
+		else
+		{
+			rankParallel(population, ui_boundary);
+		} // end else
+	} // end method rank
+
+
+	/// <summary>
+	///          Name of <paramref name="e_mode"/> as accepted by <see cref="parseRankingMode"/>.
+	/// </summary>
+	const char* rankingModeName(const RankingMode e_mode) noexcept
+	{
+		switch (e_mode)
+		{
+			case RankingMode::sort:      return "sort";
+			case RankingMode::partition: return "partition";
+			default:                     return "parallel";
+		} // end switch
+	} // end method rankingModeName
+
+
+	/// <summary>
+	///          Parses a ranking mode name.
+	/// </summary>
+	/// <param name="name">
+	///          One of sort, partition or parallel.
+	/// </param>
+	/// <param name="e_mode">
+	///          Output parameter for the parsed mode.
+	/// </param>
+	/// <returns>
+	///          true if <paramref name="name"/> is a known mode
+	/// </returns>
+	bool parseRankingMode(const char* name, RankingMode& e_mode) noexcept
+	{
+		const RankingMode e_a_all[] = { RankingMode::sort, RankingMode::partition, RankingMode::parallel };
+
+		for (const RankingMode e_candidate : e_a_all)
+		{
+			if (strcmp(name, rankingModeName(e_candidate)) == 0)
+			{
+				e_mode = e_candidate;
+				return true;
+			} // end if
+		} // end for
+
+		return false;
+	} // end method parseRankingMode
+
+#pragma endregion
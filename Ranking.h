@@ -0,0 +1,32 @@
+#ifndef _RANKING_H_
+#define _RANKING_H_
+
+#pragma region Includes:
+
+	#include <cstddef>      // std::size_t
+	#include "Population.h" // Population
+
+#pragma endregion
+
+
+// How much ordering the ranking stage establishes each generation.
+//
+// Consumers only need the best tour at rank 0 (reporting) and the worst ui_replaced tours at the
+// end of the key array (populate). Everything but sort gives exactly that and nothing more.
+enum class RankingMode
+{
+	sort,      // full O(n log n) sort of all keys, single thread
+	partition, // std::nth_element at the replacement boundary plus a scan for the best, single thread
+	parallel   // radix selection of the boundary and a scatter partition, all threads
+}; // end enum RankingMode
+
+
+#pragma region Prototypes:
+
+	void rank(Population& population, const std::size_t ui_replaced, const RankingMode e_mode);
+	const char* rankingModeName(const RankingMode e_mode) noexcept;
+	bool parseRankingMode(const char* name, RankingMode& e_mode) noexcept;
+
+#pragma endregion
+
+#endif
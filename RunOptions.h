@@ -0,0 +1,85 @@
+#ifndef _RUN_OPTIONS_H_
+#define _RUN_OPTIONS_H_
+
+#include "Affinity.h"      // AffinityPolicy
+#include "Checkpoint.h"    // CHECKPOINT_INTERVAL
+#include "EventLog.h"      // LogFormat
+#include "FitnessKernel.h" // KernelIsa
+#include "Island.h"        // MigrationTopology
+#include "MutationControl.h" // MutationSchedule
+#include "Pipeline.h"      // PipelineMode
+#include "Ranking.h"       // RankingMode
+#include "Trip.h"          // MAX_GENERATION
+#include "Validate.h"      // ValidationMode
+#include <cstddef>         // std::size_t
+#include <cstdint>         // std::uint64_t
+#include <string>          // std::string
+
+// How the GA operators look up the distance between two cities.
+enum class DistanceMode
+{
+	memo,   // lazily filled hash-of-hashes memo (distanceV2)
+	matrix  // dense table precomputed once after initialize (DistanceMatrix)
+}; // end enum DistanceMode
+
+
+// Options of a single GA run, filled from the command line.
+struct RunOptions
+{
+	int          nThreads       = 1;                    // number of threads
+	int          i_mutationRate = 50;                   // mutation rate in %, the floor of the adaptive schedule
+	MutationSchedule e_mutationSchedule = MutationSchedule::adaptive; // how the mutation rate develops over the run
+	double       d_diversityTarget = 0.5;               // diversity, 0 to 1, below which the adaptive schedule mutates harder
+	DistanceMode e_distanceMode = DistanceMode::matrix; // distance lookup used by the operators
+	KernelIsa    e_kernelIsa    = KernelIsa::automatic; // instruction set of the batch fitness kernel (matrix only)
+	RankingMode  e_rankingMode  = RankingMode::parallel; // ordering established after each evaluation
+	bool          b_hasSeed     = false;                 // whether ui_seed was given, drawn from the random device otherwise
+	std::uint64_t ui_seed       = 0;                     // master seed of the per-thread random engines
+	std::string   s_citiesFile      = "cities.txt";      // city coordinates, unless the population file carries them
+	std::string   s_chromosomeFile  = "chromosome.txt";  // text population, used when s_populationFile is empty
+	std::string   s_populationFile;                      // binary population file to map, or "random" to generate one
+	std::size_t   ui_population     = 0;                 // tours in the population, 0 for all the input holds
+	std::size_t   ui_offsprings     = 0;                 // tours replaced every generation, 0 for half the population
+	int           i_generations     = MAX_GENERATION;    // generations to run
+	std::string   s_profileFile;                         // profiler report, CSV if it ends in ".csv" and JSON otherwise
+	std::size_t   ui_islands        = 0;                 // independent sub-populations, one per thread; 0 splits every operator instead
+	int           i_migrationInterval = 10;              // generations between two migrations of an island
+	std::size_t   ui_migrants       = 2;                 // best tours an island sends per migration
+	MigrationTopology e_topology    = MigrationTopology::ring; // where an island or rank sends its migrants
+	double        d_localSearch     = 0.0;               // share of the offsprings improved by 2-opt and Or-opt each generation, 0 for none
+	long long     i_localBudget     = 0;                 // us the local search may take per generation, 0 for no limit
+	std::size_t   ui_ranks          = 1;                 // processes sharing the run, each evolving a shard of the population
+	std::size_t   ui_rank           = 0;                 // this process, rank 0 reports the run
+	bool          b_spawnRanks      = true;              // whether rank 0 forks the other ranks, false when every rank is started by hand
+	std::string   s_endpoint;                            // socket path prefix of the ranks, "<endpoint>.<rank>"
+	ValidationMode e_validation     = ValidationMode::count; // what the validation stage does about tours that are not permutations
+	double        d_validateSample  = 0.0625;            // share of the population validated each generation, 1 for all of it
+	long long     i_deadline        = 0;                 // ms after which the run stops, 0 for none
+	double        d_targetDistance  = 0.0;               // tour length at which the run stops, 0 for none
+	int           i_stagnation      = 0;                 // generations without a shorter tour after which the run stops, 0 for none
+	long long     i_evaluationBudget = 0;                // tour evaluations after which the run stops, 0 for none
+	std::string   s_checkpointFile;                      // snapshot written in the background every i_checkpointInterval generations, empty for none
+	int           i_checkpointInterval = CHECKPOINT_INTERVAL; // generations between two checkpoints
+	std::string   s_resumeFile;                          // snapshot to continue a run from, empty to start afresh
+	std::string   s_batchSource;                         // directory of cities files or "-" for job lines on stdin, empty for a single run
+	bool          b_profile         = true;              // whether evolve records into the profiler, off for batch jobs running side by side
+	std::string   s_serveEndpoint;                       // socket path or "tcp:PORT" the solver daemon listens on, empty for a single run
+	LogFormat     e_logFormat       = LogFormat::text;   // sink of the progress events of a single run
+	std::string   s_logFile;                             // file of the JSON and binary sinks, empty for the format's default
+	PipelineMode  e_pipeline        = PipelineMode::loops; // how select to populate share the threads, tasks needs the matrix distance mode
+	std::size_t   ui_chunks         = 0;                 // offspring chunks of the task pipeline, 0 to size them by PIPELINE_CHUNK_PAIRS
+	AffinityPolicy e_affinity       = AffinityPolicy::none; // CPUs the threads are pinned to, and so the NUMA nodes the populations live on
+}; // end struct RunOptions
+
+
+/// <summary>
+///          Whether jobs of <paramref name="options"/> can run side by side in one process, one thread each: the memoized
+///          distances are not thread-safe, and islands, ranks, checkpoints and profiles belong to a whole process.
+/// </summary>
+inline bool sharesProcess(const RunOptions& options) noexcept
+{
+	return options.ui_islands == 0 && options.ui_ranks <= 1 && options.s_checkpointFile.empty() && options.s_resumeFile.empty()
+		&& options.s_profileFile.empty() && options.e_distanceMode == DistanceMode::matrix;
+} // end method sharesProcess
+
+#endif
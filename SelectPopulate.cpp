@@ -0,0 +1,102 @@
+#pragma region Includes:
+
+	#include <string.h>       // memcpy
+	#include "utility.hpp"    // TOURNAMENT_SIZE
+	#include "Random.hpp"     // Xoshiro256
+	#include "Population.h"   // Population
+	#include "Profiler.h"     // PROFILE_THREAD, PROFILE_COUNT
+	#include "Tournament.hpp" // selectTournament, selectBlock
+
+#pragma endregion
+
+
+#pragma region Function Prototypes:
+
+	void select(const Population& population, std::uint32_t parents[], const std::size_t ui_parents);
+	void populate(Population& population, const Population& offsprings);
+	void selectRange(const Population& population, const std::size_t ui_offset, const std::size_t ui_begin, const std::size_t ui_end,
+					 std::uint32_t winners[], const std::size_t ui_winners, std::uint32_t available[], Xoshiro256& engine);
+	void populateRange(Population& population, const Population& offsprings, const std::size_t ui_first, const std::size_t ui_count);
+
+#pragma endregion
+
+
+/*
+ * Select ui_parents distinct parents from population by tournament
+ *
+ * @param population: all trips
+ * @param parents:    output, slots of the selected parents
+ * @param ui_parents: number of parents to select
+ */
+void select(const Population& population, std::uint32_t parents[], const std::size_t ui_parents)
+{
+	selectTournament(population.size(), ui_parents, [&population](const std::size_t ui_slot) { return population.fitness(ui_slot); }, parents);
+} // end method select
+
+
+/*
+ * Replace the bottom offsprings.size() ranked trips with the offsprings
+ */
+void populate(Population& population, const Population& offsprings)
+{
+	const long long i_count = static_cast<long long>(offsprings.size());
+
+	// copy each offspring into the slot of a bottom ranked trip, the key array says which slots those are
+	#pragma omp parallel
+	{
+		PROFILE_THREAD(Stage::populate);
+
+		#pragma omp for nowait
+		for (long long i = 0; i < i_count; i++)
+		{
+			populateRange(population, offsprings, static_cast<std::size_t>(i), 1);
+		} // end for
+	} // end parallel
+} // end method populate
+
+
+/*
+ * Select the winners of one tournament block on the calling thread, see selectTournament
+ *
+ * @param population: all trips
+ * @param ui_offset:  rotation of the tour order this generation
+ * @param ui_begin:   first tour of the block in the rotated order
+ * @param ui_end:     end of the block in the rotated order
+ * @param winners:    output, slots of the ui_winners selected parents
+ * @param available:  scratch space of ui_end - ui_begin entries
+ * @param engine:     engine of every draw
+ */
+void selectRange(const Population& population, const std::size_t ui_offset, const std::size_t ui_begin, const std::size_t ui_end,
+				 std::uint32_t winners[], const std::size_t ui_winners, std::uint32_t available[], Xoshiro256& engine)
+{
+	selectBlock(population.size(), ui_offset, ui_begin, ui_end, [&population](const std::size_t ui_slot) { return population.fitness(ui_slot); },
+				winners, ui_winners, available, engine);
+	PROFILE_COUNT(Counter::rngDraws, ui_winners * TOURNAMENT_SIZE);
+} // end method selectRange
+
+
+/*
+ * Replace the ranked trips of offsprings ui_first to ui_first + ui_count - 1 with them
+ */
+void populateRange(Population& population, const Population& offsprings, const std::size_t ui_first, const std::size_t ui_count)
+{
+	const std::size_t ui_firstReplaced = population.size() - offsprings.size();
+	const std::size_t ui_bytes = population.cities() * sizeof(gene_t);
+
+	for (std::size_t i = ui_first; i < ui_first + ui_count; i++)
+	{
+		const std::size_t ui_slot = population.slotOfRank(ui_firstReplaced + i);
+
+		memcpy(population.genome(ui_slot), offsprings.genome(i), ui_bytes);
+
+		// the offspring's score moves with it
+		if (offsprings.scored(i))
+		{
+			population.score(ui_slot, offsprings.fitness(i));
+		} // end if
+		else
+		{
+			population.invalidate(ui_slot);
+		} // end else
+	} // end for i
+} // end method populateRange
@@ -0,0 +1,250 @@
+// Submits jobs to the solver daemon (Tsp --serve=...) and prints the tours it streams back, or asks it for its metrics
+// or to shut down.
+// usage: tsp_client <endpoint> <cities file> [--size=N] [--generations=N] [--priority=P] [--deadline=ms] [--seed=N] [--target=L] [--jobs=N]
+//        tsp_client <endpoint> --stats|--shutdown
+//
+// The endpoint is the daemon's socket path or "tcp:PORT". --jobs submits the instance N times on one connection,
+// with seeds seed, seed + 1, ... when --seed is given; the client waits until every job finished or was rejected.
+
+#pragma region Includes:
+
+	#include <iostream>         // cout
+	#include <cstdlib>          // strtoll, strtod
+	#include <cstring>          // memcpy, strncmp
+	#include <string>           // std::string
+	#include <vector>           // std::vector
+	#include <stdexcept>        // std::exception, std::invalid_argument
+	#include <unistd.h>         // close
+	#include "utility.hpp"      // Point, highRes_Clock
+	#include "Instance.h"       // readCities, formatTour
+	#include "Stopping.h"       // StopReason, stopReasonName
+	#include "SolverProtocol.h" // connectEndpoint, writeFrame, readFrame
+
+#pragma endregion
+
+
+#pragma region Helpers:
+
+	/// <summary>
+	///          Reads the integer of "--<paramref name="c_name"/>=N" from <paramref name="c_arg"/>.
+	/// </summary>
+	/// <returns>
+	///          true if the argument is this option
+	/// </returns>
+	/// <exception cref="std::invalid_argument">Thrown if the value is not an integer.</exception>
+	static bool integerOption(const char* c_arg, const char* c_name, long long& i_value)
+	{
+		const std::size_t ui_length = strlen(c_name);
+
+		if (strncmp(c_arg, "--", 2) != 0 || strncmp(c_arg + 2, c_name, ui_length) != 0 || c_arg[2 + ui_length] != '=')
+		{
+			return false;
+		} // end if
+
+		char* c_end = nullptr;
+
+		i_value = strtoll(c_arg + 3 + ui_length, &c_end, 10);
+
+		if (c_end == c_arg + 3 + ui_length || *c_end != 0)
+		{
+			throw std::invalid_argument(std::string("Bad value in ") + c_arg + "!");
+		} // end if
+
+		return true;
+	} // end method integerOption
+
+
+	/// <summary>
+	///          Microseconds since <paramref name="start"/>.
+	/// </summary>
+	static inline long long since(const timePoint start) noexcept
+	{
+		return static_cast<long long>(std::chrono::duration_cast<std::chrono::microseconds>(highRes_Clock::now() - start).count());
+	} // end method since
+
+#pragma endregion
+
+
+int main(int argc, char* argv[])
+{
+	if (argc < 3)
+	{
+		std::cout << "usage: tsp_client <endpoint> <cities file> [--size=N] [--generations=N] [--priority=P] [--deadline=ms] [--seed=N] [--target=L] [--jobs=N]" << std::endl
+				  << "       tsp_client <endpoint> --stats|--shutdown" << std::endl;
+		return EXIT_FAILURE;
+	} // end if
+
+	try
+	{
+		const std::string s_endpoint = argv[1];
+		const std::string s_command = argv[2];
+		std::vector<unsigned char> payload;
+		FrameHeader header;
+
+		if (s_command == "--stats" || s_command == "--shutdown")
+		{
+			const int i_socket = connectEndpoint(s_endpoint);
+
+			if (s_command == "--shutdown")
+			{
+				const bool b_sent = writeFrame(i_socket, FrameKind::shutdown, 0, nullptr, 0);
+
+				close(i_socket);
+
+				return (b_sent ? EXIT_SUCCESS : EXIT_FAILURE);
+			} // end if
+
+			ServiceMetrics metrics;
+
+			if (!writeFrame(i_socket, FrameKind::stats, 0, nullptr, 0) || !readFrame(i_socket, header, payload) || payload.size() != sizeof(metrics))
+			{
+				close(i_socket);
+				std::cout << "The daemon did not answer! Exiting ..." << std::endl;
+				return EXIT_FAILURE;
+			} // end if
+
+			close(i_socket);
+			memcpy(&metrics, payload.data(), sizeof(metrics));
+
+			std::cout << "queued = " << metrics.i_queued << ", running = " << metrics.i_running << ", submitted = " << metrics.i_submitted
+					  << ", completed = " << metrics.i_completed << ", rejected = " << metrics.i_rejected << ", expired = " << metrics.i_expired << std::endl;
+			std::cout << "wait = " << metrics.d_meanWait << " us, latency = " << metrics.d_meanLatency << " us (p50 " << metrics.d_p50Latency
+					  << ", p99 " << metrics.d_p99Latency << "), throughput = " << metrics.d_throughput << " jobs/s, uptime = " << metrics.i_uptime << " us" << std::endl;
+
+			return EXIT_SUCCESS;
+		} // end if
+
+		const std::vector<Point> coordinates = readCities(argv[2]);
+		JobRequest request = { static_cast<std::uint32_t>(coordinates.size()), 0, 0, 0, 0, 0, 0.0f, 0 };
+		long long i_jobs = 1;
+
+		for (int i = 3; i < argc; i++)
+		{
+			long long i_value = 0;
+
+			if (integerOption(argv[i], "size", i_value))
+			{
+				request.ui_population = static_cast<std::uint32_t>(i_value);
+			} // end if
+			else if (integerOption(argv[i], "generations", i_value))
+			{
+				request.i_generations = static_cast<std::int32_t>(i_value);
+			} // end elif
+			else if (integerOption(argv[i], "priority", i_value))
+			{
+				request.i_priority = static_cast<std::int32_t>(i_value);
+			} // end elif
+			else if (integerOption(argv[i], "deadline", i_value))
+			{
+				request.i_deadline = i_value;
+			} // end elif
+			else if (integerOption(argv[i], "seed", i_value))
+			{
+				request.ui_seed = static_cast<std::uint64_t>(i_value);
+			} // end elif
+			else if (integerOption(argv[i], "jobs", i_value) && i_value > 0)
+			{
+				i_jobs = i_value;
+			} // end elif
+			else if (strncmp(argv[i], "--target=", 9) == 0)
+			{
+				request.f_target = static_cast<float>(strtod(argv[i] + 9, nullptr));
+			} // end elif
+			else
+			{
+				throw std::invalid_argument(std::string("Unknown option ") + argv[i] + "!");
+			} // end else
+		} // end for i
+
+		std::vector<std::int32_t> i_v_xy;
+
+		for (const Point& point : coordinates)
+		{
+			i_v_xy.push_back(point.x);
+			i_v_xy.push_back(point.y);
+		} // end for
+
+		const int i_socket = connectEndpoint(s_endpoint);
+		const timePoint start = highRes_Clock::now();
+		long long i_open = i_jobs;
+		int i_output = EXIT_SUCCESS;
+
+		for (long long j = 0; j < i_jobs; j++)
+		{
+			JobRequest copy = request;
+
+			copy.ui_seed = (request.ui_seed != 0 ? request.ui_seed + static_cast<std::uint64_t>(j) : 0);
+
+			if (!writeFrame(i_socket, FrameKind::submit, static_cast<std::uint32_t>(j + 1), &copy, sizeof(copy), i_v_xy.data(), i_v_xy.size() * sizeof(std::int32_t)))
+			{
+				close(i_socket);
+				std::cout << "Submitting to " << s_endpoint << " failed! Exiting ..." << std::endl;
+				return EXIT_FAILURE;
+			} // end if
+		} // end for j
+
+		// every job ends with a finished or a rejected frame
+		while (i_open > 0 && readFrame(i_socket, header, payload))
+		{
+			const FrameKind e_kind = static_cast<FrameKind>(header.ui_kind);
+			Receipt receipt;
+			TourReport report;
+
+			if (e_kind == FrameKind::accepted && payload.size() == sizeof(receipt))
+			{
+				memcpy(&receipt, payload.data(), sizeof(receipt));
+				std::cout << "job " << header.ui_job << ": accepted (tag " << receipt.ui_tag << ")" << std::endl;
+			} // end if
+			else if (e_kind == FrameKind::rejected && payload.size() >= sizeof(receipt))
+			{
+				memcpy(&receipt, payload.data(), sizeof(receipt));
+				std::cout << "job " << header.ui_job << ": rejected (tag " << receipt.ui_tag << "): "
+						  << std::string(payload.begin() + sizeof(receipt), payload.end()) << std::endl;
+				i_output = EXIT_FAILURE;
+				i_open--;
+			} // end elif
+			else if ((e_kind == FrameKind::improved || e_kind == FrameKind::finished) && payload.size() >= sizeof(report))
+			{
+				memcpy(&report, payload.data(), sizeof(report));
+
+				if (payload.size() != sizeof(report) + report.ui_cities * sizeof(gene_t))
+				{
+					break;
+				} // end if
+
+				if (e_kind == FrameKind::improved)
+				{
+					std::cout << "job " << header.ui_job << ": generation " << report.i_generation << ", distance = " << report.f_length
+							  << " after " << report.i_elapsed << " us" << std::endl;
+					continue;
+				} // end if
+
+				std::vector<gene_t> g_v_tour(report.ui_cities);
+
+				memcpy(g_v_tour.data(), payload.data() + sizeof(report), g_v_tour.size() * sizeof(gene_t));
+				std::cout << "job " << header.ui_job << ": finished, shortest distance = " << report.f_length << " at generation " << report.i_generation
+						  << ", stopped: " << stopReasonName(static_cast<StopReason>(report.ui_stopReason)) << ", waited " << report.i_waited
+						  << " us, ran " << report.i_elapsed << " us, latency " << since(start) << " us" << std::endl;
+				std::cout << "tour: " << formatTour(g_v_tour.data(), g_v_tour.size()) << std::endl;
+				i_open--;
+			} // end elif
+		} // end while
+
+		close(i_socket);
+
+		if (i_open > 0)
+		{
+			std::cout << "The daemon closed the connection with " << i_open << " jobs open!" << std::endl;
+			return EXIT_FAILURE;
+		} // end if
+
+		std::cout << i_jobs << " jobs, elapsed time = " << since(start) << " us" << std::endl;
+
+		return i_output;
+	} // end try
+	catch (const std::exception& e)
+	{
+		std::cout << e.what() << " Exiting ..." << std::endl;
+		return EXIT_FAILURE;
+	} // end catch
+} // end method main
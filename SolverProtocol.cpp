@@ -0,0 +1,278 @@
+#pragma region Includes:
+
+	#include "SolverProtocol.h" // FrameHeader, FrameKind
+	#include <cstdlib>          // strtoul
+	#include <stdexcept>        // std::runtime_error, std::invalid_argument
+	#include <errno.h>          // errno
+	#include <netinet/in.h>     // sockaddr_in
+	#include <arpa/inet.h>      // htons, htonl
+	#include <string.h>         // memcpy, memcmp, strerror
+	#include <sys/socket.h>     // socket, bind, listen, connect, sendmsg, recv
+	#include <sys/un.h>         // sockaddr_un
+	#include <unistd.h>         // close, unlink
+
+#pragma endregion
+
+
+#pragma region Helpers:
+
+	/// <summary>
+	///          Whether <paramref name="s_endpoint"/> names a loopback TCP port rather than a Unix socket path.
+	/// </summary>
+	static inline bool isTcp(const std::string& s_endpoint) noexcept
+	{
+		return s_endpoint.compare(0, sizeof(SERVICE_TCP_PREFIX) - 1, SERVICE_TCP_PREFIX) == 0;
+	} // end method isTcp
+
+
+	/// <summary>
+	///          Creates a stream socket for <paramref name="s_endpoint"/> and fills in its address.
+	/// </summary>
+	/// <returns>
+	///          The socket, and through the output parameters the address to bind or connect to
+	/// </returns>
+	/// <exception cref="std::invalid_argument">Thrown if the port is malformed or the path too long.</exception>
+	/// <exception cref="std::runtime_error">Thrown if the socket cannot be created.</exception>
+	static int openSocket(const std::string& s_endpoint, sockaddr_storage& address, socklen_t& ui_length)
+	{
+		memset(&address, 0, sizeof(address));
+
+		if (isTcp(s_endpoint))
+		{
+			const std::string s_port = s_endpoint.substr(sizeof(SERVICE_TCP_PREFIX) - 1);
+			char* c_end = nullptr;
+			const unsigned long ui_port = strtoul(s_port.c_str(), &c_end, 10);
+			sockaddr_in* p_inet = reinterpret_cast<sockaddr_in*>(&address);
+
+			if (s_port.empty() || *c_end != 0 || ui_port == 0 || ui_port > 65535)
+			{
+				throw std::invalid_argument("Bad port in " + s_endpoint + "!");
+			} // end if
+
+			// the daemon serves this host only
+			p_inet->sin_family = AF_INET;
+			p_inet->sin_port = htons(static_cast<std::uint16_t>(ui_port));
+			p_inet->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+			ui_length = sizeof(sockaddr_in);
+		} // end if
+		else
+		{
+			sockaddr_un* p_unix = reinterpret_cast<sockaddr_un*>(&address);
+
+			if (s_endpoint.empty() || s_endpoint.size() >= sizeof(p_unix->sun_path))
+			{
+				throw std::invalid_argument("Socket path " + s_endpoint + " is empty or too long!");
+			} // end if
+
+			p_unix->sun_family = AF_UNIX;
+			memcpy(p_unix->sun_path, s_endpoint.c_str(), s_endpoint.size() + 1);
+			ui_length = sizeof(sockaddr_un);
+		} // end else
+
+		const int i_socket = socket(address.ss_family, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+		if (i_socket < 0)
+		{
+			throw std::runtime_error(std::string("Cannot create socket: ") + strerror(errno));
+		} // end if
+
+		return i_socket;
+	} // end method openSocket
+
+
+	/// <summary>
+	///          Reads exactly <paramref name="ui_bytes"/> bytes, waiting as long as it takes.
+	/// </summary>
+	/// <returns>
+	///          false if the peer closed the stream or it failed first
+	/// </returns>
+	static bool readAll(const int i_socket, void* p_data, std::size_t ui_bytes)
+	{
+		unsigned char* c_a_data = static_cast<unsigned char*>(p_data);
+
+		while (ui_bytes > 0)
+		{
+			const ssize_t i_read = recv(i_socket, c_a_data, ui_bytes, 0);
+
+			if (i_read < 0 && errno == EINTR)
+			{
+				continue;
+			} // end if
+
+			if (i_read <= 0)
+			{
+				return false;
+			} // end if
+
+			c_a_data += i_read;
+			ui_bytes -= static_cast<std::size_t>(i_read);
+		} // end while
+
+		return true;
+	} // end method readAll
+
+#pragma endregion
+
+
+#pragma region Implementations:
+
+	/// <summary>
+	///          Binds and listens on <paramref name="s_endpoint"/>: "tcp:PORT" on the loopback interface, or a Unix socket
+	///          path, replacing a socket a crashed daemon may have left behind.
+	/// </summary>
+	/// <returns>
+	///          The listening socket
+	/// </returns>
+	/// <exception cref="std::invalid_argument">Thrown if the endpoint is malformed.</exception>
+	/// <exception cref="std::runtime_error">Thrown if the socket cannot be bound.</exception>
+	int listenEndpoint(const std::string& s_endpoint)
+	{
+		sockaddr_storage address;
+		socklen_t ui_length = 0;
+		const int i_socket = openSocket(s_endpoint, address, ui_length);
+		const int i_reuse = 1;
+
+		if (isTcp(s_endpoint))
+		{
+			setsockopt(i_socket, SOL_SOCKET, SO_REUSEADDR, &i_reuse, sizeof(i_reuse));
+		} // end if
+		else
+		{
+			unlink(s_endpoint.c_str());
+		} // end else
+
+		if (bind(i_socket, reinterpret_cast<const sockaddr*>(&address), ui_length) != 0 || listen(i_socket, SOMAXCONN) != 0)
+		{
+			const std::string s_error = strerror(errno);
+
+			close(i_socket);
+			throw std::runtime_error("Cannot listen on " + s_endpoint + ": " + s_error);
+		} // end if
+
+		return i_socket;
+	} // end method listenEndpoint
+
+
+	/// <summary>
+	///          Connects to the daemon listening on <paramref name="s_endpoint"/>.
+	/// </summary>
+	/// <exception cref="std::invalid_argument">Thrown if the endpoint is malformed.</exception>
+	/// <exception cref="std::runtime_error">Thrown if no daemon answers.</exception>
+	int connectEndpoint(const std::string& s_endpoint)
+	{
+		sockaddr_storage address;
+		socklen_t ui_length = 0;
+		const int i_socket = openSocket(s_endpoint, address, ui_length);
+
+		if (connect(i_socket, reinterpret_cast<const sockaddr*>(&address), ui_length) != 0)
+		{
+			const std::string s_error = strerror(errno);
+
+			close(i_socket);
+			throw std::runtime_error("Cannot connect to " + s_endpoint + ": " + s_error);
+		} // end if
+
+		return i_socket;
+	} // end method connectEndpoint
+
+
+	/// <summary>
+	///          Closes a socket of <see cref="listenEndpoint"/> and removes its path.
+	/// </summary>
+	void closeEndpoint(const std::string& s_endpoint, const int i_socket)
+	{
+		close(i_socket);
+
+		if (!isTcp(s_endpoint))
+		{
+			unlink(s_endpoint.c_str());
+		} // end if
+	} // end method closeEndpoint
+
+
+	/// <summary>
+	///          Writes one frame whose payload is the two given parts back to back, waiting until the stream took all of it.
+	/// </summary>
+	/// <returns>
+	///          false if the peer has gone away
+	/// </returns>
+	bool writeFrame(const int i_socket, const FrameKind e_kind, const std::uint32_t ui_job, const void* p_first, const std::size_t ui_firstBytes,
+					const void* p_second, const std::size_t ui_secondBytes)
+	{
+		FrameHeader header = { { 'T', 'S', 'P', 'D' }, SERVICE_VERSION, static_cast<std::uint16_t>(e_kind), ui_job,
+							   static_cast<std::uint32_t>(ui_firstBytes + ui_secondBytes) };
+		iovec iov[3] = { { &header, sizeof(header) }, { const_cast<void*>(p_first), ui_firstBytes }, { const_cast<void*>(p_second), ui_secondBytes } };
+		msghdr message;
+		int i_next = 0;
+
+		memset(&message, 0, sizeof(message));
+
+		while (i_next < 3)
+		{
+			message.msg_iov = iov + i_next;
+			message.msg_iovlen = static_cast<std::size_t>(3 - i_next);
+
+			ssize_t i_sent = sendmsg(i_socket, &message, MSG_NOSIGNAL);
+
+			if (i_sent < 0 && errno == EINTR)
+			{
+				continue;
+			} // end if
+
+			if (i_sent < 0)
+			{
+				return false;
+			} // end if
+
+			// skip what went out, a short write resumes in the middle of a part
+			while (i_next < 3 && static_cast<std::size_t>(i_sent) >= iov[i_next].iov_len)
+			{
+				i_sent -= static_cast<ssize_t>(iov[i_next].iov_len);
+				i_next++;
+			} // end while
+
+			if (i_next < 3)
+			{
+				iov[i_next].iov_base = static_cast<unsigned char*>(iov[i_next].iov_base) + i_sent;
+				iov[i_next].iov_len -= static_cast<std::size_t>(i_sent);
+			} // end if
+		} // end while
+
+		return true;
+	} // end method writeFrame
+
+
+	/// <summary>
+	///          Reads the next frame, waiting for it.
+	/// </summary>
+	/// <param name="payload">
+	///          Output parameter for the header.ui_bytes bytes behind the header.
+	/// </param>
+	/// <returns>
+	///          false if the stream ended or carried something other than a frame
+	/// </returns>
+	bool readFrame(const int i_socket, FrameHeader& header, std::vector<unsigned char>& payload)
+	{
+		if (!readAll(i_socket, &header, sizeof(header)) || !validFrame(header))
+		{
+			return false;
+		} // end if
+
+		payload.resize(header.ui_bytes);
+
+		return readAll(i_socket, payload.data(), payload.size());
+	} // end method readFrame
+
+
+	/// <summary>
+	///          Whether <paramref name="header"/> starts a frame of this protocol version within the payload limit.
+	/// </summary>
+	bool validFrame(const FrameHeader& header) noexcept
+	{
+		static_assert(sizeof(FrameHeader) == 16 && sizeof(JobRequest) == 40 && sizeof(Receipt) == 8 && sizeof(TourReport) == 32
+					  && sizeof(ServiceMetrics) == 96, "service structs must not be padded");
+
+		return memcmp(header.c_a_magic, "TSPD", 4) == 0 && header.ui_version == SERVICE_VERSION && header.ui_bytes <= SERVICE_MAX_PAYLOAD;
+	} // end method validFrame
+
+#pragma endregion
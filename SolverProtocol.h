@@ -0,0 +1,114 @@
+#ifndef _SOLVER_PROTOCOL_H_
+#define _SOLVER_PROTOCOL_H_
+
+#pragma region Includes:
+
+	#include <cstddef>      // std::size_t
+	#include <cstdint>      // fixed width integers
+	#include <string>       // std::string
+	#include <vector>       // std::vector
+
+#pragma endregion
+
+
+#pragma region Defines:
+
+	#define SERVICE_VERSION        1               // version of FrameHeader and the payloads behind it
+	#define SERVICE_TCP_PREFIX     "tcp:"          // endpoint prefix of a loopback TCP port, a Unix socket path otherwise
+	#define SERVICE_MAX_PAYLOAD    (64u << 20)     // bytes a frame may carry at most
+	#define SERVICE_MAX_GENES      (1u << 26)      // population * cities a job may ask for at most
+	#define SERVICE_MAX_MATRIX     (256u << 20)    // bytes of the distance matrix a job may need at most
+
+#pragma endregion
+
+
+// What a frame between a client and the solver daemon carries.
+enum class FrameKind : std::uint16_t
+{
+	submit   = 1, // client: JobRequest and ui_cities (x, y) int32 pairs; ui_job is the client's tag for the job
+	accepted = 2, // daemon: Receipt of a queued job, ui_job is the id its tours will come under
+	improved = 3, // daemon: TourReport and genes of a new shortest tour of job ui_job
+	finished = 4, // daemon: TourReport and genes of job ui_job's final tour, its last frame
+	rejected = 5, // daemon: Receipt and reason text of a refused job (ui_job 0) or one that expired in the queue
+	stats    = 6, // client: asks for the metrics, no payload; daemon: ServiceMetrics
+	shutdown = 7  // client: stop taking jobs, finish the running ones and exit, no payload
+}; // end enum FrameKind
+
+
+// Header of every frame on a stream socket. Client and daemon share one host, so all fields are in its byte order;
+// 16 bytes without padding.
+struct FrameHeader
+{
+	char          c_a_magic[4];  // "TSPD"
+	std::uint16_t ui_version;    // SERVICE_VERSION
+	std::uint16_t ui_kind;       // FrameKind
+	std::uint32_t ui_job;        // job the frame is about, 0 where none applies
+	std::uint32_t ui_bytes;      // payload bytes following the header
+}; // end struct FrameHeader
+
+
+// Instance and budget of a submitted job, 40 bytes.
+struct JobRequest
+{
+	std::uint32_t ui_cities;      // (x, y) pairs following the request
+	std::uint32_t ui_population;  // tours, 0 for the daemon's --size
+	std::int32_t  i_generations;  // generations at most, 0 for the daemon's --generations
+	std::int32_t  i_priority;     // jobs of a higher priority start first
+	std::int64_t  i_deadline;     // ms after submission the final tour is due, 0 for none
+	std::uint64_t ui_seed;        // master seed, 0 to derive one from the daemon's seed and the job id
+	float         f_target;       // tour length to stop at, 0 for none
+	std::uint32_t ui_reserved;    // 0
+}; // end struct JobRequest
+
+
+// Answer to a submission, 8 bytes.
+struct Receipt
+{
+	std::uint32_t ui_tag;         // the client's tag from the submit frame
+	std::uint32_t ui_queued;      // jobs waiting once this one was queued
+}; // end struct Receipt
+
+
+// A tour of a running or finished job, followed by ui_cities genes; 32 bytes.
+struct TourReport
+{
+	std::int32_t  i_generation;   // generation that found the tour
+	float         f_length;       // its length
+	std::uint32_t ui_cities;      // genes following the report
+	std::uint32_t ui_stopReason;  // StopReason of a finished job, 0 otherwise
+	std::int64_t  i_waited;       // us the job spent in the queue
+	std::int64_t  i_elapsed;      // us the job has been running
+}; // end struct TourReport
+
+
+// Scheduler metrics of the daemon, 96 bytes.
+struct ServiceMetrics
+{
+	std::int64_t i_queued;        // jobs waiting
+	std::int64_t i_running;       // jobs on a worker
+	std::int64_t i_submitted;     // jobs accepted so far
+	std::int64_t i_completed;     // jobs that sent their final tour
+	std::int64_t i_rejected;      // submissions refused, malformed or while shutting down
+	std::int64_t i_expired;       // jobs whose deadline passed before a worker was free
+	std::int64_t i_uptime;        // us since the daemon started
+	double       d_meanWait;      // us from submission to start, mean over completed jobs
+	double       d_meanLatency;   // us from submission to the final tour, mean over completed jobs
+	double       d_p50Latency;    // median of the same over the latest SERVICE_LATENCY_WINDOW jobs
+	double       d_p99Latency;    // 99th percentile of the same
+	double       d_throughput;    // completed jobs per second of uptime
+}; // end struct ServiceMetrics
+
+
+#pragma region Prototypes:
+
+	int listenEndpoint(const std::string& s_endpoint);
+	int connectEndpoint(const std::string& s_endpoint);
+	void closeEndpoint(const std::string& s_endpoint, const int i_socket);
+	bool writeFrame(const int i_socket, const FrameKind e_kind, const std::uint32_t ui_job, const void* p_first, const std::size_t ui_firstBytes,
+					const void* p_second = nullptr, const std::size_t ui_secondBytes = 0);
+	bool readFrame(const int i_socket, FrameHeader& header, std::vector<unsigned char>& payload);
+	bool validFrame(const FrameHeader& header) noexcept;
+
+#pragma endregion
+
+#endif
@@ -0,0 +1,119 @@
+#pragma region Includes:
+
+	#include "Stopping.h"   // StopCriteria, StopReason
+	#include <chrono>       // std::chrono::milliseconds
+
+#pragma endregion
+
+
+#pragma region Implementations:
+
+	/// <summary>
+	///          Starts the clock of a run's deadline.
+	/// </summary>
+	/// <param name="options">
+	///          Deadline, target distance, stagnation limit and evaluation budget; 0 leaves a criterion out.
+	/// </param>
+	/// <param name="i_generations">
+	///          Generations a loop runs at most.
+	/// </param>
+	StopCriteria::StopCriteria(const RunOptions& options, const int i_generations)
+		: i_generations(i_generations), i_deadline(options.i_deadline), d_target(options.d_targetDistance), i_stagnation(options.i_stagnation),
+		  i_budget(options.i_evaluationBudget), start(highRes_Clock::now()), f_shortest(-1.0f), i_improved(0), i_evaluations(0), b_stopped(false),
+		  i_reason(static_cast<int>(StopReason::generations))
+	{
+	} // end constructor
+
+
+	/// <summary>
+	///          Checks every criterion after <paramref name="i_generation"/> has been ranked.
+	/// </summary>
+	/// <param name="f_best">
+	///          Length of the tour the calling loop ranked first.
+	/// </param>
+	/// <returns>
+	///          true if the calling loop should end, because of a criterion it or another loop met, or because it has run
+	///          all its generations
+	/// </returns>
+	bool StopCriteria::reached(const int i_generation, const float f_best) noexcept
+	{
+		float f_known = f_shortest.load(std::memory_order_relaxed);
+
+		// a shorter tour restarts the stagnation count of every loop
+		while ((f_known < 0 || f_best < f_known) && !f_shortest.compare_exchange_weak(f_known, f_best, std::memory_order_relaxed));
+
+		if (f_known < 0 || f_best < f_known)
+		{
+			int i_latest = i_improved.load(std::memory_order_relaxed);
+
+			while (i_latest < i_generation && !i_improved.compare_exchange_weak(i_latest, i_generation, std::memory_order_relaxed));
+		} // end if
+
+		if (b_stopped.load(std::memory_order_relaxed))
+		{
+			return true;
+		} // end if
+
+		if (d_target > 0 && f_best <= d_target)
+		{
+			stop(StopReason::target);
+		} // end if
+		else if (i_stagnation > 0 && i_generation - i_improved.load(std::memory_order_relaxed) >= i_stagnation)
+		{
+			stop(StopReason::stagnation);
+		} // end elif
+		else if (i_budget > 0 && i_evaluations.load(std::memory_order_relaxed) >= i_budget)
+		{
+			stop(StopReason::evaluations);
+		} // end elif
+		else if (i_deadline > 0 && highRes_Clock::now() - start >= std::chrono::milliseconds(i_deadline))
+		{
+			stop(StopReason::deadline);
+		} // end elif
+
+		return b_stopped.load(std::memory_order_relaxed) || i_generation + 1 >= i_generations;
+	} // end method reached
+
+
+	/// <summary>
+	///          Continues the evaluation count and stagnation tracking of a checkpointed run. The deadline keeps
+	///          counting from construction, a resumed run gets the full time again.
+	/// </summary>
+	void StopCriteria::restore(const long long i_evaluations, const float f_shortest, const int i_improved) noexcept
+	{
+		this->i_evaluations.store(i_evaluations, std::memory_order_relaxed);
+		this->f_shortest.store(f_shortest, std::memory_order_relaxed);
+		this->i_improved.store(i_improved, std::memory_order_relaxed);
+	} // end method restore
+
+
+	/// <summary>
+	///          Records <paramref name="e_reason"/> unless another criterion was met first.
+	/// </summary>
+	void StopCriteria::stop(const StopReason e_reason) noexcept
+	{
+		if (!b_stopped.exchange(true))
+		{
+			i_reason.store(static_cast<int>(e_reason), std::memory_order_relaxed);
+		} // end if
+	} // end method stop
+
+
+	/// <summary>
+	///          Name of <paramref name="e_reason"/> as printed in the run report.
+	/// </summary>
+	const char* stopReasonName(const StopReason e_reason) noexcept
+	{
+		switch (e_reason)
+		{
+			case StopReason::generations: return "generations";
+			case StopReason::deadline:    return "deadline";
+			case StopReason::target:      return "target";
+			case StopReason::stagnation:  return "stagnation";
+			case StopReason::evaluations: return "evaluations";
+		} // end switch
+
+		return "unknown";
+	} // end method stopReasonName
+
+#pragma endregion
@@ -0,0 +1,70 @@
+#ifndef _STOPPING_H_
+#define _STOPPING_H_
+
+#pragma region Includes:
+
+	#include <atomic>        // std::atomic
+	#include "RunOptions.h"  // RunOptions
+	#include "utility.hpp"   // timePoint, highRes_Clock
+
+#pragma endregion
+
+
+// Why a generation loop ended.
+enum class StopReason
+{
+	generations, // ran all generations it was given
+	deadline,    // wall-clock deadline passed
+	target,      // found a tour at most the target distance long
+	stagnation,  // no shorter tour for the given number of generations
+	evaluations  // used up its budget of tour evaluations
+}; // end enum StopReason
+
+
+// Stopping criteria of a run, checked once a generation has been ranked.
+//
+// A check costs a clock read and a few relaxed atomics, so latency-bound runs can afford it every generation. All
+// state is atomic: the islands of a run share one instance, add their evaluations to the common budget, measure
+// stagnation against the shortest tour of any island, and all stop once one of them finds a criterion met.
+class StopCriteria
+{
+public:
+	StopCriteria(const RunOptions& options, const int i_generations);
+
+	StopCriteria(const StopCriteria&) = delete;
+	StopCriteria& operator=(const StopCriteria&) = delete;
+
+	inline void evaluated(const std::size_t ui_tours) noexcept { i_evaluations.fetch_add(static_cast<long long>(ui_tours), std::memory_order_relaxed); }
+
+	bool reached(const int i_generation, const float f_best) noexcept;
+	void restore(const long long i_evaluations, const float f_shortest, const int i_improved) noexcept;
+
+	inline StopReason reason(void) const noexcept         { return static_cast<StopReason>(i_reason.load(std::memory_order_relaxed)); }
+	inline long long  evaluations(void) const noexcept    { return i_evaluations.load(std::memory_order_relaxed); }
+	inline bool       stopped(void) const noexcept        { return b_stopped.load(std::memory_order_relaxed); }
+	inline int        improvedAt(void) const noexcept     { return i_improved.load(std::memory_order_relaxed); }
+
+private:
+	void stop(const StopReason e_reason) noexcept;
+
+	int                    i_generations;   // generations a loop runs at most
+	long long              i_deadline;      // ms after construction to stop at, 0 for none
+	double                 d_target;        // distance to stop at, 0 for none
+	int                    i_stagnation;    // generations without improvement to stop after, 0 for none
+	long long              i_budget;        // tour evaluations to stop after, 0 for none
+	timePoint              start;           // when the run started
+	std::atomic<float>     f_shortest;      // shortest tour any loop has ranked first, negative before the first
+	std::atomic<int>       i_improved;      // latest generation that found it
+	std::atomic<long long> i_evaluations;   // tours evaluated so far
+	std::atomic<bool>      b_stopped;       // whether a criterion was met
+	std::atomic<int>       i_reason;        // StopReason of the first criterion met
+}; // end class StopCriteria
+
+
+#pragma region Prototypes:
+
+	const char* stopReasonName(const StopReason e_reason) noexcept;
+
+#pragma endregion
+
+#endif
@@ -0,0 +1,222 @@
+#pragma region Includes:
+
+	#include "TaskGraph.h" // TaskGraph
+	#include <omp.h>       // omp_get_max_threads, omp_get_thread_num
+	#include <thread>      // std::this_thread::yield
+	#include <utility>     // std::move
+
+#pragma endregion
+
+
+#pragma region Implementations:
+
+	TaskGraph::TaskGraph(void) noexcept
+		: ui_workers(0), ui_prepared(0), ui_remaining(0), b_failed(false)
+	{
+	} // end constructor
+
+
+	/// <summary>
+	///          Adds a task without predecessors.
+	/// </summary>
+	/// <returns>
+	///          the task's id for <see cref="precede"/>
+	/// </returns>
+	std::size_t TaskGraph::add(std::function<void(void)> work)
+	{
+		tasks.push_back(Task{ std::move(work), std::vector<std::size_t>(), 0 });
+
+		return tasks.size() - 1;
+	} // end method add
+
+
+	/// <summary>
+	///          Makes task <paramref name="ui_then"/> wait until task <paramref name="ui_first"/> is done.
+	/// </summary>
+	void TaskGraph::precede(const std::size_t ui_first, const std::size_t ui_then)
+	{
+		tasks[ui_first].successors.push_back(ui_then);
+		tasks[ui_then].ui_dependencies++;
+	} // end method precede
+
+
+	/// <summary>
+	///          Runs every task once, each after all of its predecessors, on a team of omp_get_max_threads() workers, and
+	///          returns when all are done. The tasks without predecessors are dealt to the workers in turn.
+	/// </summary>
+	/// <exception>Rethrows the first exception a task threw.</exception>
+	void TaskGraph::run(void)
+	{
+		prepare(static_cast<std::size_t>(omp_get_max_threads()));
+
+		std::size_t ui_next = 0;
+
+		for (std::size_t i = 0; i < tasks.size(); i++)
+		{
+			ui_a_pending[i].store(tasks[i].ui_dependencies, std::memory_order_relaxed);
+
+			if (tasks[i].ui_dependencies == 0)
+			{
+				push(ui_next++ % ui_workers, i);
+			} // end if
+		} // end for i
+
+		ui_remaining.store(tasks.size(), std::memory_order_relaxed);
+		b_failed.store(false, std::memory_order_relaxed);
+		failure = nullptr;
+
+		#pragma omp parallel num_threads(static_cast<int>(ui_workers))
+		{
+			// a smaller team than asked for leaves the deques of the missing workers to the thieves
+			const std::size_t ui_self = static_cast<std::size_t>(omp_get_thread_num());
+			std::size_t ui_task = 0;
+
+			while (ui_remaining.load(std::memory_order_acquire) > 0)
+			{
+				if (pop(ui_self, ui_task) || steal(ui_self, ui_task))
+				{
+					execute(ui_self, ui_task);
+				} // end if
+				else
+				{
+					std::this_thread::yield();
+				} // end else
+			} // end while
+		} // end parallel
+
+		if (failure)
+		{
+			std::rethrow_exception(failure);
+		} // end if
+	} // end method run
+
+
+	/// <summary>
+	///          Sizes the deques and pending counts for the graph and <paramref name="ui_workers"/> workers, and empties the deques.
+	/// </summary>
+	void TaskGraph::prepare(const std::size_t ui_workers)
+	{
+		if (ui_prepared != tasks.size())
+		{
+			ui_a_pending.reset(new std::atomic<std::size_t>[tasks.size()]);
+		} // end if
+
+		if (this->ui_workers != ui_workers || ui_prepared != tasks.size())
+		{
+			workers.reset(new Worker[ui_workers]);
+			this->ui_workers = ui_workers;
+
+			for (std::size_t w = 0; w < ui_workers; w++)
+			{
+				workers[w].ui_v_ready.resize(tasks.size());
+			} // end for w
+		} // end if
+
+		ui_prepared = tasks.size();
+
+		for (std::size_t w = 0; w < ui_workers; w++)
+		{
+			workers[w].ui_front = 0;
+			workers[w].ui_back = 0;
+		} // end for w
+	} // end method prepare
+
+
+	/// <summary>
+	///          Queues a ready task at the back of the deque of <paramref name="ui_worker"/>.
+	/// </summary>
+	void TaskGraph::push(const std::size_t ui_worker, const std::size_t ui_task)
+	{
+		Worker& worker = workers[ui_worker];
+		std::lock_guard<std::mutex> guard(worker.lock);
+
+		worker.ui_v_ready[worker.ui_back++] = ui_task;
+	} // end method push
+
+
+	/// <summary>
+	///          Takes the newest task off the deque of <paramref name="ui_worker"/>.
+	/// </summary>
+	/// <returns>
+	///          false if it is empty
+	/// </returns>
+	bool TaskGraph::pop(const std::size_t ui_worker, std::size_t& ui_task)
+	{
+		Worker& worker = workers[ui_worker];
+		std::lock_guard<std::mutex> guard(worker.lock);
+
+		if (worker.ui_front == worker.ui_back)
+		{
+			return false;
+		} // end if
+
+		ui_task = worker.ui_v_ready[--worker.ui_back];
+
+		return true;
+	} // end method pop
+
+
+	/// <summary>
+	///          Takes the oldest task off the deque of the first other worker that has one, starting after <paramref name="ui_worker"/>.
+	/// </summary>
+	/// <returns>
+	///          false if every deque is empty
+	/// </returns>
+	bool TaskGraph::steal(const std::size_t ui_worker, std::size_t& ui_task)
+	{
+		for (std::size_t i = 1; i < ui_workers; i++)
+		{
+			Worker& victim = workers[(ui_worker + i) % ui_workers];
+			std::lock_guard<std::mutex> guard(victim.lock);
+
+			if (victim.ui_front != victim.ui_back)
+			{
+				ui_task = victim.ui_v_ready[victim.ui_front++];
+				return true;
+			} // end if
+		} // end for i
+
+		return false;
+	} // end method steal
+
+
+	/// <summary>
+	///          Runs a task unless an earlier one failed, then queues the successors it was the last predecessor of on the
+	///          deque of <paramref name="ui_worker"/>.
+	/// </summary>
+	void TaskGraph::execute(const std::size_t ui_worker, const std::size_t ui_task)
+	{
+		const Task& task = tasks[ui_task];
+
+		if (!b_failed.load(std::memory_order_relaxed))
+		{
+			try
+			{
+				task.work();
+			} // end try
+			catch (...)
+			{
+				std::lock_guard<std::mutex> guard(failure_lock);
+
+				if (!failure)
+				{
+					failure = std::current_exception();
+				} // end if
+
+				b_failed.store(true, std::memory_order_relaxed);
+			} // end catch
+		} // end if
+
+		for (const std::size_t ui_then : task.successors)
+		{
+			if (ui_a_pending[ui_then].fetch_sub(1, std::memory_order_acq_rel) == 1)
+			{
+				push(ui_worker, ui_then);
+			} // end if
+		} // end for
+
+		// successors are queued before the count drops, so no worker leaves while there is work left
+		ui_remaining.fetch_sub(1, std::memory_order_release);
+	} // end method execute
+
+#pragma endregion
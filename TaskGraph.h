@@ -0,0 +1,77 @@
+#ifndef _TASK_GRAPH_H_
+#define _TASK_GRAPH_H_
+
+#pragma region Includes:
+
+	#include <atomic>       // std::atomic
+	#include <cstddef>      // std::size_t
+	#include <exception>    // std::exception_ptr
+	#include <functional>   // std::function
+	#include <memory>       // std::unique_ptr
+	#include <mutex>        // std::mutex
+	#include <vector>       // std::vector
+	#include "utility.hpp"  // CACHE_LINE_SIZE
+
+#pragma endregion
+
+
+// Dependency graph of tasks, run to completion by a work-stealing OpenMP team.
+//
+// The graph is built once and run any number of times. Every worker owns a deque: it takes its own work from the
+// back, newest first, and an idle worker steals from the front of another's, oldest first. A finished task makes its
+// successors ready once all their predecessors are done, and the worker that finished the last predecessor queues
+// them on its own deque, so a chain of tasks tends to stay on one thread while its data is in that thread's cache.
+// The only barrier is the end of run(). Tasks must not throw past run(): the first exception is kept, the tasks not
+// yet started are skipped, and it is rethrown once the team has left.
+class TaskGraph
+{
+public:
+	TaskGraph(void) noexcept;
+
+	TaskGraph(const TaskGraph&) = delete;
+	TaskGraph& operator=(const TaskGraph&) = delete;
+
+	std::size_t add(std::function<void(void)> work);
+	void precede(const std::size_t ui_first, const std::size_t ui_then);
+	void run(void);
+
+	inline std::size_t size(void) const noexcept { return tasks.size(); }
+
+private:
+	// A task and the tasks waiting on it.
+	struct Task
+	{
+		std::function<void(void)> work;            // what the task does
+		std::vector<std::size_t>  successors;      // tasks it precedes
+		std::size_t               ui_dependencies; // tasks preceding it
+	}; // end struct Task
+
+	// Deque of ready tasks owned by one worker. A task is queued once per run, so size() slots never wrap. The padding
+	// keeps the next worker's fields off the cache line this one ends on, however new[] aligns the array.
+	struct Worker
+	{
+		std::mutex               lock;       // guards everything below but the padding
+		std::vector<std::size_t> ui_v_ready; // ready tasks, [ui_front, ui_back)
+		std::size_t              ui_front;   // oldest ready task, where thieves take
+		std::size_t              ui_back;    // end of the newest ready task, where the owner takes
+		char                     c_a_pad[CACHE_LINE_SIZE];
+	}; // end struct Worker
+
+	void prepare(const std::size_t ui_workers);
+	void push(const std::size_t ui_worker, const std::size_t ui_task);
+	bool pop(const std::size_t ui_worker, std::size_t& ui_task);
+	bool steal(const std::size_t ui_worker, std::size_t& ui_task);
+	void execute(const std::size_t ui_worker, const std::size_t ui_task);
+
+	std::vector<Task>                         tasks;       // the graph
+	std::unique_ptr<std::atomic<std::size_t>[]> ui_a_pending; // predecessors of every task not done yet this run
+	std::unique_ptr<Worker[]>                 workers;     // one deque per worker
+	std::size_t                               ui_workers;  // entries of workers
+	std::size_t                               ui_prepared; // tasks ui_a_pending and the deques are sized for
+	std::atomic<std::size_t>                  ui_remaining; // tasks not done yet this run
+	std::atomic<bool>                         b_failed;    // whether a task threw this run
+	std::mutex                                failure_lock; // guards failure
+	std::exception_ptr                        failure;     // first exception a task threw this run
+}; // end class TaskGraph
+
+#endif
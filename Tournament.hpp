@@ -0,0 +1,166 @@
+#ifndef _TOURNAMENT_HPP_
+#define _TOURNAMENT_HPP_
+
+#pragma region Includes:
+
+	#include <cstddef>       // std::size_t
+	#include <cstdint>       // std::uint32_t
+	#include <vector>        // std::vector
+	#include <algorithm>     // std::swap
+	#include <cassert>       // assert
+	#include <stdexcept>     // std::invalid_argument
+	#include <string>        // std::to_string
+	#include "utility.hpp"   // TOURNAMENT_SIZE
+	#include "Random.hpp"    // localEngine, randomBelow
+	#include "Profiler.h"    // PROFILE_THREAD, PROFILE_COUNT
+
+#pragma endregion
+
+
+#pragma region Prototypes:
+
+	template<typename Fitness>
+	void selectTournament(const std::size_t ui_size, const std::size_t ui_parents, const Fitness& fitnessOf, std::uint32_t winners[]);
+
+	template<typename Fitness>
+	void selectBlock(const std::size_t ui_size, const std::size_t ui_offset, const std::size_t ui_begin, const std::size_t ui_end, const Fitness& fitnessOf,
+					 std::uint32_t winners[], const std::size_t ui_winners, std::uint32_t available[], Xoshiro256& engine);
+
+#pragma endregion
+
+
+#pragma region Defines:
+
+	#ifndef SELECT_BLOCKS
+		#define SELECT_BLOCKS      64     // independent tournament blocks per generation
+	#endif
+
+#pragma endregion
+
+
+#pragma region Templates:
+
+	/// <summary>
+	///          Picks <paramref name="ui_parents"/> distinct winners out of <paramref name="ui_size"/> tours by tournament selection
+	///          without replacement, in parallel and without locks.
+	/// </summary>
+	/// <typeparam name="Fitness">
+	///                     Callable returning the fitness of a tour index.
+	/// </typeparam>
+	/// <param name="ui_size">
+	///                    Number of tours to select from.
+	/// </param>
+	/// <param name="ui_parents">
+	///                    Number of winners to select, at most <paramref name="ui_size"/>.
+	/// </param>
+	/// <param name="fitnessOf">
+	///                    Fitness lookup by tour index.
+	/// </param>
+	/// <param name="winners">
+	///                    Output, the indices of the <paramref name="ui_parents"/> winners.
+	/// </param>
+	/// <exception cref="std::invalid_argument">
+	///          Thrown if <paramref name="ui_parents"/> is greater than <paramref name="ui_size"/>.
+	/// </exception>
+	/// <remarks>
+	///          The tours are split into <see cref="SELECT_BLOCKS"/> blocks, rotated by a random offset every call so the blocks
+	///          change between generations. Each block owns a proportional share of the winners and a compact array of its
+	///          still available tours: every tournament draws TOURNAMENT_SIZE candidates from that array, and the winner is
+	///          removed by swapping it with the last available entry. A pick therefore costs O(TOURNAMENT_SIZE) no matter how
+	///          many tours are already taken, and blocks never touch each other's data.
+	/// </remarks>
+	template<typename Fitness>
+	void selectTournament(const std::size_t ui_size, const std::size_t ui_parents, const Fitness& fitnessOf, std::uint32_t winners[])
+	{
+		thread_local std::vector<std::uint32_t> ui_v_available;
+
+		// checked here because an exception must not leave the parallel region
+		if (ui_parents > ui_size)
+		{
+			throw std::invalid_argument("Cannot select " + std::to_string(ui_parents) + " distinct winners out of " + std::to_string(ui_size) + " tours!");
+		} // end if
+
+		const std::size_t ui_offset = static_cast<std::size_t>(randomBelow(localEngine(), ui_size));
+		const long long i_blocks = static_cast<long long>(ui_size < SELECT_BLOCKS ? 1 : SELECT_BLOCKS);
+
+		if (ui_v_available.capacity() < ui_size)
+		{
+			PROFILE_COUNT(Counter::allocations, 1);
+		} // end if
+
+		ui_v_available.resize(ui_size);
+		std::uint32_t* ui_a_available = ui_v_available.data();
+
+		PROFILE_COUNT(Counter::rngDraws, 1 + ui_parents * TOURNAMENT_SIZE);
+
+		#pragma omp parallel
+		{
+			PROFILE_THREAD(Stage::select);
+
+			#pragma omp for schedule(static) nowait
+			for (long long b = 0; b < i_blocks; b++)
+			{
+				// tours [ui_begin, ui_end) of the rotated order and winners [ui_out, ui_outEnd) belong to this block; the
+				// winners follow the tour split, so with ui_parents <= ui_size no block has more winners than tours
+				const std::size_t ui_begin = ui_size * b / i_blocks;
+				const std::size_t ui_end = ui_size * (b + 1) / i_blocks;
+				const std::size_t ui_out = ui_parents * ui_begin / ui_size;
+
+				selectBlock(ui_size, ui_offset, ui_begin, ui_end, fitnessOf, winners + ui_out, ui_parents * ui_end / ui_size - ui_out,
+							ui_a_available + ui_begin, localEngine());
+			} // end for b
+		} // end parallel
+	} // end template selectTournament
+
+
+	/// <summary>
+	///          One block of <see cref="selectTournament"/>: picks <paramref name="ui_winners"/> distinct winners out of the
+	///          tours [<paramref name="ui_begin"/>, <paramref name="ui_end"/>) of the order rotated by <paramref name="ui_offset"/>.
+	/// </summary>
+	/// <param name="winners">
+	///                    Output, the block's winners.
+	/// </param>
+	/// <param name="available">
+	///                    Scratch space of ui_end - ui_begin entries, at least <paramref name="ui_winners"/>.
+	/// </param>
+	/// <param name="engine">
+	///                    Engine of every draw.
+	/// </param>
+	template<typename Fitness>
+	void selectBlock(const std::size_t ui_size, const std::size_t ui_offset, const std::size_t ui_begin, const std::size_t ui_end, const Fitness& fitnessOf,
+					 std::uint32_t winners[], const std::size_t ui_winners, std::uint32_t available[], Xoshiro256& engine)
+	{
+		std::size_t ui_left = ui_end - ui_begin;
+
+		// runs inside parallel regions and task graph workers, the callers split the winners so this holds
+		assert(ui_winners <= ui_left);
+
+		for (std::size_t i = 0; i < ui_left; i++)
+		{
+			available[i] = static_cast<std::uint32_t>((ui_begin + i + ui_offset) % ui_size);
+		} // end for i
+
+		for (std::size_t ui_out = 0; ui_out < ui_winners; ui_out++)
+		{
+			std::size_t ui_winner = static_cast<std::size_t>(randomBelow(engine, ui_left));
+
+			for (auto j = 1; j < TOURNAMENT_SIZE; j++)
+			{
+				const std::size_t ui_candidate = static_cast<std::size_t>(randomBelow(engine, ui_left));
+
+				if (fitnessOf(available[ui_candidate]) < fitnessOf(available[ui_winner]))
+				{
+					ui_winner = ui_candidate;
+				} // end if
+			} // end for j
+
+			winners[ui_out] = available[ui_winner];
+
+			// the winner is taken, the last available tour moves into its place
+			std::swap(available[ui_winner], available[--ui_left]);
+		} // end for ui_out
+	} // end template selectBlock
+
+#pragma endregion
+
+#endif
@@ -9,6 +9,7 @@
 #define N_THREADS          4      // number of threads
 
 #include <iterator>			      // std::begin/end
+#include <cstddef>			      // std::size_t
 
 // Each trip (or chromosome) information
 class Trip
@@ -62,4 +63,34 @@ inline bool operator<=(const Trip& LHS, const Trip& RHS) { return !(LHS > RHS);
 inline bool operator>=(const Trip& LHS, const Trip& RHS) { return !(LHS < RHS); }
 inline bool operator!=(const Trip& LHS, const Trip& RHS) { return !(LHS == RHS); }
 
+
+/// <summary>
+///          Translates an alpha-numeric city name (ABC...012...) to its corresponding index in the coordinates matrix.
+/// </summary>
+/// <param name="c_city">
+///                    The alpha-numeric city name to translate.
+/// </param>
+/// <returns>
+///          The index corresponding to <paramref name="c_city"/> in the coordinates matrix.
+/// </returns>
+inline std::size_t translateToIndex(const char c_city) noexcept
+{
+	return (c_city >= 'A' ? static_cast<std::size_t>(c_city) - static_cast<std::size_t>('A') : static_cast<std::size_t>(c_city) - 22);
+} // end method translateToIndex
+
+
+/// <summary>
+///         Translates an index in range [0,35] to its corresponding alpha-numeric city name (ABC...012...).
+/// </summary>
+/// <param name="ui_index">
+///			The index to translate.
+/// </param>
+/// <returns>
+///			The alpha-numeric city name corresponding to <paramref name="ui_index"/>.
+/// </returns>
+inline char translateToCity(const std::size_t ui_index) noexcept
+{
+	return (ui_index <= 25 ? static_cast<char>(ui_index) + 'A' : static_cast<char>(ui_index - 26) + '0');
+} // end method translateToCity
+
 #endif
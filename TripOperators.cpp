@@ -0,0 +1,281 @@
+// GA operators over the original array of Trip records.
+//
+// The solver works on the structure-of-arrays Population and does not link this file. It keeps the Trip[]
+// evaluate, crossover and mutate that the legacy Tsp.cpp entry point calls, memoized Point* overloads
+// included, and is the array-of-structures baseline that bench_layout and bench_crossover measure the
+// Population operators against. Crossover shares its kernel with the Population operators (Crossover.hpp),
+// so the benches compare layouts and not algorithms. The Trip[] select and populate are in
+// TripSelectPopulate.cpp, because Tsp.cpp brings its own.
+
+#pragma region Includes:
+
+	#include <algorithm>        // std::sort, std::shuffle, std::swap, std::min
+	#include <omp.h>            // omp directives
+	#include "Trip.h"           // Trip, translateToIndex, translateToCity
+	#include "utility.hpp"      // randomIntInRange
+	#include "Random.hpp"       // localEngine
+	#include "DistanceMatrix.h" // DistanceMatrix
+	#include "MemoDistance.h"   // MemoDistance
+	#include "FitnessKernel.h"  // evaluateBatch, KernelIsa
+	#include "Crossover.hpp"    // crossoverChild, WordCrossoverState
+
+#pragma endregion
+
+
+#pragma region Prototypes:
+
+	void evaluate(Trip trip[CHROMOSOMES], const Point* coordinates);
+	void evaluate(Trip trip[CHROMOSOMES], const DistanceMatrix& distances);
+	void evaluate(Trip trip[CHROMOSOMES], const DistanceMatrix& distances, const KernelIsa e_isa);
+	void crossover(Trip parents[TOP_X], Trip offsprings[TOP_X], const Point* coordinates);
+	void crossover(Trip parents[TOP_X], Trip offsprings[TOP_X], const DistanceMatrix& distances);
+	void mutate(Trip offsprings[TOP_X], const int RATE);
+
+	template<typename Distance>
+	void evaluateWith(Trip trip[CHROMOSOMES], const Distance& distances);
+
+	template<typename Distance>
+	void crossoverWith(Trip parents[TOP_X], Trip offsprings[TOP_X], const Distance& distances);
+
+#pragma endregion
+
+
+#pragma region Helpers:
+
+	/// <summary>
+	///          Generates the complement of <paramref name="trip1"/> and writes it into <paramref name="trip2"/>.
+	/// </summary>
+	/// <param name="trip1">
+	///          Existing child to use as template for making <paramref name="trip2"/>.
+	/// </param>
+	/// <param name="trip2">
+	///         Child to be created as complement of <paramref name="trip1"/>.
+	/// </param>
+	static void generateComplement(const char* trip1, char* trip2)
+	{
+		for (auto i = 0; i < CITIES; i++)
+		{
+			std::size_t temp = translateToIndex(trip1[i]);
+			trip2[i] = translateToCity(CITIES - 1 - temp);
+		} // end for i
+	} // end method generateComplement
+
+#pragma endregion
+
+
+#pragma region Implementations:
+
+	/// <summary>
+	///          Evaluates the length of the given <paramref name="trip"/> using the provided <paramref name="coordinates"/> for the cities.
+	///          No value is returned, the value of <paramref name="trip"/>.fitness is set to the length of the trip.
+	/// </summary>
+	/// <param name="trip">
+	///                    The trip to evaluate.
+	/// </param>
+	/// <param name="coordinates">
+	///                           The coordinates of the cities to be used for determining distance between cities.
+	/// </param>
+	/// <exception cref=""></exception>
+	void evaluate(Trip trip[CHROMOSOMES], const Point* coordinates)
+	{
+		evaluateWith(trip, MemoDistance{coordinates, CITIES});
+	} // end method evaluate
+
+
+	/// <summary>
+	///          Evaluates the length of the given <paramref name="trip"/> using the precomputed <paramref name="distances"/>.
+	///          No value is returned, the value of <paramref name="trip"/>.fitness is set to the length of the trip.
+	/// </summary>
+	/// <param name="trip">
+	///                    The trip to evaluate.
+	/// </param>
+	/// <param name="distances">
+	///                    The distance table built from the city coordinates.
+	/// </param>
+	void evaluate(Trip trip[CHROMOSOMES], const DistanceMatrix& distances)
+	{
+		evaluateWith(trip, distances);
+	} // end method evaluate
+
+
+	/// <summary>
+	///          Evaluates the length of all trips with the batched <see cref="evaluateBatch"/> kernel and sorts them.
+	///          Each thread scores blocks of consecutive trips so the SIMD paths always see full batches.
+	/// </summary>
+	/// <param name="trip">
+	///                    The trips to evaluate.
+	/// </param>
+	/// <param name="distances">
+	///                    The distance table built from the city coordinates.
+	/// </param>
+	/// <param name="e_isa">
+	///                    Instruction set of the kernel.
+	/// </param>
+	void evaluate(Trip trip[CHROMOSOMES], const DistanceMatrix& distances, const KernelIsa e_isa)
+	{
+		const int i_blockSize = 1024;
+
+		#pragma omp parallel for schedule(static)
+		for (auto i = 0; i < CHROMOSOMES; i += i_blockSize)
+		{
+			const TourBatch batch = { trip[i].itinerary, sizeof(Trip), &trip[i].fitness, sizeof(Trip),
+									  static_cast<std::size_t>(std::min(i_blockSize, CHROMOSOMES - i)), CITIES, GenomeEncoding::ascii };
+
+			evaluateBatch(batch, distances, e_isa);
+		} // end for i
+
+		std::sort(trip, trip + CHROMOSOMES);
+	} // end method evaluate
+
+
+	/// <summary>
+	///          Evaluates and sorts all trips, reading distances from <paramref name="distances"/>.
+	/// </summary>
+	/// <typeparam name="Distance">
+	///                     Any source providing operator()(from, to) and origin() over city indices.
+	/// </typeparam>
+	/// <param name="trip">
+	///                    The trips to evaluate.
+	/// </param>
+	/// <param name="distances">
+	///                    The distance source to use.
+	/// </param>
+	template<typename Distance>
+	void evaluateWith(Trip trip[CHROMOSOMES], const Distance& distances)
+	{
+		const std::size_t ui_origin = distances.origin();
+
+		#pragma omp parallel for schedule(guided)
+		for (auto i = 0; i < CHROMOSOMES; i++)
+		{
+			auto& t = trip[i];
+			float d_tripLength = distances(ui_origin, translateToIndex(t.itinerary[0]));
+
+			for (auto j = 0; j < CITIES - 1; j++)
+			{
+				auto city_1 = translateToIndex(t.itinerary[j]);
+				auto city_2 = translateToIndex(t.itinerary[j+1]);
+
+				d_tripLength += distances(city_1, city_2);
+			} // end for j
+
+			t.fitness = d_tripLength;
+		} // end for i
+
+		std::sort(trip, trip + CHROMOSOMES);
+	} // end template evaluateWith
+
+
+	/// <summary>
+	///          Generates <see cref="TOP_X"/> offsprings from the trips in <paramref name="parents"/> and stores them in
+	///          <paramref name="offsprings"/>.
+	/// </summary>
+	/// <param name="parents">
+	///                       The selected parents that will reproduce into <see cref="TOP_X"/> offspring.
+	/// </param>
+	/// <param name="offsprings">
+	///                          Output parameter for generates offsprings.
+	/// </param>
+	/// <param name="coordinates">
+	///                           The coordinates of the cities to be used for determining distance between cities.
+	/// </param>
+	void crossover(Trip parents[TOP_X], Trip offsprings[TOP_X], const Point* coordinates)
+	{
+		crossoverWith(parents, offsprings, MemoDistance{coordinates, CITIES});
+	} // end method crossover
+
+
+	/// <summary>
+	///          Generates <see cref="TOP_X"/> offsprings from the trips in <paramref name="parents"/> and stores them in
+	///          <paramref name="offsprings"/>, reading distances from the precomputed <paramref name="distances"/>.
+	/// </summary>
+	/// <param name="parents">
+	///                       The selected parents that will reproduce into <see cref="TOP_X"/> offspring.
+	/// </param>
+	/// <param name="offsprings">
+	///                          Output parameter for generates offsprings.
+	/// </param>
+	/// <param name="distances">
+	///                    The distance table built from the city coordinates.
+	/// </param>
+	void crossover(Trip parents[TOP_X], Trip offsprings[TOP_X], const DistanceMatrix& distances)
+	{
+		crossoverWith(parents, offsprings, distances);
+	} // end method crossover
+
+
+	/// <summary>
+	///          Greedy-edge crossover over any distance source, see <see cref="crossover"/>.
+	/// </summary>
+	/// <typeparam name="Distance">
+	///                     Any source providing operator()(from, to) over city indices.
+	/// </typeparam>
+	template<typename Distance>
+	void crossoverWith(Trip parents[TOP_X], Trip offsprings[TOP_X], const Distance& distances)
+	{
+		// shuffle parent pool to increase diversity of children
+		std::shuffle(parents, parents + TOP_X, localEngine());
+
+		// iterate over all pairs of parents
+		#pragma omp parallel for schedule(static)
+		for (auto i = 0; i < TOP_X ; i+= 2)
+		{
+			// parents, child and scratch space, on the stack
+			gene_t g_a_p1[CITIES], g_a_p2[CITIES], g_a_child[CITIES];
+			WordCrossoverState state;
+
+			auto& c1 = offsprings[i];
+			auto& c2 = offsprings[i+1];
+
+			for (auto j = 0; j < CITIES; j++)
+			{
+				g_a_p1[j] = static_cast<gene_t>(translateToIndex(parents[i].itinerary[j]));
+				g_a_p2[j] = static_cast<gene_t>(translateToIndex(parents[i+1].itinerary[j]));
+			} // end for j
+
+			crossoverChild(g_a_p1, g_a_p2, g_a_child, CITIES, distances, localEngine(), state);
+
+			for (auto j = 0; j < CITIES; j++)
+			{
+				c1.itinerary[j] = translateToCity(g_a_child[j]);
+			} // end for j
+
+			c1.itinerary[CITIES] = static_cast<char>(NULL);
+
+			generateComplement(c1.itinerary, c2.itinerary);
+		} // end for i
+	} // end template crossoverWith
+
+
+	/// <summary>
+	///          Generates a random mutation in all given <paramref name="offsprings"/> by swapping two random cities in a trip.
+	///          Mutation may or may not occur for each offspring, this is determined by <see cref="MUTATE_RATE"/>.
+	/// </summary>
+	/// <param name="offsprings">
+	///          The offsprings that should be mutated. Mutations are applied directly to the objects in this array.
+	/// </param>
+	/// <param name="RATE">
+	///          The mutation rate to use for determining whether mutation occurs or not.
+	/// </param>
+	void mutate(Trip offsprings[TOP_X], const int RATE)
+	{
+		#pragma omp parallel for schedule(static)
+		for (auto cur = 0; cur < TOP_X; cur++)
+		{
+			if (randomIntInRange<int>(0,100) <= RATE)
+			{
+				// pick two random cities
+				auto i = randomIntInRange<std::size_t>(0, CITIES-1);
+				auto j = randomIntInRange<std::size_t>(0, CITIES-1);
+
+				while ( i == j)
+				{
+					j = randomIntInRange<std::size_t>(0, CITIES-1);
+				} // end while
+
+				std::swap(offsprings[cur].itinerary[i], offsprings[cur].itinerary[j]);
+			} // end if
+		} // end for
+	} // end method mutate
+
+#pragma endregion
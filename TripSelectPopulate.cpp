@@ -0,0 +1,57 @@
+// Selection and replacement over the original array of Trip records.
+//
+// The Trip[] counterparts of SelectPopulate.cpp, for the array-of-structures baseline of bench_layout.
+// They are kept out of TripOperators.cpp because the legacy Tsp.cpp defines its own select and populate.
+// Selection shares its block tournament with the Population operators (Tournament.hpp).
+
+#pragma region Includes:
+
+	#include <string.h>       // strncpy
+	#include <vector>         // std::vector
+	#include "Trip.h"         // Trip
+	#include "Tournament.hpp" // selectTournament
+
+#pragma endregion
+
+
+#pragma region Function Prototypes:
+
+	void select(const Trip trip[CHROMOSOMES], Trip parents[TOP_X]);
+	void populate(Trip trip[CHROMOSOMES], Trip offsprings[TOP_X]);
+
+#pragma endregion
+
+
+/*
+ * Select TOP_X parents from trip as parents
+ *
+ * @param trip[CHROMOSOMES]: all trips
+ * @param parents[TOP_X]:    the selected TOP_X parents
+ */
+void select(const Trip trip[CHROMOSOMES], Trip parents[TOP_X])
+{
+	thread_local std::vector<std::uint32_t> ui_v_winners;
+
+	ui_v_winners.resize(TOP_X);
+	selectTournament(CHROMOSOMES, TOP_X, [trip](const std::size_t ui_index) { return trip[ui_index].fitness; }, ui_v_winners.data());
+
+	#pragma omp parallel for schedule(static)
+	for (int i = 0; i < TOP_X; i++)
+	{
+		strncpy(parents[i].itinerary, trip[ui_v_winners[i]].itinerary, CITIES + 1);
+	} // end for i
+} // end method select
+
+
+/*
+ * Replace the bottom TOP_X trips with the TOP_X offsprings
+ */
+void populate(Trip trip[CHROMOSOMES], Trip offsprings[TOP_X])
+{
+	// just copy TOP_X offsprings to the bottom TOP_X trips.
+	#pragma omp parallel for
+	for (int i = 0; i < TOP_X; i++)
+	{
+		strncpy(trip[CHROMOSOMES - TOP_X + i].itinerary, offsprings[i].itinerary, CITIES + 1);
+	} // end for
+} // end method populate
@@ -9,42 +9,48 @@
 	#include <iostream>      // cout
 	#include <fstream>       // ifstream, ofstream
 	#include <string.h>      // strncpy
+	#include <string>        // std::string
 	#include <omp.h>         // OpenMP
 	#include <limits>        // float max
 	#include "utility.hpp"   // randomIntInRange
 	#include <unordered_set> // hash set
-	#include "Trip.h"		 // Trip
+	#include "DistanceMatrix.h" // DistanceMatrix
+	#include "RunOptions.h"  // RunOptions
+	#include "Population.h"  // Population
+	#include "Ranking.h"     // rank
+	#include "Instance.h"    // Instance, loadInstance
+	#include "Profiler.h"    // profiler
+	#include "Evolution.h"   // evolve
+	#include "Cluster.h"     // spawnRanks, waitRanks
+	#include "Batch.h"       // runBatch
+	#include "Daemon.h"      // runDaemon
+	#include "EventLog.h"    // EventLog
+	#include <unistd.h>      // getpid
+	#include <vector>        // std::vector
+	#include <algorithm>     // std::copy
+	#include <stdexcept>     // std::runtime_error
 
 #pragma endregion
 
 
 #pragma region Function Prototypes:
 
-	void initialize(Trip trip[CHROMOSOMES], Point coordinates[CITIES]);
-	void select(const Trip trip[CHROMOSOMES], Trip parents[TOP_X]);
-	void populate(Trip trip[CHROMOSOMES], Trip offsprings[TOP_X]);
-	int run(int nThreads, int i_mutationRate, std::ofstream& out_file);
-
-#pragma endregion
-
-
-#pragma region External Function Prototypes:
-
-	extern void evaluate(Trip trip[CHROMOSOMES], const Point* coordinates);
-	extern void crossover(Trip parents[TOP_X], Trip offsprings[TOP_X], const Point* coordinates);
-	extern void mutate(Trip offsprings[TOP_X], const int RATE);
+	int run(const RunOptions& options, std::ofstream& out_file);
+	bool parseOption(const char* arg, RunOptions& options);
 
 #pragma endregion
 
 
 /*
- * MAIN: usage: Tsp #threads, mutation rate %
+ * MAIN: usage: Tsp #threads, mutation rate %, [--option=value ...]
  */
 int main(int argc, char* argv[]) 
 {
-	int nThreads = 1;           // number of threads
-	int i_mutationRate = 50;			// mutation rate to use
+	RunOptions options;					// options of this run
 	int i_output = 1;					// main return value
+	int i_positional = 0;				// number of positional arguments seen
+	bool b_argsValid = true;			// whether all arguments parsed
+	std::vector<pid_t> children;		// ranks forked by this process
 
 	std::ofstream out_file("program_output.txt", std::ios::out | std::ios::app); // output file
 	
@@ -57,31 +63,92 @@ int main(int argc, char* argv[])
 	} // end if
 
 	// verify the arguments
-	if (argc == 2)
-	{
-		nThreads = atoi(argv[1]);
-	} // end if
-	else if (argc == 3)
+	for (int i = 1; i < argc && b_argsValid; i++)
 	{
-		nThreads = atoi(argv[1]);
-		i_mutationRate = atoi(argv[2]);
-	} // end elif
-	else
+		if (strncmp(argv[i], "--", 2) == 0)
+		{
+			b_argsValid = parseOption(argv[i] + 2, options);
+		} // end if
+		else if (i_positional == 0)
+		{
+			options.nThreads = atoi(argv[i]);
+			i_positional++;
+		} // end elif
+		else if (i_positional == 1)
+		{
+			options.i_mutationRate = atoi(argv[i]);
+			i_positional++;
+		} // end elif
+		else
+		{
+			b_argsValid = false;
+		} // end else
+	} // end for i
+
+	if (!b_argsValid || i_positional == 0)
 	{
-		std::cout << "usage: Tsp <#threads> <mutation rate %>" << std::endl;
+		std::cout << "usage: Tsp <#threads> <mutation rate %> [--distance=memo|matrix] [--kernel=auto|scalar|sse41|avx2] [--ranking=sort|partition|parallel] [--seed=N]"
+				  << " [--population=file.bin|random] [--cities=file] [--chromosomes=file] [--size=N] [--top=N] [--generations=N]"
+				  << " [--profile=report.json|report.csv] [--islands=N] [--topology=ring|random] [--migration=G] [--migrants=N]"
+				  << " [--ranks=N [--rank=R --endpoint=path]] [--local-search=fraction] [--local-budget=us]"
+				  << " [--validate=off|count|abort|repair] [--validate-sample=fraction] [--mutation=fixed|ramp|adaptive] [--diversity-target=fraction]"
+				  << " [--deadline=ms] [--target=distance] [--stagnation=G] [--evaluations=N] [--checkpoint=file [--checkpoint-every=G]] [--resume=file]"
+				  << " [--batch=directory|- (job lines \"cities-file [--option=value ...]\" on stdin)]"
+				  << " [--serve=path|tcp:PORT (solver daemon, see tsp_client)] [--log=text|json|binary [--log-file=file]]"
+				  << " [--pipeline=loops|tasks [--chunks=N]] [--affinity=none|compact|spread]" << std::endl;
 		if (argc != 1)
 		{
 			out_file.close();
 			exit(EXIT_FAILURE); // wrong arguments
 		} // end if
-	} // end else
+	} // end if
+
+	// ranks started by hand must agree on where to meet
+	if (options.ui_rank >= options.ui_ranks || (!options.b_spawnRanks && options.s_endpoint.empty()))
+	{
+		std::cout << "--rank needs --ranks above it and an --endpoint shared by all ranks" << std::endl;
+		out_file.close();
+		exit(EXIT_FAILURE);
+	} // end if
 
 	// run GA
 	try
 	{
-		i_output = run(nThreads, i_mutationRate, out_file);
+		if (options.ui_ranks > 1 && options.b_spawnRanks)
+		{
+			// every rank generates the same population and meets the others at the same place
+			std::random_device rd{};
+
+			options.ui_seed = (options.b_hasSeed ? options.ui_seed : (static_cast<std::uint64_t>(rd()) << 32) ^ rd());
+			options.b_hasSeed = true;
+			options.s_endpoint = (options.s_endpoint.empty() ? "/tmp/tsp-" + std::to_string(getpid()) : options.s_endpoint);
+
+			children = spawnRanks(options.ui_rank, options.ui_ranks);
+		} // end if
+
+		if (options.ui_rank > 0)
+		{
+			// only rank 0 writes the output file and the profile
+			out_file.close();
+			options.s_profileFile.clear();
+		} // end if
+
+		if (!options.s_serveEndpoint.empty())
+		{
+			i_output = runDaemon(options, out_file);
+		} // end if
+		else if (!options.s_batchSource.empty())
+		{
+			i_output = runBatch(options, out_file, parseOption);
+		} // end elif
+		else
+		{
+			i_output = run(options, out_file);
+		} // end else
+
+		i_output = (waitRanks(children) != EXIT_SUCCESS ? EXIT_FAILURE : i_output);
 	} // end try
-	catch(std::exception e)
+	catch(const std::exception& e)
 	{
 		std::cout << "Execution failed!" << std::endl;
 		std::cout << "Reason: " << e.what() << std::endl;
@@ -105,202 +172,484 @@ int main(int argc, char* argv[])
 
 
 /// <summary>
-///			Runs the Genetic algorithm.
+///			Parses a single "name=value" command line option into <paramref name="options"/>.
 /// </summary>
-/// <param name="nThreads">
-///			Number of threads to use for the algorithm.
-/// </param>
-/// <param name="i_mutationRate">
-///			Starting mutation rate to use.
+/// <param name="arg">
+///			The option without its leading dashes.
 /// </param>
-/// <param name="out_file">
-///			File handle to output file.
+/// <param name="options">
+///			Options to update.
 /// </param>
 /// <returns>
-///			0 on success
+///			true if the option was recognized and its value is valid
 /// </returns>
-int run(int nThreads, int i_mutationRate, std::ofstream& out_file)
+bool parseOption(const char* arg, RunOptions& options)
 {
-	Trip *trip = new Trip[CHROMOSOMES],	// all 50000 different trips (or chromosomes)
-		 *parents = new Trip[TOP_X],	// pool of selected parents
-		 *offsprings = new Trip[TOP_X]; // pool of generate children
+	const char* c_separator = strchr(arg, '=');
 
-	Trip shortest;                      // the shortest path so far
-	Point coordinates[CITIES];          // (x, y) coordinates of all 36 cities:
-	
-	
-	int bias = 0;						// bias value for mutation rate	
+	if (c_separator == nullptr)
+	{
+		return false;
+	} // end if
 
-	#if ENABLE_STD_OUT
-		std::cout << "# threads = " << nThreads << std::endl;
-		std::cout << "current rate " << i_mutationRate << std::endl;
-	#endif
+	const std::string name(arg, c_separator);
+	const std::string value(c_separator + 1);
+	bool b_valid = false;
 
-	out_file << "# threads = " << nThreads << std::endl;
-	out_file << "current rate " << i_mutationRate << std::endl;
+	if (name == "distance")
+	{
+		b_valid = (value == "memo" || value == "matrix");
+		options.e_distanceMode = (value == "memo" ? DistanceMode::memo : DistanceMode::matrix);
+	} // end if
+	else if (name == "kernel")
+	{
+		b_valid = parseKernelIsa(value.c_str(), options.e_kernelIsa);
+	} // end elif
+	else if (name == "ranking")
+	{
+		b_valid = parseRankingMode(value.c_str(), options.e_rankingMode);
+	} // end elif
+	else if (name == "seed")
+	{
+		char* c_end = nullptr;
+
+		options.ui_seed = strtoull(value.c_str(), &c_end, 10);
+		options.b_hasSeed = true;
+		b_valid = !value.empty() && *c_end == 0;
+	} // end elif
+	else if (name == "population")
+	{
+		options.s_populationFile = value;
+		b_valid = !value.empty();
+	} // end elif
+	else if (name == "cities")
+	{
+		options.s_citiesFile = value;
+		b_valid = !value.empty();
+	} // end elif
+	else if (name == "chromosomes")
+	{
+		options.s_chromosomeFile = value;
+		b_valid = !value.empty();
+	} // end elif
+	else if (name == "profile")
+	{
+		// the report needs the probes compiled in
+		options.s_profileFile = value;
+		b_valid = !value.empty() && ENABLE_PROFILING;
+	} // end elif
+	else if (name == "topology")
+	{
+		b_valid = parseMigrationTopology(value.c_str(), options.e_topology);
+	} // end elif
+	else if (name == "local-search")
+	{
+		char* c_end = nullptr;
+
+		options.d_localSearch = strtod(value.c_str(), &c_end);
+		b_valid = !value.empty() && *c_end == 0 && options.d_localSearch > 0 && options.d_localSearch <= 1;
+	} // end elif
+	else if (name == "mutation")
+	{
+		b_valid = parseMutationSchedule(value.c_str(), options.e_mutationSchedule);
+	} // end elif
+	else if (name == "diversity-target")
+	{
+		char* c_end = nullptr;
 
-	// initialize 5000 trips and 36 cities' coordinates
-	initialize(trip, coordinates);
+		options.d_diversityTarget = strtod(value.c_str(), &c_end);
+		b_valid = !value.empty() && *c_end == 0 && options.d_diversityTarget >= 0 && options.d_diversityTarget <= 1;
+	} // end elif
+	else if (name == "deadline" || name == "evaluations")
+	{
+		char* c_end = nullptr;
+		const long long i_limit = strtoll(value.c_str(), &c_end, 10);
+
+		b_valid = !value.empty() && *c_end == 0 && i_limit > 0;
+		(name == "deadline" ? options.i_deadline : options.i_evaluationBudget) = i_limit;
+	} // end elif
+	else if (name == "target")
+	{
+		char* c_end = nullptr;
 
-	// start a timer 
-	timePoint end = highRes_Clock::now();
-	timePoint start = highRes_Clock::now();
+		options.d_targetDistance = strtod(value.c_str(), &c_end);
+		b_valid = !value.empty() && *c_end == 0 && options.d_targetDistance > 0;
+	} // end elif
+	else if (name == "stagnation")
+	{
+		char* c_end = nullptr;
+		const unsigned long long ui_count = strtoull(value.c_str(), &c_end, 10);
 
-	// change # of threads
-	omp_set_num_threads(nThreads);
+		b_valid = !value.empty() && *c_end == 0 && ui_count > 0 && ui_count <= static_cast<unsigned long long>(std::numeric_limits<int>::max());
+		options.i_stagnation = static_cast<int>(ui_count);
+	} // end elif
+	else if (name == "checkpoint" || name == "resume" || name == "batch" || name == "serve")
+	{
+		(name == "checkpoint" ? options.s_checkpointFile : name == "resume" ? options.s_resumeFile : name == "batch" ? options.s_batchSource : options.s_serveEndpoint) = value;
+		b_valid = !value.empty();
+	} // end elif
+	else if (name == "log")
+	{
+		b_valid = parseLogFormat(value.c_str(), options.e_logFormat);
+	} // end elif
+	else if (name == "pipeline")
+	{
+		b_valid = parsePipelineMode(value.c_str(), options.e_pipeline);
+	} // end elif
+	else if (name == "affinity")
+	{
+		b_valid = parseAffinityPolicy(value.c_str(), options.e_affinity);
+	} // end elif
+	else if (name == "chunks")
+	{
+		char* c_end = nullptr;
+		const unsigned long long ui_count = strtoull(value.c_str(), &c_end, 10);
+
+		b_valid = !value.empty() && *c_end == 0 && ui_count > 0;
+		options.ui_chunks = static_cast<std::size_t>(ui_count);
+	} // end elif
+	else if (name == "log-file")
+	{
+		options.s_logFile = value;
+		b_valid = !value.empty();
+	} // end elif
+	else if (name == "checkpoint-every")
+	{
+		char* c_end = nullptr;
+		const unsigned long long ui_interval = strtoull(value.c_str(), &c_end, 10);
+
+		b_valid = !value.empty() && *c_end == 0 && ui_interval > 0 && ui_interval <= static_cast<unsigned long long>(std::numeric_limits<int>::max());
+		options.i_checkpointInterval = static_cast<int>(ui_interval);
+	} // end elif
+	else if (name == "validate")
+	{
+		// the stage needs to be compiled in to do anything but nothing
+		b_valid = parseValidationMode(value.c_str(), options.e_validation) && (ENABLE_VALIDATION || options.e_validation == ValidationMode::off);
+	} // end elif
+	else if (name == "validate-sample")
+	{
+		char* c_end = nullptr;
+
+		options.d_validateSample = strtod(value.c_str(), &c_end);
+		b_valid = !value.empty() && *c_end == 0 && options.d_validateSample > 0 && options.d_validateSample <= 1;
+	} // end elif
+	else if (name == "local-budget")
+	{
+		char* c_end = nullptr;
+
+		options.i_localBudget = strtoll(value.c_str(), &c_end, 10);
+		b_valid = !value.empty() && *c_end == 0 && options.i_localBudget >= 0;
+	} // end elif
+	else if (name == "endpoint")
+	{
+		options.s_endpoint = value;
+		b_valid = !value.empty();
+	} // end elif
+	else if (name == "rank")
+	{
+		char* c_end = nullptr;
 
-	// find the shortest path in each generation
-	for (int generation = 0; generation < MAX_GENERATION; generation++) {
+		options.ui_rank = static_cast<std::size_t>(strtoull(value.c_str(), &c_end, 10));
+		options.b_spawnRanks = false;
+		b_valid = !value.empty() && *c_end == 0;
+	} // end elif
+	else if (name == "islands" || name == "migration" || name == "migrants" || name == "ranks")
+	{
+		char* c_end = nullptr;
+		const unsigned long long ui_count = strtoull(value.c_str(), &c_end, 10);
 
-		// evaluate the distance of all 50000 trips
-		evaluate(trip, coordinates);
+		b_valid = !value.empty() && *c_end == 0 && ui_count > 0 && ui_count <= static_cast<unsigned long long>(std::numeric_limits<int>::max());
 
-		// just print out the progress
-		if (!(generation % 20))
+		if (name == "islands")
 		{
-			std::cout << "generation: " << generation << std::endl;
-
-			// update mutation rate to diversify converging population
-			i_mutationRate = (bias < 99 ? bias : 99);
-			bias += 20;
+			options.ui_islands = static_cast<std::size_t>(ui_count);
 		} // end if
+		else if (name == "migration")
+		{
+			options.i_migrationInterval = static_cast<int>(ui_count);
+		} // end elif
+		else if (name == "ranks")
+		{
+			options.ui_ranks = static_cast<std::size_t>(ui_count);
+		} // end elif
+		else
+		{
+			options.ui_migrants = static_cast<std::size_t>(ui_count);
+		} // end else
+	} // end elif
+	else if (name == "size" || name == "top" || name == "generations")
+	{
+		char* c_end = nullptr;
+		const unsigned long long ui_count = strtoull(value.c_str(), &c_end, 10);
+
+		b_valid = !value.empty() && *c_end == 0 && ui_count > 0 && ui_count <= static_cast<unsigned long long>(std::numeric_limits<int>::max());
 
-		// whenever a shorter path was found, update the shortest path
-		if (shortest.fitness < 0 || shortest.fitness > trip[0].fitness)
+		if (name == "size")
 		{
-			shortest = trip[0];
-			#if ENABLE_STD_OUT
-				std::cout << "generation: " << generation << " shortest distance = " << shortest.fitness << "\t itinerary = " << shortest.itinerary << std::endl;
-			#endif
-			out_file << "generation: " << generation << " shortest distance = " << shortest.fitness	<< "\t itinerary = " << shortest.itinerary << std::endl;
+			options.ui_population = static_cast<std::size_t>(ui_count);
 		} // end if
+		else if (name == "top")
+		{
+			options.ui_offsprings = static_cast<std::size_t>(ui_count);
+		} // end elif
+		else
+		{
+			options.i_generations = static_cast<int>(ui_count);
+		} // end else
+	} // end elif
+
+	return b_valid;
+} // end method parseOption
+
 
-		// choose TOP_X parents from trip
-		select(trip, parents);
+/// <summary>
+///			Runs the Genetic algorithm.
+/// </summary>
+/// <param name="options">
+///			Number of threads, starting mutation rate and engine selection for the algorithm.
+/// </param>
+/// <param name="out_file">
+///			File handle to output file.
+/// </param>
+/// <returns>
+///			0 on success
+/// </returns>
+int run(const RunOptions& options, std::ofstream& out_file)
+{
+	const Instance instance = loadInstance(options);             // cities and dimensions of the run
+	const Point* coordinates = instance.coordinates.data();      // (x, y) coordinates of all cities
+	const std::size_t ui_cities = instance.cities();
 
-		// generates TOP_X offsprings from TOP_X parenets
-		crossover(parents, offsprings, coordinates);
+	const int nThreads = options.nThreads;
 
-		// mutate offsprings
-		mutate(offsprings, i_mutationRate);
+	// change # of threads, and pin them before the first population is touched so its pages land on their nodes
+	omp_set_num_threads(nThreads);
+	const std::size_t ui_nodes = pinThreads(options.e_affinity, nThreads);
 
-		// populate the next generation.
-		populate(trip, offsprings);
-	} // end for generation
+	Population trip(instance.ui_population, ui_cities);          // all different trips (or chromosomes)
 
-	// stop the timer
-	end = highRes_Clock::now();
+	const bool b_useMatrix = (options.e_distanceMode == DistanceMode::matrix);
+	const std::size_t ui_chunks = pipelineChunks(options.ui_chunks, instance.ui_offsprings, static_cast<std::size_t>(nThreads));
 
 	#if ENABLE_STD_OUT
-		std::cout << " shortest distance = " << shortest.fitness << "\t itinerary = " << shortest.itinerary << std::endl;
-		std::cout << "elapsed time = " << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() << " ms." << std::endl;
+		std::cout << "# threads = " << nThreads << std::endl;
+		std::cout << "current rate " << options.i_mutationRate << std::endl;
+		std::cout << "mutation: " << mutationScheduleName(options.e_mutationSchedule) << ", diversity target " << options.d_diversityTarget << std::endl;
+		std::cout << "distances: " << (b_useMatrix ? "matrix" : "memo") << std::endl;
+		std::cout << "kernel: " << kernelIsaName(resolveKernelIsa(options.e_kernelIsa)) << std::endl;
+		std::cout << "ranking: " << rankingModeName(options.e_rankingMode) << std::endl;
+		std::cout << "population: " << (options.s_populationFile.empty() ? options.s_chromosomeFile : options.s_populationFile) << std::endl;
+		std::cout << "instance: " << ui_cities << " cities, " << instance.ui_population << " tours, " << instance.ui_offsprings << " offsprings, " << instance.i_generations << " generations" << std::endl;
+		if (options.ui_islands > 0)
+		{
+			std::cout << "islands: " << options.ui_islands << " on a " << migrationTopologyName(options.e_topology) << ", " << options.ui_migrants
+					  << " migrants every " << options.i_migrationInterval << " generations" << std::endl;
+		} // end if
+		if (options.e_pipeline == PipelineMode::tasks)
+		{
+			std::cout << "pipeline: tasks, " << ui_chunks << " chunks" << std::endl;
+		} // end if
+		if (options.e_affinity != AffinityPolicy::none)
+		{
+			std::cout << "affinity: " << affinityPolicyName(options.e_affinity) << ", " << nThreads << " threads on "
+			          << ui_nodes << (ui_nodes == 1 ? " node" : " nodes") << std::endl;
+		} // end if
+		if (options.d_localSearch > 0)
+		{
+			std::cout << "local search: " << options.d_localSearch * 100 << "% of offsprings, budget " << options.i_localBudget << " us" << std::endl;
+		} // end if
+		if (ENABLE_VALIDATION && options.e_validation != ValidationMode::off)
+		{
+			std::cout << "validation: " << validationModeName(options.e_validation) << ", " << options.d_validateSample * 100 << "% of tours per generation" << std::endl;
+		} // end if
+		if (!options.s_checkpointFile.empty())
+		{
+			std::cout << "checkpoints: every " << options.i_checkpointInterval << " generations to " << options.s_checkpointFile << std::endl;
+		} // end if
+		if (!options.s_resumeFile.empty())
+		{
+			std::cout << "resume: " << options.s_resumeFile << std::endl;
+		} // end if
+		if (options.ui_ranks > 1)
+		{
+			std::cout << "ranks: " << options.ui_ranks << " on a " << migrationTopologyName(options.e_topology) << " at " << options.s_endpoint << ", "
+					  << options.ui_migrants << " migrants every " << options.i_migrationInterval << " generations" << std::endl;
+		} // end if
 	#endif
 
-	out_file << " shortest distance = " << shortest.fitness << "\t itinerary = " << shortest.itinerary << std::endl;
-	out_file << "elapsed time = " << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() << " ms." << std::endl << std::endl << std::endl;
-
-	// clean up
-	delete[] trip;
-	delete[] parents;
-	delete[] offsprings;
+	out_file << "# threads = " << nThreads << std::endl;
+	out_file << "current rate " << options.i_mutationRate << std::endl;
+	out_file << "mutation: " << mutationScheduleName(options.e_mutationSchedule) << ", diversity target " << options.d_diversityTarget << std::endl;
+	out_file << "distances: " << (b_useMatrix ? "matrix" : "memo") << std::endl;
+	out_file << "kernel: " << kernelIsaName(resolveKernelIsa(options.e_kernelIsa)) << std::endl;
+	out_file << "ranking: " << rankingModeName(options.e_rankingMode) << std::endl;
+	out_file << "population: " << (options.s_populationFile.empty() ? options.s_chromosomeFile : options.s_populationFile) << std::endl;
+	out_file << "instance: " << ui_cities << " cities, " << instance.ui_population << " tours, " << instance.ui_offsprings << " offsprings, " << instance.i_generations << " generations" << std::endl;
+	if (options.ui_islands > 0)
+	{
+		out_file << "islands: " << options.ui_islands << " on a " << migrationTopologyName(options.e_topology) << ", " << options.ui_migrants
+				 << " migrants every " << options.i_migrationInterval << " generations" << std::endl;
+	} // end if
+	if (options.e_pipeline == PipelineMode::tasks)
+	{
+		out_file << "pipeline: tasks, " << ui_chunks << " chunks" << std::endl;
+	} // end if
+	if (options.e_affinity != AffinityPolicy::none)
+	{
+		out_file << "affinity: " << affinityPolicyName(options.e_affinity) << ", " << nThreads << " threads on "
+		         << ui_nodes << (ui_nodes == 1 ? " node" : " nodes") << std::endl;
+	} // end if
+	if (options.d_localSearch > 0)
+	{
+		out_file << "local search: " << options.d_localSearch * 100 << "% of offsprings, budget " << options.i_localBudget << " us" << std::endl;
+	} // end if
+	if (ENABLE_VALIDATION && options.e_validation != ValidationMode::off)
+	{
+		out_file << "validation: " << validationModeName(options.e_validation) << ", " << options.d_validateSample * 100 << "% of tours per generation" << std::endl;
+	} // end if
+	if (!options.s_checkpointFile.empty())
+	{
+		out_file << "checkpoints: every " << options.i_checkpointInterval << " generations to " << options.s_checkpointFile << std::endl;
+	} // end if
+	if (!options.s_resumeFile.empty())
+	{
+		out_file << "resume: " << options.s_resumeFile << std::endl;
+	} // end if
+	if (options.ui_ranks > 1)
+	{
+		out_file << "ranks: " << options.ui_ranks << " on a " << migrationTopologyName(options.e_topology) << " at " << options.s_endpoint << ", "
+				 << options.ui_migrants << " migrants every " << options.i_migrationInterval << " generations" << std::endl;
+	} // end if
 
-	return EXIT_SUCCESS;
-} // end method run
+	// one master seed for the generated population and every thread's engine, so the run can be repeated
+	std::random_device rd{};
+	const std::uint64_t ui_seed = (options.b_hasSeed ? options.ui_seed : (static_cast<std::uint64_t>(rd()) << 32) ^ rd());
 
+	// read or generate the initial trips
+	loadPopulation(options, instance, trip, ui_seed);
 
-/*
- * Initializes trip[CHROMOSOMES] with chromosome.txt and coordiantes[CITIES][2] with cities.txt
- *
- * @param trip[CHROMOSOMES]:      50000 different trips
- * @param coordinates[CITIES][2]: (x, y) coordinates of 36 different cities: ABCDEFGHIJKLMNOPQRSTUVWXYZ
- */
-void initialize(Trip trip[CHROMOSOMES], Point coordinates[CITIES]) {
-	// open two files to read chromosomes (i.e., trips)  and cities
-	std::ifstream chromosome_file("chromosome.txt");
-	std::ifstream cities_file("cities.txt");
-
-	// read data from the files
-	// chromosome.txt:                                                                                           
-	//   T8JHFKM7BO5XWYSQ29IP04DL6NU3ERVA1CZG                                                                    
-	//   FWLXU2DRSAQEVYOBCPNI608194ZHJM73GK5T                                                                    
-	//   HU93YL0MWAQFIZGNJCRV12TO75BPE84S6KXD
-	for (int i = 0; i < CHROMOSOMES; i++) {
-		chromosome_file >> trip[i].itinerary;
-		trip[i].fitness = std::numeric_limits<float>::max();
-	}
-
-	// cities.txt:                                                                                               
-	// name    x       y                                                                                         
-	// A       83      99                                                                                        
-	// B       77      35                                                                                        
-	// C       14      64                                                                                        
-	for (int i = 0; i < CITIES; i++) {
-		char city;
-		cities_file >> city;
-		int index = (city >= 'A') ? city - 'A' : city - '0' + 26;
-		cities_file >> coordinates[index].x >> coordinates[index].y;
-	}
-
-	// close the files.
-	chromosome_file.close();
-	cities_file.close();
-}
+	// precompute all city-to-city distances once, read lock-free by every operator
+	const DistanceMatrix distances(coordinates, ui_cities);
 
+	// progress goes through the event log, its writer thread does the console and file I/O
+	EventLog log(options.e_logFormat, options.s_logFile, ui_cities, out_file);
+	int i_logged = -1;
 
-/*
- * Select TOP_X parents from trip as parents
- *
- * @param trip[CHROMOSOMES]: all trips
- * @param parents[TOP_X]:    the selected TOP_X parents
- */
-void select(const Trip trip[CHROMOSOMES], Trip parents[TOP_X]) 
-{
-	std::unordered_set<std::size_t> selected;
+	#if ENABLE_STD_OUT
+		std::cout << "seed = " << ui_seed << std::endl;
+		if (options.e_logFormat != LogFormat::text)
+		{
+			std::cout << "log: " << logFormatName(options.e_logFormat) << " events to " << log.path() << std::endl;
+		} // end if
+	#endif
+	out_file << "seed = " << ui_seed << std::endl;
+	if (options.e_logFormat != LogFormat::text)
+	{
+		out_file << "log: " << logFormatName(options.e_logFormat) << " events to " << log.path() << std::endl;
+	} // end if
 
-	// tournament selection
-	for (auto i = 0; i < TOP_X; i++)
+	const EvolutionResult result = evolve(options, instance, trip, distances, ui_seed,
+		[&](const int generation, const bool b_improved, const EvolutionResult& best)
 	{
-		std::size_t ui_winnerIndex = randomIntInRange<std::size_t>(0, CHROMOSOMES - 1);
+		// islands report their improvements besides island 0's generations, one generation event each
+		if (generation != i_logged)
+		{
+			log.post(EventKind::generation, generation, best.f_shortest);
+			i_logged = generation;
+		} // end if
 
-		while (selected.count(ui_winnerIndex) > 0)
+		if (b_improved)
 		{
-			ui_winnerIndex = randomIntInRange<std::size_t>(0, CHROMOSOMES - 1);
-		} // end while
+			log.post(EventKind::improved, generation, best.f_shortest, best.shortest.data());
+		} // end if
+	});
 
-		for (auto j = 1; j < TOURNAMENT_SIZE; j++)
+	log.post(EventKind::finished, result.i_generations, result.f_shortest, nullptr, static_cast<std::uint32_t>(result.e_stopReason));
+	log.finish();
+
+	#if ENABLE_STD_OUT
+		std::cout << " shortest distance = " << result.f_shortest << "\t itinerary = " << formatTour(result.shortest.data(), ui_cities) << std::endl;
+		std::cout << "elapsed time = " << result.i_elapsed << " us." << std::endl;
+		std::cout << "stopped: " << stopReasonName(result.e_stopReason) << " after " << result.i_generations << " generations, " << result.i_evaluations << " evaluations" << std::endl;
+		if (options.ui_islands > 0 || options.ui_ranks > 1)
+		{
+			std::cout << "migrations: " << result.i_migrations << " posted, " << result.i_droppedMigrations << " dropped" << std::endl;
+		} // end if
+		if (!options.s_checkpointFile.empty() || !options.s_resumeFile.empty())
+		{
+			std::cout << "checkpoints: resumed at generation " << result.i_resumedAt << ", " << result.i_checkpoints << " written, " << result.i_skippedCheckpoints << " skipped" << std::endl;
+		} // end if
+		if (options.e_logFormat != LogFormat::text || log.dropped() > 0)
+		{
+			std::cout << "log: " << log.posted() << " events, " << log.dropped() << " dropped" << std::endl;
+		} // end if
+		std::cout << "final rate " << result.i_mutationRate << "%, " << result.i_inversionShare << "% inversions" << std::endl;
+		if (options.e_mutationSchedule == MutationSchedule::adaptive)
+		{
+			std::cout << "diversity: " << result.diversity.d_diversity << " (edge entropy " << result.diversity.d_edgeEntropy << ", duplicates "
+					  << result.diversity.d_duplicateRate * 100 << "%, fitness " << result.diversity.d_fitnessMean << " +- " << result.diversity.d_fitnessStdDev << ")" << std::endl;
+		} // end if
+		if (ENABLE_VALIDATION && options.e_validation != ValidationMode::off)
 		{
-			auto ui_candidateIndex = randomIntInRange<std::size_t>(0, CHROMOSOMES - 1);
+			std::cout << "validated: " << result.validation.i_checked << " tours checked, " << result.validation.i_invalid << " invalid, "
+					  << result.validation.i_repaired << " repaired" << std::endl;
+		} // end if
+		#if ENABLE_PROFILING
+			profiler().writeSummary(std::cout);
+		#endif
+	#endif
 
-			while (selected.count(ui_candidateIndex) > 0)
-			{
-				ui_candidateIndex = randomIntInRange<std::size_t>(0, CHROMOSOMES - 1);
-			} // end while
+	out_file << " shortest distance = " << result.f_shortest << "\t itinerary = " << formatTour(result.shortest.data(), ui_cities) << std::endl;
+	out_file << "elapsed time = " << result.i_elapsed << " us." << std::endl;
+	out_file << "stopped: " << stopReasonName(result.e_stopReason) << " after " << result.i_generations << " generations, " << result.i_evaluations << " evaluations" << std::endl;
+	if (options.ui_islands > 0 || options.ui_ranks > 1)
+	{
+		out_file << "migrations: " << result.i_migrations << " posted, " << result.i_droppedMigrations << " dropped" << std::endl;
+	} // end if
+	if (!options.s_checkpointFile.empty() || !options.s_resumeFile.empty())
+	{
+		out_file << "checkpoints: resumed at generation " << result.i_resumedAt << ", " << result.i_checkpoints << " written, " << result.i_skippedCheckpoints << " skipped" << std::endl;
+	} // end if
+	if (options.e_logFormat != LogFormat::text || log.dropped() > 0)
+	{
+		out_file << "log: " << log.posted() << " events, " << log.dropped() << " dropped" << std::endl;
+	} // end if
+	out_file << "final rate " << result.i_mutationRate << "%, " << result.i_inversionShare << "% inversions" << std::endl;
+	if (options.e_mutationSchedule == MutationSchedule::adaptive)
+	{
+		out_file << "diversity: " << result.diversity.d_diversity << " (edge entropy " << result.diversity.d_edgeEntropy << ", duplicates "
+				 << result.diversity.d_duplicateRate * 100 << "%, fitness " << result.diversity.d_fitnessMean << " +- " << result.diversity.d_fitnessStdDev << ")" << std::endl;
+	} // end if
+	if (ENABLE_VALIDATION && options.e_validation != ValidationMode::off)
+	{
+		out_file << "validated: " << result.validation.i_checked << " tours checked, " << result.validation.i_invalid << " invalid, "
+				 << result.validation.i_repaired << " repaired" << std::endl;
+	} // end if
+	#if ENABLE_PROFILING
+		profiler().writeSummary(out_file);
+	#endif
+	out_file << std::endl << std::endl;
 
-			if (trip[ui_candidateIndex].fitness < trip[ui_winnerIndex].fitness)
-			{
-				ui_winnerIndex = ui_candidateIndex;
-			} // end if
-		} // end for j
-		
-		#pragma omp critical(winner_table)
+	if (!options.s_profileFile.empty())
+	{
+		std::ofstream profile_file(options.s_profileFile, std::ios::out | std::ios::trunc);
+		const std::size_t ui_length = options.s_profileFile.size();
+
+		if (!profile_file.is_open())
 		{
-			selected.insert(ui_winnerIndex);
-		} // end critical
+			throw std::runtime_error("cannot open " + options.s_profileFile);
+		} // end if
 
-		strncpy(parents[i].itinerary, trip[ui_winnerIndex].itinerary, CITIES + 1);
-	} // end for i
-} // end method select
+		if (ui_length >= 4 && options.s_profileFile.compare(ui_length - 4, 4, ".csv") == 0)
+		{
+			profiler().writeCsv(profile_file);
+		} // end if
+		else
+		{
+			profiler().writeJson(profile_file);
+		} // end else
+	} // end if
 
+	return EXIT_SUCCESS;
+} // end method run
 
-/*
- * Replace the bottom TOP_X trips with the TOP_X offsprings
- */
-void populate(Trip trip[CHROMOSOMES], Trip offsprings[TOP_X]) 
-{
-	// just copy TOP_X offsprings to the bottom TOP_X trips.
-	#pragma omp parallel for 
-	for (int i = 0; i < TOP_X; i++)
-	{
-		strncpy(trip[CHROMOSOMES - TOP_X + i].itinerary, offsprings[i].itinerary, CITIES + 1);
-	} // end for
-} // end method populate
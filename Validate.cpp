@@ -0,0 +1,278 @@
+#pragma region Includes:
+
+	#include "Validate.h"      // ValidationMode, ValidationReport
+	#include "FitnessKernel.h" // resolveKernelIsa
+	#include "Instance.h"      // formatTour
+	#include <algorithm>       // std::min, std::max
+	#include <cmath>           // std::ceil
+	#include <cstdint>         // std::uint64_t
+	#include <limits>          // std::numeric_limits
+	#include <stdexcept>       // std::runtime_error
+	#include <string>          // std::to_string
+	#include <string.h>        // strcmp
+	#include <vector>          // std::vector
+
+	#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+		#define VALIDATE_X86 1
+		#include <immintrin.h> // AVX2 intrinsics
+	#else
+		#define VALIDATE_X86 0
+	#endif
+
+#pragma endregion
+
+
+#pragma region Helpers:
+
+	/// <summary>
+	///          One bit per city: bit g of the result is set for every gene g below 64 of the first
+	///          <paramref name="ui_cities"/> genes, genes of 64 and above set nothing.
+	/// </summary>
+	static std::uint64_t cityMaskScalar(const gene_t* genome, const std::size_t ui_first, const std::size_t ui_cities) noexcept
+	{
+		std::uint64_t ui_mask = 0;
+
+		for (std::size_t j = ui_first; j < ui_cities; j++)
+		{
+			ui_mask |= (genome[j] < 64 ? std::uint64_t(1) << genome[j] : 0);
+		} // end for j
+
+		return ui_mask;
+	} // end method cityMaskScalar
+
+
+#if VALIDATE_X86
+
+	/// <summary>
+	///          AVX2 version of <see cref="cityMaskScalar"/>, widens 4 genes per step to 64-bit lanes and shifts a one by
+	///          each; variable shifts by 64 or more give 0, so out-of-range genes drop out like in the scalar loop.
+	/// </summary>
+	__attribute__((target("avx2")))
+	static std::uint64_t cityMaskAvx2(const gene_t* genome, const std::size_t ui_cities) noexcept
+	{
+		const std::size_t ui_full = ui_cities & ~static_cast<std::size_t>(3);
+		const __m256i v_one = _mm256_set1_epi64x(1);
+		__m256i v_mask = _mm256_setzero_si256();
+
+		for (std::size_t j = 0; j < ui_full; j += 4)
+		{
+			const __m256i v_genes = _mm256_cvtepu16_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(genome + j)));
+			v_mask = _mm256_or_si256(v_mask, _mm256_sllv_epi64(v_one, v_genes));
+		} // end for j
+
+		const __m128i v_half = _mm_or_si128(_mm256_castsi256_si128(v_mask), _mm256_extracti128_si256(v_mask, 1));
+
+		return static_cast<std::uint64_t>(_mm_extract_epi64(v_half, 0) | _mm_extract_epi64(v_half, 1)) | cityMaskScalar(genome, ui_full, ui_cities);
+	} // end method cityMaskAvx2
+
+#endif
+
+
+	/// <summary>
+	///          Permutation check of instances above 64 cities, one bit per city in the calling thread's bitset.
+	/// </summary>
+	static bool isPermutationWide(const gene_t* genome, const std::size_t ui_cities)
+	{
+		thread_local std::vector<std::uint64_t> ui_v_seen;
+
+		ui_v_seen.assign((ui_cities + 63) / 64, 0);
+
+		for (std::size_t j = 0; j < ui_cities; j++)
+		{
+			const std::size_t ui_city = genome[j];
+
+			if (ui_city >= ui_cities || (ui_v_seen[ui_city / 64] >> (ui_city % 64) & 1))
+			{
+				return false;
+			} // end if
+
+			ui_v_seen[ui_city / 64] |= std::uint64_t(1) << (ui_city % 64);
+		} // end for j
+
+		return true;
+	} // end method isPermutationWide
+
+#pragma endregion
+
+
+#pragma region Implementations:
+
+	/// <summary>
+	///          Checks that <paramref name="genome"/> visits each of the <paramref name="ui_cities"/> cities exactly once.
+	///          Up to 64 cities the genes are OR-ed into a single 64-bit mask, with AVX2 where the CPU has it; n genes
+	///          cover all n bits of the full mask only if none repeats and none is out of range.
+	/// </summary>
+	/// <returns>
+	///          true if the genome is a permutation
+	/// </returns>
+	bool isPermutation(const gene_t* genome, const std::size_t ui_cities)
+	{
+		if (ui_cities > 64)
+		{
+			return isPermutationWide(genome, ui_cities);
+		} // end if
+
+		const std::uint64_t ui_full = (ui_cities == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << ui_cities) - 1);
+
+		#if VALIDATE_X86
+			static const bool b_avx2 = (resolveKernelIsa(KernelIsa::automatic) == KernelIsa::avx2);
+
+			if (b_avx2)
+			{
+				return cityMaskAvx2(genome, ui_cities) == ui_full;
+			} // end if
+		#endif
+
+		return cityMaskScalar(genome, 0, ui_cities) == ui_full;
+	} // end method isPermutation
+
+
+	/// <summary>
+	///          Turns <paramref name="genome"/> into a permutation: the first visit of every city stays where it is, repeated
+	///          and out-of-range genes are replaced by the missing cities in ascending order.
+	/// </summary>
+	void repairGenome(gene_t* genome, const std::size_t ui_cities)
+	{
+		thread_local std::vector<char> b_v_seen;
+		thread_local std::vector<gene_t> g_v_missing;
+
+		b_v_seen.assign(ui_cities, 0);
+		g_v_missing.clear();
+
+		for (std::size_t j = 0; j < ui_cities; j++)
+		{
+			if (genome[j] < ui_cities)
+			{
+				b_v_seen[genome[j]] = 1;
+			} // end if
+		} // end for j
+
+		for (std::size_t c = ui_cities; c-- > 0;)
+		{
+			if (!b_v_seen[c])
+			{
+				g_v_missing.push_back(static_cast<gene_t>(c));
+			} // end if
+		} // end for c
+
+		b_v_seen.assign(ui_cities, 0);
+
+		for (std::size_t j = 0; j < ui_cities; j++)
+		{
+			if (genome[j] >= ui_cities || b_v_seen[genome[j]])
+			{
+				genome[j] = g_v_missing.back();
+				g_v_missing.pop_back();
+			} // end if
+
+			b_v_seen[genome[j]] = 1;
+		} // end for j
+	} // end method repairGenome
+
+
+	/// <summary>
+	///          Validation stage: checks a share of <paramref name="population"/> and handles invalid genomes as
+	///          <paramref name="e_mode"/> says. The checked slots are a window that moves on by its own length every
+	///          generation, so a sampled check still reaches every slot and draws no random numbers.
+	/// </summary>
+	/// <param name="d_sample">
+	///          Share of the population checked, 1 for all of it.
+	/// </param>
+	/// <param name="i_generation">
+	///          The current generation, places the window and goes into the error message.
+	/// </param>
+	/// <param name="report">
+	///          Tally to add this generation's checks to.
+	/// </param>
+	/// <exception cref="std::runtime_error">Thrown in abort mode if a checked genome is not a permutation.</exception>
+	void validate(Population& population, const ValidationMode e_mode, const double d_sample, const int i_generation, ValidationReport& report)
+	{
+		const std::size_t ui_size = population.size();
+		const std::size_t ui_cities = population.cities();
+
+		if (e_mode == ValidationMode::off || ui_size == 0)
+		{
+			return;
+		} // end if
+
+		const std::size_t ui_count = std::min(ui_size, std::max<std::size_t>(1, static_cast<std::size_t>(std::ceil(ui_size * d_sample))));
+		const std::size_t ui_first = static_cast<std::size_t>(i_generation) * ui_count % ui_size;
+		std::size_t ui_badSlot = std::numeric_limits<std::size_t>::max();
+		long long i_invalid = 0;
+
+		#pragma omp parallel for schedule(static) reduction(+:i_invalid) reduction(min:ui_badSlot)
+		for (std::size_t k = 0; k < ui_count; k++)
+		{
+			const std::size_t ui_slot = (ui_first + k < ui_size ? ui_first + k : ui_first + k - ui_size);
+
+			if (!isPermutation(population.genome(ui_slot), ui_cities))
+			{
+				i_invalid++;
+				ui_badSlot = std::min(ui_badSlot, ui_slot);
+
+				if (e_mode == ValidationMode::repair)
+				{
+					repairGenome(population.genome(ui_slot), ui_cities);
+					population.invalidate(ui_slot);
+				} // end if
+			} // end if
+		} // end for k
+
+		report.i_checked += static_cast<long long>(ui_count);
+		report.i_invalid += i_invalid;
+		report.i_repaired += (e_mode == ValidationMode::repair ? i_invalid : 0);
+
+		if (e_mode == ValidationMode::abort && i_invalid > 0)
+		{
+			throw std::runtime_error("Generation " + std::to_string(i_generation) + ": tour " + formatTour(population.genome(ui_badSlot), ui_cities)
+									 + " in slot " + std::to_string(ui_badSlot) + " is not a permutation of the " + std::to_string(ui_cities) + " cities!");
+		} // end if
+	} // end method validate
+
+
+	/// <summary>
+	///          Name of <paramref name="e_mode"/> as accepted by <see cref="parseValidationMode"/>.
+	/// </summary>
+	const char* validationModeName(const ValidationMode e_mode) noexcept
+	{
+		switch (e_mode)
+		{
+			case ValidationMode::off:    return "off";
+			case ValidationMode::count:  return "count";
+			case ValidationMode::abort:  return "abort";
+			case ValidationMode::repair: return "repair";
+		} // end switch
+
+		return "unknown";
+	} // end method validationModeName
+
+
+	/// <summary>
+	///          Parses a validation mode name.
+	/// </summary>
+	/// <param name="name">
+	///          off, count, abort or repair.
+	/// </param>
+	/// <param name="e_mode">
+	///          Output parameter for the parsed mode.
+	/// </param>
+	/// <returns>
+	///          true if <paramref name="name"/> is a known mode
+	/// </returns>
+	bool parseValidationMode(const char* name, ValidationMode& e_mode) noexcept
+	{
+		const ValidationMode e_a_all[] = { ValidationMode::off, ValidationMode::count, ValidationMode::abort, ValidationMode::repair };
+
+		for (const ValidationMode e_candidate : e_a_all)
+		{
+			if (strcmp(name, validationModeName(e_candidate)) == 0)
+			{
+				e_mode = e_candidate;
+				return true;
+			} // end if
+		} // end for
+
+		return false;
+	} // end method parseValidationMode
+
+#pragma endregion
@@ -0,0 +1,50 @@
+#ifndef _VALIDATE_H_
+#define _VALIDATE_H_
+
+#pragma region Includes:
+
+	#include <cstddef>      // std::size_t
+	#include "Population.h" // Population, gene_t
+
+#pragma endregion
+
+
+#pragma region Defines:
+
+	#ifndef ENABLE_VALIDATION
+		#define ENABLE_VALIDATION    1     // 0 compiles the validation stage out of the GA
+	#endif
+
+#pragma endregion
+
+
+// What the validation stage does about a genome that is not a permutation of the instance's cities.
+enum class ValidationMode
+{
+	off,    // no checks
+	count,  // count invalid tours, evolve them as they are
+	abort,  // stop the run at the first invalid tour
+	repair  // replace repeated cities by the missing ones and score the tour again
+}; // end enum ValidationMode
+
+
+// Tally of the validation stage over a run.
+struct ValidationReport
+{
+	long long i_checked  = 0; // genomes checked
+	long long i_invalid  = 0; // genomes that were not permutations
+	long long i_repaired = 0; // invalid genomes repaired in place
+}; // end struct ValidationReport
+
+
+#pragma region Prototypes:
+
+	bool isPermutation(const gene_t* genome, const std::size_t ui_cities);
+	void repairGenome(gene_t* genome, const std::size_t ui_cities);
+	void validate(Population& population, const ValidationMode e_mode, const double d_sample, const int i_generation, ValidationReport& report);
+	const char* validationModeName(const ValidationMode e_mode) noexcept;
+	bool parseValidationMode(const char* name, ValidationMode& e_mode) noexcept;
+
+#pragma endregion
+
+#endif
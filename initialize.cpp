@@ -1,7 +1,13 @@
 #include <iostream>  // cout
 #include <fstream>   // ofstream
 #include <string.h>  // strncmp
-#include <stdlib.h>  // rand
+#include <stdlib.h>  // rand, strtoull
+#include <stdio.h>   // fopen, fwrite
+#include <vector>    // vector
+#include <stdexcept> // length_error
+#include <omp.h>     // omp_set_num_threads
+#include "Generator.h"      // generatePopulation
+#include "PopulationFile.h" // PopulationFileWriter
 
 #define CHROMOSOMES    50000 // 50000
 #define CITIES         36    // Cities = ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789
@@ -12,22 +18,50 @@ using namespace std;
 char getCity( );
 void initialize( char trip[][CITIES + 1], int coordinates[CITIES][2], 
 		 int nChromosomes );
+int generate( int nChromosomes, int nCities, unsigned long long seed,
+	      const char* binary );
 
 int main( int argc, char* argv[] ) {
   // default values
   int nChromosomes = CHROMOSOMES;
+  int nCities = CITIES;
+  unsigned long long seed = 1;
+  bool fast = false;          // parallel generator instead of the loops below
+  const char* binary = NULL;  // binary population file, text files if NULL
+  bool valid = true;
 
   // argument verification
-  if ( argc == 2 ) {
-    nChromosomes = atoi( argv[1] );
+  for ( int i = 1; i < argc && valid; i++ ) {
+    if ( i == 1 && argv[i][0] != '-' )
+      nChromosomes = atoi( argv[i] );
+    else if ( strcmp( argv[i], "--fast" ) == 0 )
+      fast = true;
+    else if ( strncmp( argv[i], "--binary=", 9 ) == 0 ) {
+      fast = true;
+      binary = argv[i] + 9;
+    }
+    else if ( strncmp( argv[i], "--seed=", 7 ) == 0 )
+      seed = strtoull( argv[i] + 7, NULL, 10 );
+    else if ( strncmp( argv[i], "--threads=", 10 ) == 0 )
+      omp_set_num_threads( atoi( argv[i] + 10 ) );
+    else if ( strncmp( argv[i], "--cities=", 9 ) == 0 )
+      nCities = atoi( argv[i] + 9 );
+    else
+      valid = false;
   }
-  else {
-    cout << "usage: initialize nChromosomes" << endl;
+  if ( argc == 1 || !valid || nChromosomes < 1 || nCities < 1 
+       || ( nCities != CITIES && !fast ) ) {
+    cout << "usage: initialize nChromosomes [--fast] [--binary=file.bin] "
+	 << "[--seed=N] [--threads=N] [--cities=N]" << endl;
     if ( argc != 1 )
       exit( -1 );
   }
   cout << "# chromosomes = " << nChromosomes 
-       << ", # cities = " << CITIES << endl;
+       << ", # cities = " << nCities << endl;
+
+  // the parallel generator streams its output, no need for the arrays below
+  if ( fast )
+    return generate( nChromosomes, nCities, seed, binary );
 
   // declare chromosomes and cities
   char trip[nChromosomes][CITIES + 1];
@@ -169,3 +203,88 @@ void initialize( char trip[][CITIES + 1], int coordinates[CITIES][2],
   }
 }
 
+
+/*
+ * Generates nChromosomes distinct tours with a Fisher-Yates shuffle per
+ * tour on all threads, and streams them to chromosome.txt/cities.txt or
+ * to a binary population file. Scales linearly, 10M tours take seconds.
+ *
+ * @param nChromosomes: # of chromosomes
+ * @param nCities:      # of cities, at most 36 for the text files
+ * @param seed:         seed of the generator, same seed same population
+ * @param binary:       binary population file to write, text files if NULL
+ */
+int generate( int nChromosomes, int nCities, unsigned long long seed,
+	      const char* binary ) {
+  vector<Point> coordinates( nCities );
+  size_t duplicates = 0;
+  timePoint start = highRes_Clock::now( );
+
+  generateCoordinates( coordinates.data( ), nCities, seed );
+
+  try {
+    if ( binary != NULL ) {
+      PopulationFileWriter writer( binary, coordinates.data( ), nCities );
+
+      duplicates = 
+	generatePopulation( nChromosomes, nCities, seed,
+			    [&writer]( const gene_t* genomes, size_t count,
+				       size_t stride ) {
+			      writer.append( genomes, count, stride );
+			    } );
+      writer.close( );
+    }
+    else {
+      if ( nCities > CITIES )
+	throw length_error( "text files name at most 36 cities" );
+
+      FILE* chromosome_file = fopen( "chromosome.txt", "w" );
+      ofstream cities_file( "cities.txt" );
+      vector<char> lines;
+
+      if ( chromosome_file == NULL || !cities_file.is_open( ) )
+	throw runtime_error( "cannot create chromosome.txt or cities.txt" );
+
+      // one line of city names per tour, converted in parallel
+      duplicates = 
+	generatePopulation( nChromosomes, nCities, seed,
+			    [&]( const gene_t* genomes, size_t count,
+				 size_t stride ) {
+			      const long long n = count;
+			      lines.resize( count * ( nCities + 1 ) );
+			      char* text = lines.data( );
+#pragma omp parallel for schedule(static)
+			      for ( long long i = 0; i < n; i++ ) {
+				char* line = text + i * ( nCities + 1 );
+				for ( int j = 0; j < nCities; j++ ) {
+				  int city = genomes[i * stride + j];
+				  line[j] = ( city < 26 ) ? city + 'A' : city - 26 + '0';
+				}
+				line[nCities] = '\n';
+			      }
+			      fwrite( text, 1, lines.size( ), chromosome_file );
+			    } );
+      fclose( chromosome_file );
+
+      for ( int i = 0; i < nCities; i++ ) {
+	char city_name = ( i < 26 ) ? i + 'A' : i - 26 + '0';
+	cities_file << city_name 
+		    << "\t" << coordinates[i].x << "\t" << coordinates[i].y 
+		    << endl;
+      }
+      cities_file.close( );
+    }
+  }
+  catch ( const exception& e ) {
+    cout << "generation failed: " << e.what( ) << endl;
+    return -1;
+  }
+
+  timePoint end = highRes_Clock::now( );
+  cout << nChromosomes << " initialized, " << duplicates 
+       << " duplicates replaced, "
+       << chrono::duration_cast<chrono::microseconds>( end - start ).count( )
+       << " us" << endl;
+
+  return 0;
+}
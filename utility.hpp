@@ -7,6 +7,12 @@
     #include <random>        // random device, mersenne twister, uniform distributions
     #include <unordered_map> // hash map
 	#include <chrono>		 // timer
+	#include <cstdlib>		 // posix_memalign, free
+	#include <new>			 // std::bad_alloc
+	#if defined(_WIN32) || defined(_WIN64)
+		#include <malloc.h>	 // _aligned_malloc, _aligned_free
+	#endif
+	#include "Random.hpp"	 // localEngine, randomInRange, PROFILE_COUNT
 
 #pragma endregion
 
@@ -36,6 +42,9 @@ typedef std::chrono::high_resolution_clock				highRes_Clock;
 	#ifndef TOURNAMENT_SIZE
 		#define TOURNAMENT_SIZE    20     // number of participants in a tournament
 	#endif
+	#ifndef CACHE_LINE_SIZE
+		#define CACHE_LINE_SIZE    64     // bytes per cache line, alignment of hot tables
+	#endif
 
 #pragma endregion
 
@@ -132,17 +141,86 @@ typedef std::chrono::high_resolution_clock				highRes_Clock;
     /// <returns>
     ///          A pseudo-random value in the given range.
     /// </returns>
+    /// <remarks>
+    ///          Draws from the calling thread's own engine (see Random.hpp), so it is safe to call from OpenMP loops.
+    /// </remarks>
     /// <exception cref=""></exception>
     template<typename T>
     inline T randomIntInRange(T t_MIN, T t_MAX)
     {
-        static std::random_device rd{};
-        static std::mt19937 engine{rd()};
-        std::uniform_int_distribution<T> dist{t_MIN, t_MAX};
-
-        return dist(engine);
+        return randomInRange<T>(t_MIN, t_MAX);
     } // end template randomIntInRange
 
+
+    /// <summary>
+    ///          Rounds <paramref name="ui_value"/> up to the next multiple of <paramref name="ui_multiple"/>.
+    /// </summary>
+    /// <param name="ui_value">
+    ///                    The value to round up.
+    /// </param>
+    /// <param name="ui_multiple">
+    ///                    The multiple to round to, must be non-zero.
+    /// </param>
+    /// <returns>
+    ///          The smallest multiple of <paramref name="ui_multiple"/> that is not less than <paramref name="ui_value"/>.
+    /// </returns>
+    inline std::size_t roundUp(const std::size_t ui_value, const std::size_t ui_multiple) noexcept
+    {
+        return ((ui_value + ui_multiple - 1) / ui_multiple) * ui_multiple;
+    } // end method roundUp
+
+
+    /// <summary>
+    ///          Allocates <paramref name="ui_bytes"/> bytes aligned to <see cref="CACHE_LINE_SIZE"/>.
+    ///          Memory obtained from this function must be released with <see cref="alignedFree"/>.
+    /// </summary>
+    /// <param name="ui_bytes">
+    ///                    Number of bytes to allocate.
+    /// </param>
+    /// <returns>
+    ///          Pointer to the cache-line aligned block.
+    /// </returns>
+    /// <exception cref="std::bad_alloc">Thrown if the allocation fails.</exception>
+    inline void* alignedAlloc(const std::size_t ui_bytes)
+    {
+        void* p_block = nullptr;
+        const std::size_t ui_size = roundUp(ui_bytes > 0 ? ui_bytes : 1, CACHE_LINE_SIZE);
+
+        #if defined(_WIN32) || defined(_WIN64)
+            p_block = _aligned_malloc(ui_size, CACHE_LINE_SIZE);
+        #else
+            if (posix_memalign(&p_block, CACHE_LINE_SIZE, ui_size))
+            {
+                p_block = nullptr;
+            } // end if
+        #endif
+
+        if (p_block == nullptr)
+        {
+            throw std::bad_alloc();
+        } // end if
+
+        PROFILE_COUNT(Counter::allocations, 1);
+
+        return p_block;
+    } // end method alignedAlloc
+
+
+    /// <summary>
+    ///          Releases a block obtained from <see cref="alignedAlloc"/>.
+    /// </summary>
+    /// <param name="p_block">
+    ///                    The block to release, may be null.
+    /// </param>
+    inline void alignedFree(void* p_block) noexcept
+    {
+        #if defined(_WIN32) || defined(_WIN64)
+            _aligned_free(p_block);
+        #else
+            free(p_block);
+        #endif
+    } // end method alignedFree
+
 #pragma endregion
 
 #endif